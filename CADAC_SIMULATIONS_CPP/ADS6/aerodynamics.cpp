@@ -192,8 +192,19 @@ void Missile::aerodynamics()
 	//effective find deflection for drag calculation
 	deffx=(fabs(delx1)+fabs(delx2)+fabs(delx3)+fabs(delx4))/4;
 
+	//looking up all coefficients of the mach, beta, alpha tables at once
+	static const char *tables_mach_beta_alpha[]={
+		"ca0_vs_mach,betax,alphax","cy0_vs_mach,betax,alphax",
+		"cydr_vs_mach,betax,alphax","cn0_vs_mach,betax,alphax",
+		"cndq_vs_mach,betax,alphax","cll0_vs_mach,betax,alphax",
+		"clldp_vs_mach,betax,alphax","clm0_vs_mach,betax,alphax",
+		"clmdq_vs_mach,betax,alphax","cln0_vs_mach,betax,alphax",
+		"clndr_vs_mach,betax,alphax"};
+	double coef[11];
+	aerotable.look_up(tables_mach_beta_alpha,11,mach,betax,alphax,coef);
+
 	//looking up axial force coefficients
-	ca0=aerotable.look_up("ca0_vs_mach,betax,alphax",mach,betax,alphax);
+	ca0=coef[0];
 	cad=aerotable.look_up("cad_vs_mach",mach); //(1/deg)
 	//axial force coefficient
 	ca=ca0+cad*deffx;
@@ -204,35 +215,35 @@ void Missile::aerodynamics()
 		ca+=cab;
 	}
 	//looking up side force coefficents
-    cy0=aerotable.look_up("cy0_vs_mach,betax,alphax",mach,betax,alphax);
-	cydr=aerotable.look_up("cydr_vs_mach,betax,alphax",mach,betax,alphax); //(1/deg)
+    cy0=coef[1];
+	cydr=coef[2]; //(1/deg)
 	//side force coefficient
 	cy=cy0+cydr*drx;
 
 	//looking up normal force coefficients
-	cn0=aerotable.look_up("cn0_vs_mach,betax,alphax",mach,betax,alphax);
-	cndq=aerotable.look_up("cndq_vs_mach,betax,alphax",mach,betax,alphax); //(1/deg)
+	cn0=coef[3];
+	cndq=coef[4]; //(1/deg)
 	//normal force coefficient
 	cn=cn0+cndq*dqx;
 
 	//looking up rolling moment coefficients
-	cll0=aerotable.look_up("cll0_vs_mach,betax,alphax",mach,betax,alphax);
+	cll0=coef[5];
 	cllp=aerotable.look_up("cllp_vs_mach",mach); //(1/rad)
-	clldp=aerotable.look_up("clldp_vs_mach,betax,alphax",mach,betax,alphax); //(1/deg)
+	clldp=coef[6]; //(1/deg)
 	//rolling moment coefficient
 	cll=cll0+cllp*ppx*RAD*refl/(2*dvbe)+clldp*dpx;
 
 	//looking up pitching moment coefficients
-	clm0=aerotable.look_up("clm0_vs_mach,betax,alphax",mach,betax,alphax);
+	clm0=coef[7];
 	clmq=aerotable.look_up("clmq_vs_mach",mach); //(1/rad)
-	clmdq=aerotable.look_up("clmdq_vs_mach,betax,alphax",mach,betax,alphax); //(1/deg)
+	clmdq=coef[8]; //(1/deg)
 	//pitching moment coefficient
 	clm=clm0+clmq*qqx*RAD*refl/(2*dvbe)+clmdq*dqx-cn/refl*(xcgref-xcg);
 
 	//looking up yawing moment coefficients
-	cln0=aerotable.look_up("cln0_vs_mach,betax,alphax",mach,betax,alphax);
+	cln0=coef[9];
 	clnr=aerotable.look_up("clnr_vs_mach",mach); //(1/rad)
-	clndr=aerotable.look_up("clndr_vs_mach,betax,alphax",mach,betax,alphax); //(1/deg)
+	clndr=coef[10]; //(1/deg)
 	//yawing moment coefficient
 	cln=cln0+clnr*rrx*RAD*refl/(2*dvbe)+clndr*drx-cy/refl*(xcgref-xcg);
 
@@ -352,6 +352,7 @@ Packet Aircraft::loading_packet_init(int num_missile,int num_aircraft,int num_ro
 //uses C-code 'sprintf' function to convert 'int' to 'char'
 //
 //010207 Created by Peter H Zipfel
+//261017 Values refreshed only, metadata loaded by 'loading_packet_init()'
 ///////////////////////////////////////////////////////////////////////////////
 Packet Aircraft::loading_packet(int num_missile,int num_aircraft,int num_rocket,int num_radar)
 {
@@ -371,12 +372,12 @@ Packet Aircraft::loading_packet(int num_missile,int num_aircraft,int num_rocket,
 	for(i=0;i<flat3_com_count;i++)
 	{
 		index=flat3_com_ind[i];
-		com_aircraft3[i]=flat3[index];
+		com_aircraft3[i].copy_value(flat3[index]);
 	}
 	for(int j=0;j<aircraft_com_count;j++)
 	{
 		index=aircraft_com_ind[j];
-		com_aircraft3[i+j]=aircraft[index];
+		com_aircraft3[i+j].copy_value(aircraft[index]);
 	}
 	//refreshing the packet
 	packet.set_data(com_aircraft3);
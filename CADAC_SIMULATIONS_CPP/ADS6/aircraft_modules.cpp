@@ -89,23 +89,16 @@ void Aircraft::guidance(Packet *combus,int num_vehicles, int vehicle_slot,double
 		//escape maneuver from missile
 		if(acft_option==2){
 			//downloading from 'combus' missile states
-			int i(0);
-			char number[4];	
 			Matrix STEL(3,1);
 			Matrix VTEL(3,1);
-			//building missile id = t(j+1); first missile is used
-			sprintf(number,"%i",1);
-			string rocket_id="m"+string(number);
-			//finding slot 'i' of missile in 'combus' (same as in vehicle_list)
-			for(i=0;i<num_vehicles;i++){
-				string id=combus[i].get_id();
-				if (id==rocket_id){
-					//downloading data from missile packet
-					tgt_com_slot=i;
-					data_t=combus[i].get_data();
-					STEL=data_t[3].vec();
-					VTEL=data_t[4].vec();
-				}
+			//slot 'i' of the first missile 'm1' in 'combus' (same as in vehicle_list)
+			int i=packet_slot('m',1);
+			if(i>=0){
+				//downloading data from missile packet
+				tgt_com_slot=i;
+				data_t=combus[i].get_data();
+				STEL=data_t[3].vec();
+				VTEL=data_t[4].vec();
 			}
 			//distance to missile
 			Matrix SATL(3,1);
@@ -407,6 +407,187 @@ Radar::~Radar()
 	delete [] com_radar0;
 }
 ///////////////////////////////////////////////////////////////////////////////
+//////////////////// Checkpoint state of the vehicle objects //////////////////
+///////////////////////////////////////////////////////////////////////////////
+//Writing a module-variable array to the checkpoint, preceded by its size
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Cadac::save_array(ostream &fsave,Variable *array,int size)
+{
+	fsave.write((char *)&size,sizeof(size));
+	for(int i=0;i<size;i++) array[i].save(fsave);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Reading a module-variable array from the checkpoint
+//The size must agree with the array set up from 'input.asc'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Cadac::load_array(istream &fload,Variable *array,int size)
+{
+	int saved(0);
+	fload.read((char *)&saved,sizeof(saved));
+	if(saved!=size)
+		{cerr<<"*** Error: checkpoint does not match 'input.asc' *** \n";system("pause");exit(1);}
+	for(int i=0;i<size;i++) array[i].load(fload);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Writing and reading the noise streams and the event and step counters
+//'random_source' is set by the executive before each draw
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Cadac::save_cadac(ostream &fsave)
+{
+	fsave.write((char *)random,sizeof(random));
+	fsave.write((char *)&random_seeded,sizeof(random_seeded));
+	fsave.write((char *)&event_epoch,sizeof(event_epoch));
+	fsave.write((char *)&event_time,sizeof(event_time));
+	fsave.write((char *)&event_lag,sizeof(event_lag));
+	fsave.write((char *)&nstep,sizeof(nstep));
+}
+void Cadac::load_cadac(istream &fload)
+{
+	fload.read((char *)random,sizeof(random));
+	fload.read((char *)&random_seeded,sizeof(random_seeded));
+	fload.read((char *)&event_epoch,sizeof(event_epoch));
+	fload.read((char *)&event_time,sizeof(event_time));
+	fload.read((char *)&event_lag,sizeof(event_lag));
+	fload.read((char *)&nstep,sizeof(nstep));
+}
+///////////////////////////////////////////////////////////////////////////////
+//Writing the state of the 'Missile' object to the checkpoint
+//Module-variable arrays, events and saved Markov values
+//Tables, output plans and 'combus' packets are set up from 'input.asc'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Missile::save_state(ostream &fsave)
+{
+	save_cadac(fsave);
+	save_array(fsave,flat6,NFLAT6);
+	save_array(fsave,missile,NMISSILE);
+
+	fsave.write((char *)&nevent,sizeof(nevent));
+	fsave.write((char *)&event_total,sizeof(event_total));
+	for(int i=0;i<event_total;i++) event_ptr_list[i]->save(fsave);
+
+	fsave.write((char *)&nmarkov,sizeof(nmarkov));
+	for(int i=0;i<nmarkov;i++)
+	{
+		double saved=markov_list[i].get_markov_saved();
+		fsave.write((char *)&saved,sizeof(saved));
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Reading the state of the 'Missile' object from the checkpoint
+//The object is set up from 'input.asc' as for a new run
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Missile::load_state(istream &fload)
+{
+	int num(0);
+
+	load_cadac(fload);
+	load_array(fload,flat6,NFLAT6);
+	load_array(fload,missile,NMISSILE);
+
+	//after the last event 'event_total' is zero
+	fload.read((char *)&nevent,sizeof(nevent));
+	fload.read((char *)&num,sizeof(num));
+	if(num&&num!=event_total)
+		{cerr<<"*** Error: checkpoint does not match 'input.asc' *** \n";system("pause");exit(1);}
+	event_total=num;
+	for(int i=0;i<event_total;i++) event_ptr_list[i]->load(fload);
+
+	fload.read((char *)&num,sizeof(num));
+	if(num!=nmarkov)
+		{cerr<<"*** Error: checkpoint does not match 'input.asc' *** \n";system("pause");exit(1);}
+	for(int i=0;i<nmarkov;i++)
+	{
+		double saved(0);
+		fload.read((char *)&saved,sizeof(saved));
+		markov_list[i].set_markov_saved(saved);
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Writing the state of the 'Rocket' object to the checkpoint
+//Module-variable arrays and the state held by 'Cadac'
+//Tables, output plans and 'combus' packets are set up from 'input.asc'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Rocket::save_state(ostream &fsave)
+{
+	save_cadac(fsave);
+	save_array(fsave,flat3,NFLAT3);
+	save_array(fsave,rocket,NROCKET);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Reading the state of the 'Rocket' object from the checkpoint
+//The object is set up from 'input.asc' as for a new run
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Rocket::load_state(istream &fload)
+{
+	load_cadac(fload);
+	load_array(fload,flat3,NFLAT3);
+	load_array(fload,rocket,NROCKET);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Writing the state of the 'Aircraft' object to the checkpoint
+//Module-variable arrays and the state held by 'Cadac'
+//Tables, output plans and 'combus' packets are set up from 'input.asc'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Aircraft::save_state(ostream &fsave)
+{
+	save_cadac(fsave);
+	save_array(fsave,flat3,NFLAT3);
+	save_array(fsave,aircraft,NAIRCRAFT);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Reading the state of the 'Aircraft' object from the checkpoint
+//The object is set up from 'input.asc' as for a new run
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Aircraft::load_state(istream &fload)
+{
+	load_cadac(fload);
+	load_array(fload,flat3,NFLAT3);
+	load_array(fload,aircraft,NAIRCRAFT);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Writing the state of the 'Radar' object to the checkpoint
+//Module-variable arrays and the state held by 'Cadac'
+//Tables, output plans and 'combus' packets are set up from 'input.asc'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Radar::save_state(ostream &fsave)
+{
+	save_cadac(fsave);
+	save_array(fsave,flat0,NFLAT0);
+	save_array(fsave,radar,NRADAR);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Reading the state of the 'Radar' object from the checkpoint
+//The object is set up from 'input.asc' as for a new run
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Radar::load_state(istream &fload)
+{
+	load_cadac(fload);
+	load_array(fload,flat0,NFLAT0);
+	load_array(fload,radar,NRADAR);
+}
+///////////////////////////////////////////////////////////////////////////////
 //////////////////// Members of class 'Vehicle' ///////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 //Constructor of class 'Vehicle'
@@ -12,6 +12,8 @@
 //150217 Compatible with MS VC++ 2013, PZi
 //170809 Output in 'csv' format added, PZi
 //170909 Added 'Radar', PZi
+//261017 Monte Carlo runs executed by worker processes
+//261017 Vehicles stepped concurrently on a two-phase 'combus' frame
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "class_hierarchy.hpp"
@@ -25,7 +27,7 @@ using namespace std;
 
 //acquiring the simmulation title
 void acquire_title_options(fstream &input,char *title,char *options,int &nmonte,
-						   int &iseed,int &nmc);
+						   int &iseed,int &nmc,int &nworker);
 
 //acquiring the simulation run time
 double acquire_endtime(fstream &input);
@@ -37,7 +39,8 @@ void number_modules(fstream &input,int &num);
 void order_modules(fstream &input,int &num,Module *module_list);
 
 //acquiring the number of vehicle objects
-void number_objects(fstream &input,int &num_vehicles,int &num_missile,int &num_rocket,int &num_aircraft,int &num_radar);
+void number_objects(fstream &input,int &num_vehicles,int &num_missile,int &num_rocket,int &num_aircraft,int &num_radar,
+					int &nthread);
 
 //creating a type of vehicle object
 Cadac *set_obj_type(fstream &input,Module *module_list,int num_modules,
@@ -49,20 +52,68 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			 double int_step,double scrn_step,double com_step,double traj_step,char *options,
 			 ofstream &ftabout,ofstream *plot_ostream_list,Packet *combus,int *status,
 			 int num_missile,int num_rocket,int num_aircraft,int num_radar,ofstream &ftraj,char *title,bool traj_merge,
-			 int nmonte,int nmc,ofstream *stat_ostream_list,bool *stati_write_term,double *launch_delay_list);
+			 int nmonte,int nmc,ofstream *stat_ostream_list,bool *stati_write_term,double *launch_delay_list,
+			 int nthread,Checkpoint &checkpoint);
+
+//executing the modules of a vehicle
+void execute_modules(Cadac *vehicle,Module *module_list,int num_modules,double sim_time,double &int_step,
+					 double &out_fact,Packet *combus,int num_vehicles,int vehicle_slot,char *title);
+
+//time step of a vehicle on the two-phase frame of 'combus', executed by 'Vehicle_pool'
+struct Frame_step:public Vehicle_step
+{
+	Vehicle *vehicle_list;
+	Module *module_list;
+	int num_modules;
+	int num_vehicles;
+	double sim_time;
+	double *int_step;  //integration step of each vehicle
+	double *out_fact;  //output step factor of each vehicle
+	char *options;
+	char *title;
+	Packet *combus;    //'combus' of the previous step, read-only but for 'set_status()'
+	int *status;       //status of the vehicles at the previous step
+	int num_missile;
+	int num_rocket;
+	int num_aircraft;
+	int num_radar;
+	int nmonte;
+	double *launch_delay_list;
+	Combus_frame *frame;
+
+	void step(int i);
+};
 
 // saving status of 'combus' vehicle objects
 void combus_status(Packet *combus,int *status,int num_vehicles);
 
+//executive state of a run, written to the checkpoint with the vehicle objects
+struct Run_state
+{
+	double sim_time;
+	double int_step;
+	double out_fact;
+	double scrn_time;
+	double plot_time;
+	double traj_time;
+	double com_time;
+	int nevents;		//events of all vehicle objects
+	double lnch_delay[3];	//launch delays of m1, m2, m3 downloaded from the radar packet
+};
+
+//writing the scenario to the checkpoint file
+void save_checkpoint(Checkpoint &checkpoint,Run_state &run,int nmc,Vehicle &vehicle_list,int num_vehicles,
+					 Packet *combus,int *status,bool *stati_write_term,
+					 double *launch_delay_list);
+
+//resuming the scenario from the checkpoint file
+void load_checkpoint(Checkpoint &checkpoint,Run_state &run,int nmc,Vehicle &vehicle_list,int num_vehicles,
+					 Packet *combus,int *status,bool *stati_write_term,
+					 double *launch_delay_list);
+
 //getting timimg cycles for plotting, screen output and integration
 void acquire_timing(fstream &input,double &plot_step,double &scn_step,double &com_step,
-					double &traj_step,double &int_step);
-
-//merging the 'ploti.asc' files onto 'plot.asc' 
-void merge_plot_files(string *plot_file_list,int num_missile,char *title);
-
-//merging the 'stati.asc' files onto 'stat.asc' 
-void merge_stat_files(string *stat_file_list,int num_missile,char *title);
+					double &traj_step,double &int_step,Checkpoint &checkpoint);
 
 //writing 'combus' data on screen
 void comscrn_data(Packet *combus,int num_vehicles,double sim_time);
@@ -107,6 +158,7 @@ int main()
 	int num_rocket=0; //number of rocket objects
 	int num_aircraft=0; //number of aircraft objects
 	int num_radar=0; //number of radar objects
+	int nthread=0; //number of threads stepping the vehicles, see 'Vehicle_pool'
 	Cadac *vehicle_type=NULL; //array of vehicle object pointers
 	char vehicle_name[CHARN]; //name of each vehicle type
 	double end_time=0; //run termination time from 'input.asc'
@@ -120,7 +172,13 @@ int main()
 	int nmonte=0; //number of MC runs to be executed
 	int nmc=0; //MC counter
 	int iseed=0; //seeding srand()
+	int nworker=0; //number of worker processes executing the MC runs
+	Monte_carlo mc; //executes the MC runs in worker processes
+	Checkpoint checkpoint; //snapshot of the scenario, 'save_time', 'save_event' and option 'y_restart'
 	bool one_traj_banner=true; //write just one banner on file 'traj.asc'
+	Output_writer writer; //binary output of the plot, stat and traj files, option 'y_binary'
+	Result_store plot_store; //plot data of all objects and runs on 'plot.asc', option 'y_merge'
+	Result_store stat_store; //stat data of all objects and runs on 'stat.asc', option 'y_merge'
 	bool *stati_write_term=NULL; //flag for writing impact data on 'stati.asc' once
 	Document *doc_missile6=NULL;  //array for documenting MISSILE6 module-variables of 'input.asc'
 	Document *doc_rocket5=NULL;  //array for documenting ROCKET5 module-variables of 'input.asc'
@@ -158,6 +216,9 @@ int main()
 	ofstream fcopy("CADAC_SIMULATIONS/ADS6/input_copy.asc");
 	if(!fcopy){cout<<" *** Error: cannot open 'input_copy.asc' file *** \n";exit(1);}
 
+	//file of the snapshot of the scenario
+	checkpoint.file="CADAC_SIMULATIONS/ADS6/checkpoint.bin";
+
 	///////////////////////////////////////////////////////////////////////////
 	////////////////////////// Monte Carlo Loop ///////////////////////////////
 	///////////////////////////////////////////////////////////////////////////
@@ -171,8 +232,21 @@ int main()
 		bool document_radar=true; //write  to 'doc.asc' radar module-variables only once
 		bool traj_merge=false; //flag used in writing 'time=-1' endblock on 'traj.asc'
 		
+		//seeding the run and collecting its output, if executed by a worker
+		mc.begin_run(nmc);
+
 		//aqcuiring title statement and option selections
-		acquire_title_options(input,title,options,nmonte,iseed,nmc);
+		acquire_title_options(input,title,options,nmonte,iseed,nmc,nworker);
+
+		//binary output of the 'traj' file, 'y_binary' on the OPTIONS line
+		if(!nmc&&strstr(options,"y_binary")&&strstr(options,"y_traj"))
+		{
+			ftraj.close();
+			remove("CADAC_SIMULATIONS/ADS6/traj.asc");
+			ftraj.open("CADAC_SIMULATIONS/ADS6/traj.bin",ios::binary);
+			if(!ftraj){cout<<" *** Error: cannot open 'traj.bin' file *** \n";exit(1);}
+			writer.attach(ftraj);
+		}
 
 		//initializing random number generator
 		if(!nmc) srand(iseed); 
@@ -192,10 +266,10 @@ int main()
 		order_modules(input,num_modules,module_list);
 		
 		//acquiring the time stepping
-		acquire_timing(input,plot_step,scrn_step,int_step,com_step,traj_step);
+		acquire_timing(input,plot_step,scrn_step,int_step,com_step,traj_step,checkpoint);
 
 		//acquiring number of vehicle objects from 'input.asc'
-		number_objects(input,num_vehicles,num_missile,num_rocket,num_aircraft,num_radar);
+		number_objects(input,num_vehicles,num_missile,num_rocket,num_aircraft,num_radar,nthread);
 
 		//creating the 'vehicle_list' object
 		// at this point the constructor 'Vehicle' is called and memory is allocated
@@ -244,6 +318,31 @@ int main()
 		//initialize 'stati_write_term' to true
 		for(int ii=0;ii<num_vehicles;ii++) stati_write_term[ii]=true;
 
+		//collecting the rows of all objects and runs on 'plot.asc' and 'stat.asc', option 'y_merge'
+		if(!nmc&&strstr(options,"y_merge")&&!strstr(options,"y_binary"))
+		{
+			if(strstr(options,"y_plot"))
+			{
+				plot_store.open("CADAC_SIMULATIONS/ADS6/plot.asc","CADAC_SIMULATIONS/ADS6/plot.idx");
+				plot_store.attach(plot_ostream_list,num_vehicles);
+				mc.add_stream(plot_store.get_file());
+				mc.add_stream(plot_store.get_index());
+			}
+			if(strstr(options,"y_stat"))
+			{
+				stat_store.open("stat.asc","stat.idx");
+				stat_store.attach(stat_ostream_list,num_vehicles);
+				mc.add_stream(stat_store.get_file());
+				mc.add_stream(stat_store.get_index());
+			}
+		}
+
+		//starting the workers with the first run, if 'MONTE' gives their number
+		if(!nmc) mc.start(nmonte,nworker,iseed,ftabout,ftraj,plot_ostream_list,stat_ostream_list,num_vehicles);
+
+		//binary chunks written in the background, unless the runs are forked to workers
+		if(!nmc&&strstr(options,"y_binary")&&!mc.get_forking()) writer.start();
+
 		///////////////////////////////////////////////////////////////////////
 		////////////////// Initializing each vehicle object  ///////////////
 		///////////////////////////////////////////////////////////////////////
@@ -265,20 +364,29 @@ int main()
 			//getting the name of the type of vehicle
 			strcpy(vehicle_name,vehicle_list[i]->get_vname());
 
+			//seeding the noise streams of the vehicle, if the runs are seeded by run number
+			// or the vehicles are stepped by threads
+			if(mc.get_seeded()||nthread) vehicle_list[i]->seed_random(iseed,nmc,i);
+
 			//vehicle data and tables read from 'input.asc' 
+			vehicle_list[i]->set_random_source(RANDOM_INPUT);
 			vehicle_list[i]->vehicle_data(input,nmonte);
 
 			//executing initialization computations -MOD		
 			for (int j=0;j<num_modules;j++)
 			{
-				if((module_list[j].name=="kinematics")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_kinematics(sim_time,int_step,launch_delay);
-				else if((module_list[j].name=="aerodynamics")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_aerodynamics();
-				else if((module_list[j].name=="ins")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_ins();
-				else if((module_list[j].name=="newton")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_newton();
+				vehicle_list[i]->set_random_source(module_list[j].id);
+				if(module_list[j].init)
+					switch(module_list[j].id){
+					case MOD_KINEMATICS:
+						vehicle_list[i]->init_kinematics(sim_time,int_step,launch_delay);break;
+					case MOD_AERODYNAMICS:
+						vehicle_list[i]->init_aerodynamics();break;
+					case MOD_INS:
+						vehicle_list[i]->init_ins();break;
+					case MOD_NEWTON:
+						vehicle_list[i]->init_newton();break;
+					}
 			}
 			//populating the launch delay list
 			launch_delay_list[i]=launch_delay;
@@ -321,15 +429,24 @@ int main()
 
 						//building names for plot files
 						sprintf(index,"%i",i+1);
-						plotiasc="CADAC_SIMULATIONS/ADS6/plot"+string(index)+".asc"; //using Standard Library string constructor
+						plotiasc="CADAC_SIMULATIONS/ADS6/plot"+string(index)+(strstr(options,"y_binary")?".bin":".asc"); //using Standard Library string constructor
 						plot_file_list[i]=plotiasc;
 						name=plotiasc.c_str(); //using string member function to convert to char array 
 
 						//creating output stream list 'plot_ostream_list[i]', each will write on file 'ploti.asc'
-						plot_ostream_list[i].open(name); //'name' must be 'char' type
+						if(strstr(options,"y_binary"))
+						{
+							plot_ostream_list[i].open(name,ios::binary);
+							writer.attach(plot_ostream_list[i]);
+						}
+						else if(!plot_store.get_open())
+							plot_ostream_list[i].open(name); //'name' must be 'char' type
 
 						//writing banner on 'ploti.asc'
-						vehicle_list[i]->plot_banner(plot_ostream_list[i],title);				}
+						vehicle_list[i]->plot_banner(plot_ostream_list[i],title);
+
+						//with option 'y_merge', the banner of the first object heads 'plot.asc'
+						plot_store.write_banner(plot_ostream_list[i],title);				}
 				}
 
 				//creating output stream objects in 'stat_ostream_list[i]' for every file "stati.asc"
@@ -344,15 +461,24 @@ int main()
 
 						//building names for stat files
 						sprintf(index,"%i",i+1);
-						statiasc="stat"+string(index)+".asc"; //using Standard Library string constructor
+						statiasc="stat"+string(index)+(strstr(options,"y_binary")?".bin":".asc"); //using Standard Library string constructor
 						stat_file_list[i]=statiasc;
 						name=statiasc.c_str(); //using string member function to convert to char array 
 
 						//creating output stream list 'stat_ostream_list[i]', each will write on file 'stati.asc'
-						stat_ostream_list[i].open(name); //'name' must be 'char' type
+						if(strstr(options,"y_binary"))
+						{
+							stat_ostream_list[i].open(name,ios::binary);
+							writer.attach(stat_ostream_list[i]);
+						}
+						else if(!stat_store.get_open())
+							stat_ostream_list[i].open(name); //'name' must be 'char' type
 
 						//writing banner on 'stati.asc'
-						vehicle_list[i]->plot_banner(stat_ostream_list[i],title);				}
+						vehicle_list[i]->plot_banner(stat_ostream_list[i],title);
+
+						//with option 'y_merge', the banner of the first object heads 'stat.asc'
+						stat_store.write_banner(stat_ostream_list[i],title);				}
 				}
 
 				//composing documentation of 'flat6','missile','flat3','rocket', 'aircraft', 'flat0' and 'radar' module-variables
@@ -403,6 +529,9 @@ int main()
 
 		} //end of initialization of vehicle object loop
 
+		//resolving the 'combus' slots of the packet ids for the modules reading other packets
+		resolve_packet_slots(combus,num_vehicles);
+
 		//writing 'combus' data to screen at time=0, after module initialization			
 		if(strstr(options,"y_comscrn"))
 		{
@@ -435,11 +564,31 @@ int main()
 		/////////////////////// Simulation Execution //////////////////////////
 		///////////////////////////////////////////////////////////////////////	
 
-		execute(vehicle_list,module_list,sim_time,
-				 end_time,num_vehicles,num_modules,plot_step,
-				 int_step,scrn_step,com_step,traj_step,options,ftabout,
-				 plot_ostream_list,combus,status,num_missile,num_rocket,num_aircraft,num_radar,ftraj,title,
-				 traj_merge,nmonte,nmc,stat_ostream_list,stati_write_term,launch_delay_list);
+		//writing the pending binary rows, so a worker does not inherit them
+		writer.sync();
+
+		//the main process hands the run to a worker and initializes the next run
+		if(!mc.fork_run(nmc))
+		{
+			//seed of the run, for runs resuming from the checkpoint
+			checkpoint.iseed=iseed;
+			checkpoint.seeded=mc.get_seeded()||nthread;
+
+			execute(vehicle_list,module_list,sim_time,
+					 end_time,num_vehicles,num_modules,plot_step,
+					 int_step,scrn_step,com_step,traj_step,options,ftabout,
+					 plot_ostream_list,combus,status,num_missile,num_rocket,num_aircraft,num_radar,ftraj,title,
+					 traj_merge,nmonte,nmc,stat_ostream_list,stati_write_term,launch_delay_list,nthread,
+					 checkpoint);
+
+			//appending the rows of the run to 'plot.asc' and 'stat.asc', option 'y_merge'
+			plot_store.end_run(nmc);
+			stat_store.end_run(nmc);
+
+			//a worker hands its output to the main process and exits
+			writer.sync();
+			mc.end_run();
+		}
 
 		//deallocating dynamic memory
 		delete [] module_list;
@@ -453,6 +602,9 @@ int main()
 	}	// at this point the destructor of the object 'Vehicle:: vehicle_list' is called 
 	while(nmc<nmonte); 
 
+	//appending the output of the remaining runs in run order
+	mc.finish();
+
 	///////////////////////////////////////////////////////////////////////////	
 	///////////////////////// End of Monte Carlo Loop /////////////////////////
 	///////////////////////////////////////////////////////////////////////////	
@@ -464,6 +616,13 @@ int main()
 	fcopy.close();
 	int f(0);
 
+	//writing the pending binary rows of the plot, stat and traj files
+	writer.sync();
+
+	//closing 'plot.asc' and 'stat.asc', restoring the streams of the objects
+	plot_store.close();
+	stat_store.close();
+
 	//Close file streams
 	ftabout.close();
 	for(f=0;f<num_vehicles;f++) plot_ostream_list[f].close();
@@ -471,25 +630,17 @@ int main()
 	for(f=0;f<num_vehicles;f++) stat_ostream_list[f].close();
 	ftraj.close();
 
-	//merging 'ploti.asc' files into 'plot.asc'
-	if(strstr(options,"y_merge")&&strstr(options,"y_plot"))
-	{
-		merge_plot_files(plot_file_list,num_missile,title);
-	}
-	//merging 'stati.asc' files into 'stat.asc'm using 'merge_plot_data' function
-	//adding at the end: time=-1 and dummy block of data
-	if(strstr(options,"y_merge")&&strstr(options,"y_stat"))
-	{
-		merge_stat_files(stat_file_list,num_missile,title);
-	}
 	//creating a comma separated value (.csv) file if 'y_csv' and either 'y_plot' or 'y_traj'
-	if(strstr(options,"y_csv"))
+	if(strstr(options,"y_csv")&&!strstr(options,"y_binary"))
 	{
 		if(strstr(options,"y_plot"))
 		{
 			if(strstr(options,"y_merge"))
 			{
-				parse_plot_traj_csv(plot_file_list,num_missile,1,"plot");
+				string* plots=new string[1];
+				plots[0]="CADAC_SIMULATIONS/ADS6/plot.asc";
+				parse_plot_traj_csv(plots,1,1,"plot");  //all objects are on 'plot.asc'
+				delete [] plots;
 			}
 			else{
 				parse_plot_traj_csv(plot_file_list,num_missile,0,"plot");
@@ -557,20 +708,28 @@ int main()
 //				*stat_ostream_list = output file-steam list of 'stati.asc' for each individual missile 
 //								missile object
 //				*stati_write_term = flag for writing impact data on 'stati.asc' once
+//				&checkpoint = snapshot of the scenario, see 'Checkpoint'
 //				*launch_delay_list = launch delay list
+//				nthread = number of threads stepping the vehicles on the two-phase frame
+//								of 'combus' (see 'Combus_frame'); =0 vehicles step in sequence
+//								and read 'combus' as it is loaded
 //				  				
 //011128 Created by Peter H Zipfel
 //040705 Calculating 'event_time', PZi
 //070531 Incrementing 'sim_time' in 'combus' until 'ENDTIME' is reached, PZi
 //081010 Modified for GENSIM6, PZi
 //170918 Modified for ADS6, PZi
+//261017 Module dispatch on 'Module_id' instead of name comparisons
+//261017 Vehicles stepped concurrently on a two-phase 'combus' frame, if 'nthread' is given
+//261017 Snapshot of the scenario and restart from it, see 'Checkpoint'
 ///////////////////////////////////////////////////////////////////////////////
 void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			 double end_time,int num_vehicles,int num_modules,double plot_step,
 			 double int_step,double scrn_step,double com_step,double traj_step,char *options,
 			 ofstream &ftabout,ofstream *plot_ostream_list,Packet *combus,int *status,
 			 int num_missile,int num_rocket,int num_aircraft,int num_radar,ofstream &ftraj,char *title,bool traj_merge,
-			 int nmonte,int nmc,ofstream *stat_ostream_list,bool *stati_write_term,double *launch_delay_list)
+			 int nmonte,int nmc,ofstream *stat_ostream_list,bool *stati_write_term,double *launch_delay_list,
+			 int nthread,Checkpoint &checkpoint)
 {
 	double scrn_time(0);
 	double plot_time(0);
@@ -582,17 +741,115 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 	bool plot_merge(false);
 	double out_fact(0);
 	Variable *data_t;
-	string radar_id="f1";
 	double lnch_delay_m1(0);
 	double lnch_delay_m2(0);
 	double lnch_delay_m3(0);
 	string missile_id1="m1";
 	string missile_id2="m2";
 	string missile_id3="m3";
+	Run_state run; //executive state written to and read from the checkpoint
+	int nevents(0); //events of all vehicle objects, see 'Checkpoint'
+
+	//snapshot taken once by the first run, unless the runs resume from one
+	bool restart=strstr(options,"y_restart")!=NULL;
+	bool snapshot=!restart&&!nmc&&(checkpoint.save_time>0||checkpoint.save_event>0);
+
+	//resuming the scenario from the checkpoint, option 'y_restart'
+	if(restart)
+	{
+		load_checkpoint(checkpoint,run,nmc,vehicle_list,num_vehicles,combus,status,stati_write_term,launch_delay_list);
+		sim_time=run.sim_time;
+		int_step=run.int_step;
+		out_fact=run.out_fact;
+		scrn_time=run.scrn_time;
+		plot_time=run.plot_time;
+		traj_time=run.traj_time;
+		com_time=run.com_time;
+		nevents=run.nevents;
+		lnch_delay_m1=run.lnch_delay[0];
+		lnch_delay_m2=run.lnch_delay[1];
+		lnch_delay_m3=run.lnch_delay[2];
+	}
+
+	//two-phase frame of 'combus' and the threads stepping the vehicles on it
+	Combus_frame frame;
+	Vehicle_pool *pool=NULL;
+	vector<double> int_steps(num_vehicles);
+	vector<double> out_facts(num_vehicles);
+	Frame_step frame_step;
+	if(nthread)
+	{
+		frame.init(combus,num_vehicles);
+		pool=new Vehicle_pool(nthread,num_vehicles);
+
+		frame_step.vehicle_list=&vehicle_list;
+		frame_step.module_list=module_list;
+		frame_step.num_modules=num_modules;
+		frame_step.num_vehicles=num_vehicles;
+		frame_step.int_step=&int_steps[0];
+		frame_step.out_fact=&out_facts[0];
+		frame_step.options=options;
+		frame_step.title=title;
+		frame_step.combus=combus;
+		frame_step.status=status;
+		frame_step.num_missile=num_missile;
+		frame_step.num_rocket=num_rocket;
+		frame_step.num_aircraft=num_aircraft;
+		frame_step.num_radar=num_radar;
+		frame_step.nmonte=nmonte;
+		frame_step.launch_delay_list=launch_delay_list;
+		frame_step.frame=&frame;
+	}
 
 	//integration loop
 	while (sim_time<=(end_time+int_step))
 	{
+		//taking the snapshot at 'save_time' or after 'save_event' events of the scenario
+		if(snapshot&&((checkpoint.save_time>0&&sim_time>checkpoint.save_time-EPS)
+			||(checkpoint.save_event>0&&nevents>=checkpoint.save_event)))
+		{
+			snapshot=false;
+			run.sim_time=sim_time;
+			run.int_step=int_step;
+			run.out_fact=out_fact;
+			run.scrn_time=scrn_time;
+			run.plot_time=plot_time;
+			run.traj_time=traj_time;
+			run.com_time=com_time;
+			run.nevents=nevents;
+			run.lnch_delay[0]=lnch_delay_m1;
+			run.lnch_delay[1]=lnch_delay_m2;
+			run.lnch_delay[2]=lnch_delay_m3;
+			save_checkpoint(checkpoint,run,nmc,vehicle_list,num_vehicles,combus,status,stati_write_term,launch_delay_list);
+		}
+
+		if(pool)
+		{
+			//stepping all vehicles on 'combus' of the previous step
+			for(int i=0;i<num_vehicles;i++)
+			{
+				int_steps[i]=int_step;
+				out_facts[i]=out_fact;
+			}
+			frame_step.sim_time=sim_time;
+			pool->run(frame_step);
+
+			//collecting the status changes and swapping the published packets into 'combus'
+			combus_status(combus,status,num_vehicles);
+			frame.swap(combus,status);
+
+			//integration step and output factor changed by 'kinematics()', last vehicle prevails
+			double int_step_new=int_step;
+			double out_fact_new=out_fact;
+			for(int i=0;i<num_vehicles;i++)
+			{
+				if(int_steps[i]!=int_step) int_step_new=int_steps[i];
+				if(out_facts[i]!=out_fact) out_fact_new=out_facts[i];
+			}
+			int_step=int_step_new;
+			out_fact=out_fact_new;
+		}
+
 		//vehicle loop
 		for (int i=0;i<num_vehicles;i++)
 		{
@@ -601,73 +858,52 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			else			
 			{
 				//vehicle is progressing
+				if(pool)
+					//writing the screen messages of the vehicle's step
+					pool->flush(i);
+				else
+				{
+					//slot occupied by current vehicle in 'vehicle_list[]'
+					vehicle_slot=i;
 
-				//slot occupied by current vehicle in 'vehicle_list[]'
-				vehicle_slot=i;
+					//watching for the next event			
+					vehicle_list[i]->event(options);
 
-				//watching for the next event			
-				vehicle_list[i]->event(options);
+					//fixing 'event_epoch' and initializing 'event_time' at the (located) event
+					//the event's new values took effect at the end of this step, not at the crossing
+					if(vehicle_list[i]->event_epoch)
+						vehicle_list[i]->event_time=vehicle_list[i]->event_lag*int_step;
 
-				//fixing 'event_epoch' and initializing 'event_time'
-				if(vehicle_list[i]->event_epoch)
-					vehicle_list[i]->event_time=0;
+					//continue only if vehicle is alive (health=1:alive; =-1:hit('rocket' only); =0:dead)
+					int health=combus[i].get_status();
+					if(health==1)
+					{
+						//refreshing Markov variables
+						vehicle_list[i]->set_random_source(RANDOM_MARKOV);
+						vehicle_list[i]->markov_noise(sim_time,int_step,nmonte);
 
-				//continue only if vehicle is alive (health=1:alive; =-1:hit('rocket' only); =0:dead)
-				int health=combus[i].get_status();
-				if(health==1)
-				{
-					//refreshing Markov variables
-					vehicle_list[i]->markov_noise(sim_time,int_step,nmonte);
+						//module loop -MOD
+						execute_modules(vehicle_list[i],module_list,num_modules,sim_time,int_step,out_fact,
+										combus,num_vehicles,vehicle_slot,title);
 
-					//module loop -MOD
-					for(int j=0;j<num_modules;j++)
-					{
-						if(module_list[j].name=="environment")
-							vehicle_list[i]->environment();
-						else if(module_list[j].name=="kinematics")
-							vehicle_list[i]->kinematics(sim_time,vehicle_list[i]->event_time,int_step,out_fact,combus,num_vehicles,vehicle_slot);
-						else if(module_list[j].name=="newton")
-							vehicle_list[i]->newton(int_step);
-						else if(module_list[j].name=="euler")
-							vehicle_list[i]->euler(int_step);
-						else if(module_list[j].name=="aerodynamics")
-							vehicle_list[i]->aerodynamics();
-						else if(module_list[j].name=="propulsion")
-							vehicle_list[i]->propulsion();
-						else if(module_list[j].name=="forces")
-							vehicle_list[i]->forces();
-						else if(module_list[j].name=="actuator")
-							vehicle_list[i]->actuator(int_step);
-						else if(module_list[j].name=="tvc")
-							vehicle_list[i]->tvc(int_step);
-						else if(module_list[j].name=="rcs")
-							vehicle_list[i]->rcs(int_step);
-						else if(module_list[j].name=="control") 
-							vehicle_list[i]->control(int_step);
-						else if(module_list[j].name=="guidance")
-							vehicle_list[i]->guidance(combus,num_vehicles,vehicle_slot,int_step);
-						else if(module_list[j].name=="ins")
-							vehicle_list[i]->ins(int_step);
-						else if(module_list[j].name=="sensor")
-							vehicle_list[i]->sensor(combus,num_vehicles,vehicle_slot,sim_time,int_step);
-						else if(module_list[j].name=="intercept")
-							vehicle_list[i]->intercept(combus,vehicle_slot,int_step,title);
-					} //end of module loop
-
-					//preserving 'health' status of vehicle objects
-					combus_status(combus,status,num_vehicles);
-
-					//loading data packet into 'combus' communication bus
-					combus[i]=vehicle_list[i]->loading_packet(num_missile,num_aircraft,num_rocket,num_radar);
-
-					//refreshing 'health' status of vehicle objects
-					combus[i].set_status(status[i]);
-
-				} //end of active vehicle loop
+						//preserving 'health' status of vehicle objects
+						combus_status(combus,status,num_vehicles);
+
+						//loading data packet into 'combus' communication bus
+						combus[i]=vehicle_list[i]->loading_packet(num_missile,num_aircraft,num_rocket,num_radar);
+
+						//refreshing 'health' status of vehicle objects
+						combus[i].set_status(status[i]);
+
+					} //end of active vehicle loop
+				}
 
 				//continuing incrementing 'sim_time' in combus packets until 'ENDTIME' is reached
 				combus[i].set_data_variable(0,sim_time);
 
+				//counting the events of the scenario, see 'Checkpoint'
+				if(vehicle_list[i]->event_epoch) nevents++;
+
 				//tracking time elapsed during event
 				vehicle_list[i]->event_time+=int_step;
 
@@ -713,8 +949,7 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			// and store in 'launch_delay_list[i]' for m1, m2, m3
 			// (requires that MISSILE6 objects precede RADAR0 object in 'input.asc'
 			//   and assums the pairing of missiles and rocket targets m1->r1, m2->r2, m3->r3)  
-			string id=combus[i].get_id();
-			if (id==radar_id)
+			if (i==packet_slot('f',1))
 			{						
 				//downloading launch delays for missiles m1, m2, m3
 				data_t=combus[i].get_data();
@@ -770,6 +1005,180 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 		traj_merge=true;
 		traj_data(ftraj,combus,num_vehicles,traj_merge,sim_time);
 	}
+	delete pool;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Executing the modules of a vehicle in the sequence of 'module_list'
+//
+//Parameters:	*vehicle = vehicle object
+//				&int_step = integration step, set by 'kinematics()' at events
+//				&out_fact = output step factor, set by 'kinematics()' at events
+//				vehicle_slot = slot of the vehicle in 'vehicle_list' and 'combus'
+//				others as in 'execute()'
+//
+//261017 Created from 'execute()'
+//261017 Modules executed 'every n' integration steps
+///////////////////////////////////////////////////////////////////////////////
+void execute_modules(Cadac *vehicle,Module *module_list,int num_modules,double sim_time,double &int_step,
+					 double &out_fact,Packet *combus,int num_vehicles,int vehicle_slot,char *title)
+{
+	//modules executed 'every n' steps are skipped in between, holding their outputs,
+	// and step over 'n*int_step'
+	for(int j=0;j<num_modules;j++)
+	{
+		if(vehicle->nstep%module_list[j].divisor) continue;
+		double module_step=int_step*module_list[j].divisor;
+
+		vehicle->set_random_source(module_list[j].id);
+		switch(module_list[j].id){
+		case MOD_ENVIRONMENT:
+			vehicle->environment();break;
+		case MOD_KINEMATICS:
+			vehicle->kinematics(sim_time,vehicle->event_time,int_step,out_fact,combus,num_vehicles,vehicle_slot);break;
+		case MOD_NEWTON:
+			vehicle->newton(module_step);break;
+		case MOD_EULER:
+			vehicle->euler(module_step);break;
+		case MOD_AERODYNAMICS:
+			vehicle->aerodynamics();break;
+		case MOD_PROPULSION:
+			vehicle->propulsion();break;
+		case MOD_FORCES:
+			vehicle->forces();break;
+		case MOD_ACTUATOR:
+			vehicle->actuator(module_step);break;
+		case MOD_TVC:
+			vehicle->tvc(module_step);break;
+		case MOD_RCS:
+			vehicle->rcs(module_step);break;
+		case MOD_CONTROL:
+			vehicle->control(module_step);break;
+		case MOD_GUIDANCE:
+			vehicle->guidance(combus,num_vehicles,vehicle_slot,module_step);break;
+		case MOD_INS:
+			vehicle->ins(module_step);break;
+		case MOD_SENSOR:
+			vehicle->sensor(combus,num_vehicles,vehicle_slot,sim_time,module_step);break;
+		case MOD_INTERCEPT:
+			vehicle->intercept(combus,vehicle_slot,module_step,title);break;
+		}
+	}
+	//counting the integration steps of the vehicle
+	vehicle->nstep++;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Time step of a vehicle on the two-phase frame of 'combus', see 'Combus_frame'
+//The vehicle reads 'combus' and 'status' of the previous step and publishes
+// its packet into the back buffer; 'int_step' and 'out_fact' are its own copies
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Frame_step::step(int i)
+{
+	//vehicle is holding at initial point
+	if(sim_time<launch_delay_list[i]) return;
+
+	Cadac *vehicle=(*vehicle_list)[i];
+
+	//watching for the next event			
+	vehicle->event(options);
+
+	//fixing 'event_epoch' and initializing 'event_time' at the (located) event
+	//the event's new values took effect at the end of this step, not at the crossing
+	if(vehicle->event_epoch)
+		vehicle->event_time=vehicle->event_lag*int_step[i];
+
+	//continue only if vehicle is alive
+	if(status[i]!=1) return;
+
+	//refreshing Markov variables
+	vehicle->set_random_source(RANDOM_MARKOV);
+	vehicle->markov_noise(sim_time,int_step[i],nmonte);
+
+	//module loop -MOD
+	execute_modules(vehicle,module_list,num_modules,sim_time,int_step[i],out_fact[i],
+					combus,num_vehicles,i,title);
+
+	//publishing data packet for the next step
+	Packet packet=vehicle->loading_packet(num_missile,num_aircraft,num_rocket,num_radar);
+	frame->publish(i,packet);
 } 
+///////////////////////////////////////////////////////////////////////////////
+//Writing the scenario to the checkpoint file, see 'Checkpoint'
+//Number of vehicle objects, seed and run number of the run, executive state 'run',
+// then for each vehicle object: status, write-flag to 'stati.asc', launch delay, 'combus'
+// data and the state written by 'save_state()'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void save_checkpoint(Checkpoint &checkpoint,Run_state &run,int nmc,Vehicle &vehicle_list,int num_vehicles,
+					 Packet *combus,int *status,bool *stati_write_term,
+					 double *launch_delay_list)
+{
+	ofstream fsave(checkpoint.file,ios::binary);
+	if(!fsave){cerr<<" *** Error: cannot open '"<<checkpoint.file<<"' file *** \n";system("pause");exit(1);}
+
+	fsave.write((char *)&num_vehicles,sizeof(num_vehicles));
+	fsave.write((char *)&checkpoint.iseed,sizeof(checkpoint.iseed));
+	fsave.write((char *)&nmc,sizeof(nmc));
+	fsave.write((char *)&run,sizeof(run));
+	for(int i=0;i<num_vehicles;i++)
+	{
+		int health=combus[i].get_status();
+		fsave.write((char *)&health,sizeof(health));
+		fsave.write((char *)&status[i],sizeof(int));
+		fsave.write((char *)&stati_write_term[i],sizeof(bool));
+		fsave.write((char *)&launch_delay_list[i],sizeof(double));
+		Cadac::save_array(fsave,combus[i].get_data(),combus[i].get_ndata());
+		vehicle_list[i]->save_state(fsave);
+	}
+	if(!fsave){cerr<<" *** Error: cannot write '"<<checkpoint.file<<"' file *** \n";system("pause");exit(1);}
 
+	cout<<" *** Checkpoint at time = "<<run.sim_time<<" sec written to '"<<checkpoint.file<<"' *** \n";
+}
+///////////////////////////////////////////////////////////////////////////////
+//Resuming the scenario from the checkpoint file, option 'y_restart'
+//The vehicle objects and 'combus' are set up from 'input.asc' as for a new run,
+// the checkpoint then overwrites their state
+//Runs other than the saved one branch off: their seeded noise streams continue
+// with the key of the run, see 'Cadac::resume_random()'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void load_checkpoint(Checkpoint &checkpoint,Run_state &run,int nmc,Vehicle &vehicle_list,int num_vehicles,
+					 Packet *combus,int *status,bool *stati_write_term,
+					 double *launch_delay_list)
+{
+	int num(0);
+	int iseed(0);
+	int nmc_saved(0);
+
+	ifstream fload(checkpoint.file,ios::binary);
+	if(!fload){cerr<<" *** Error: cannot open '"<<checkpoint.file<<"' file *** \n";system("pause");exit(1);}
+
+	fload.read((char *)&num,sizeof(num));
+	fload.read((char *)&iseed,sizeof(iseed));
+	fload.read((char *)&nmc_saved,sizeof(nmc_saved));
+	if(num!=num_vehicles)
+		{cerr<<"*** Error: checkpoint does not match 'input.asc' *** \n";system("pause");exit(1);}
+	fload.read((char *)&run,sizeof(run));
+	for(int i=0;i<num_vehicles;i++)
+	{
+		int health(0);
+		fload.read((char *)&health,sizeof(health));
+		combus[i].set_status(health);
+		fload.read((char *)&status[i],sizeof(int));
+		fload.read((char *)&stati_write_term[i],sizeof(bool));
+		fload.read((char *)&launch_delay_list[i],sizeof(double));
+		Cadac::load_array(fload,combus[i].get_data(),combus[i].get_ndata());
+		vehicle_list[i]->load_state(fload);
+	}
+	if(!fload){cerr<<" *** Error: '"<<checkpoint.file<<"' file is incomplete *** \n";system("pause");exit(1);}
 
+	if(checkpoint.seeded)
+	{
+		bool branch=(iseed!=checkpoint.iseed)||(nmc!=nmc_saved);
+		for(int i=0;i<num_vehicles;i++)
+			vehicle_list[i]->resume_random(checkpoint.iseed,nmc,i,branch);
+	}
+}
@@ -15,11 +15,26 @@
 
 #include <fstream>
 #include <string>
+#include <vector>
+#include <map>
+#include <sstream>
+#include <deque>
+#include <cstdio>
 #include <cstring>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 #include "utility_header.hpp"
 
 using namespace std;
 
+//module identifiers of the simulation, 'MOD_NONE' for module names not called
+enum Module_id{MOD_NONE,MOD_ENVIRONMENT,MOD_KINEMATICS,MOD_NEWTON,MOD_EULER,MOD_AERODYNAMICS,MOD_PROPULSION,MOD_FORCES,MOD_ACTUATOR,MOD_TVC,MOD_RCS,MOD_CONTROL,MOD_GUIDANCE,MOD_INS,MOD_SENSOR,MOD_INTERCEPT};
+
+//noise sources of a vehicle: its modules by 'Module_id', its input data and its Markov variables
+enum Random_source{RANDOM_INPUT=MOD_INTERCEPT+1,RANDOM_MARKOV,NRANDOM};
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 //Structure 'Module'
@@ -27,6 +42,7 @@ using namespace std;
 //Provides the structure for the modules of the simulation
 //
 //010107 Created by Peter H Zipfel
+//261017 Added 'id', 'init' and 'term' resolved once for module dispatch
 ///////////////////////////////////////////////////////////////////////////////
 struct Module
 {
@@ -35,8 +51,52 @@ struct Module
 	string initialization;
 	string execution;
 	string termination;
+	int id;		//'Module_id' resolved from 'name' by 'order_modules()'
+	bool init;	//'initialization' is "init"
+	bool term;	//'termination' is "term"
+	int divisor;	//'exec' every 'divisor'-th integration step, 'every n' in 'input.asc'
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//Structure 'Checkpoint'
+//Snapshot of the whole scenario in a binary file: executive clocks, 'combus'
+// and the state of every vehicle object, see 'Cadac::save_state()'
+//Taken by the first run at 'save_time' or after 'save_event' events of the
+// scenario (TIMING). With option 'y_restart' every run resumes from it; runs
+// other than the saved one branch off with noise streams of their own
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+struct Checkpoint
+{
+	const char *file;	//snapshot file
+	double save_time;	//time of the snapshot, 0: not by time
+	int save_event;		//events of all vehicle objects before the snapshot, 0: not by event
+	int iseed;			//seed of the run
+	bool seeded;		//noise streams seeded by run number, see 'Cadac::seed_random()'
 };
 
+///////////////////////////////////////////////////////////////////////////////
+//Structure 'Variable_meta'
+//Name, type, definition, module, role and output of a module-variable
+//One record is shared by all variables of the same definition, i.e., by
+// the same slot of the module-variable arrays of all objects of a class
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+struct Variable_meta
+{
+	char name[CHARN]; //label of variable
+	char type[CHARN]; //type of variable 'int'; default is real
+	char def[CHARL];  //definition and units
+	char mod[CHARN];  //module where variable is calculated
+	char role[CHARN]; //role that variable plays: 'data','state','diag','out','save'
+	char out[CHARN];  //output for: 'scrn', 'plot', 'com'
+};
+
+//matrix value held by a 'Variable'
+enum Variable_kind{KIND_NONE,KIND_VEC,KIND_MAT,KIND_VEC5,KIND_MAT5};
+
 ///////////////////////////////////////////////////////////////////////////////
 //Class 'Variable'
 //Establishing module-variables as type Variable
@@ -45,36 +105,64 @@ struct Module
 //001125 Created by Peter H Zipfel
 //011129 Adapted to MISSILE6 simulation, PZi
 //071101 Added VEC5 and MAT5, PZi
+//261017 Metadata in shared 'Variable_meta' records, compact value storage
+//261017 Values zeroed, undefined slots read the same in every run
 ///////////////////////////////////////////////////////////////////////////////
 
 class Variable 
 {
 private:
-	char name[CHARN]; //label of variable
-	char type[CHARN]; //type of variable 'int'; default is real
+	Variable_meta *meta; //name, type, def, mod, role, out; shared, see 'Variable_meta'
 	double rval;	  //real value, double
 	int ival;         //integer value, int
-	Matrix VEC;		  //3x1 vector 
-	Matrix MAT;		  //3x3 matrix 
-	Matrix VEC5;	  //5x1 vector 
-	Matrix MAT5;	  //5x5 matrix 
-	char def[CHARL];  //definition and units
-	char mod[CHARN];  //module where variable is calculated
-	char role[CHARN]; //role that variable plays: 'data','state','diag','out','save'
-	char out[CHARN];  //output for: 'scrn', 'plot', 'com'
+	char kind;        //matrix held in 'body', see 'Variable_kind'
 	char error[2];	  //error code '*' = SAME LOCATION multiple, overwritten definitions
 					  //           'A' = SAME NAME assigned to multiple locations 
+	double body[9];   //3x1 vector, 3x3 matrix or 5x1 vector
+	double *body5;    //5x5 matrix, allocated when first stored
+
+	//copying the matrix value into a new 'Matrix', zero if 'kind' differs
+	Matrix matrix(char kind_wanted,int num_row,int num_col)
+	{
+		Matrix VALUE(num_row,num_col);
+		if(kind!=kind_wanted) return VALUE;
+		double *pbody=VALUE.get_pbody();
+		double *pvalue=(kind==KIND_MAT5)?body5:body;
+		for(int i=0;i<num_row*num_col;i++)
+			*(pbody+i)=*(pvalue+i);
+		return VALUE;
+	}
+	//storing 'VALUE' as the matrix value of type 'kind_new'
+	void store(char kind_new,int num_row,int num_col,Matrix &VALUE)
+	{
+		if((VALUE.get_rows()!=num_row)||(VALUE.get_cols()!=num_col))
+		{cerr<<" *** Error: incompatible dimensions 'Variable::store()' *** \n";exit(1);}
+
+		kind=kind_new;
+		if(kind==KIND_MAT5&&body5==NULL) body5=new double[25];
+		double *pvalue=(kind==KIND_MAT5)?body5:body;
+		double *pbody=VALUE.get_pbody();
+		for(int i=0;i<num_row*num_col;i++)
+			*(pvalue+i)=*(pbody+i);
+	}
 public:
 	Variable()
 	{
-		VEC.dimension(3,1);MAT.dimension(3,3);
-		VEC5.dimension(5,1);MAT5.dimension(5,5);		
-		strcpy(name,"empty");
+		meta=share("empty","","","","","");
+		rval=0;
+		ival=0;
+		kind=KIND_NONE;
+		body5=NULL;
 		error[0]=' ';error[1]='\0';
-		int dum=1;
 	}; 
-	~Variable(){};
+	Variable(const Variable &var){body5=NULL;*this=var;}
+	~Variable(){delete [] body5;};
+	Variable &operator=(const Variable &var);
+	void copy_value(const Variable &var);
+	void save(ostream &fsave);
+	void load(istream &fload);
 //////////////////////////// Protopypes ///////////////////////////////////////
+static Variable_meta *share(char *na,char *ty,char *de,char *mo,char *ro,char *ou);
 void init(char *na,double rv,char *de,char *mo,char *ro,char *ou);
 void init(char *na,char *ty,int iv,char *de,char *mo,char *ro,char *ou);
 void init(char *na,double v1,double v2,double v3,char *de,char *mo,char *ro,char *ou);
@@ -97,14 +185,14 @@ void init(char *na,
 	//
 	//001213 Created by Peter H Zipfel
 	///////////////////////////////////////////////////////////////////////////
-	char *get_name(){return name;}
+	char *get_name(){return meta->name;}
 	
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining 'type' from module-variable array 
 	//
 	//001213 Created by Peter H Zipfel
 	///////////////////////////////////////////////////////////////////////////
-	char *get_type(){return type;}
+	char *get_type(){return meta->type;}
 	
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining value (of type 'double') from module-variable array to local variable
@@ -128,7 +216,15 @@ void init(char *na,
 	//
 	//001128 Created by Peter H Zipfel
 	///////////////////////////////////////////////////////////////////////////
-	Matrix vec(){return VEC;}
+	Matrix vec(){return matrix(KIND_VEC,3,1);}
+	
+	///////////////////////////////////////////////////////////////////////////
+	//Obtaining the 3x1 vector components in place, NULL if no vector is stored
+	//Used by 'Output_plan' for writing vectors without a 'Matrix' copy
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	double *get_vec(){return (kind==KIND_VEC)?body:NULL;}
 	
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining matrix value (of type 'Matrix') from module-variable array to local variable
@@ -136,14 +232,14 @@ void init(char *na,
 	//
 	//001226 Created by Peter H Zipfel
 	///////////////////////////////////////////////////////////////////////////
-	Matrix mat(){return MAT;}
+	Matrix mat(){return matrix(KIND_MAT,3,3);}
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining 5x1 vector value (of type 'Matrix') from module-variable array to local variable
 	//Example: Matrix X=flat6[200].vec5();
 	//
 	//071101 Created by Peter H Zipfel
 	///////////////////////////////////////////////////////////////////////////
-	Matrix vec5(){return VEC5;}
+	Matrix vec5(){return matrix(KIND_VEC5,5,1);}
 	
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining 5x5 matrix value (of type 'Matrix') from module-variable array to local variable
@@ -151,7 +247,7 @@ void init(char *na,
 	//
 	//071101 Created by Peter H Zipfel
 	///////////////////////////////////////////////////////////////////////////
-	Matrix mat5(){return MAT5;}
+	Matrix mat5(){return matrix(KIND_MAT5,5,5);}
 	
 	///////////////////////////////////////////////////////////////////////////
 	//Loads module-variable onto module-variable array
@@ -174,25 +270,25 @@ void init(char *na,
 	} 
 	Matrix gets_vec(Matrix VE)
 	{
-		VEC=VE;
-		return VEC;
+		store(KIND_VEC,3,1,VE);
+		return VE;
 	} 
 
 	Matrix gets_mat(Matrix MA)
 	{
-		MAT=MA;
-		return MAT;
+		store(KIND_MAT,3,3,MA);
+		return MA;
 	} 
 	Matrix gets_vec5(Matrix VE5)
 	{
-		VEC5=VE5;
-		return VEC5;
+		store(KIND_VEC5,5,1,VE5);
+		return VE5;
 	} 
 
 	Matrix gets_mat5(Matrix MA5)
 	{
-		MAT5=MA5;
-		return MAT5;
+		store(KIND_MAT5,5,5,MA5);
+		return MA5;
 	} 
 
 	///////////////////////////////////////////////////////////////////////////
@@ -200,28 +296,28 @@ void init(char *na,
 	//
 	//001213 Created by Peter H Zipfel
 	///////////////////////////////////////////////////////////////////////////
-	char *get_def(){return def;}
+	char *get_def(){return meta->def;}
 	
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining 'mod' from module-variable array 
 	//
 	//001213 Created by Peter H Zipfel
 	///////////////////////////////////////////////////////////////////////////
-	char *get_mod(){return mod;}
+	char *get_mod(){return meta->mod;}
 	
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining 'role' from module-variable array 
 	//
 	//001213 Created by Peter H Zipfel
 	///////////////////////////////////////////////////////////////////////////
-	char *get_role(){return role;}
+	char *get_role(){return meta->role;}
 	
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining 'out' from module-variable array 
 	//
 	//001213 Created by Peter H Zipfel
 	///////////////////////////////////////////////////////////////////////////
-	char *get_out(){return out;}
+	char *get_out(){return meta->out;}
 
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining 'error' code from module-variable array 
@@ -246,6 +342,7 @@ void init(char *na,
 //
 //010119 Created by Peter H Zipfel
 //011129 Adapted to MISSILE6 simulation, PZi
+//261017 Pending events, compiled criteria, located crossings
 ///////////////////////////////////////////////////////////////////////////////
 class Event
 {
@@ -253,6 +350,13 @@ private:
 	Variable *watch_variable_ptr;	//pointer to variable to be watched
 	double watch_value;			//numerical value for comparison (integers will be converted later)
 	char event_operator;		// < , > , =  three options of relational operators	
+	bool pending;				//'WHEN' event: watched from the start, not in sequence
+	bool occurred;				//event has occurred
+	bool integer;				//watch variable is 'int', resolved by 'compile()'
+	int watch_value_int;		//'watch_value' of an integer watch variable
+	double sample;				//value of a real watch variable at the previous test
+	bool sampled;				//'sample' is set
+	bool held;					//criterion held at the previous test
 	int flat6_indices[NVAR];	//new variables to be read from 'flat6[]'
 	double flat6_values[NVAR];	//new values to be given to variables 
 	int flat6_size;				//size (number) of variables from flat6 array
@@ -260,7 +364,7 @@ private:
 	double missile_values[NVAR];	//new values to be given to variables
 	int missile_size;				//size (number) of variables from missile array
 public:
-	Event(){};
+	Event():pending(false),occurred(false),integer(false),watch_value_int(0),sample(0),sampled(false),held(false){};
 	~Event(){};
 
 	///////////////////////////////////////////////////////////////////////////
@@ -391,6 +495,69 @@ public:
 	//010123 Created by Peter H Zipfel
 	///////////////////////////////////////////////////////////////////////////
 	int get_missile_size(){return missile_size;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Setting a 'WHEN' event, watched from the start instead of in sequence
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void set_pending(bool when){pending=when;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Getting whether the event is a 'WHEN' event
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	bool get_pending(){return pending;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Marking the event as occurred
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void set_occurred(){occurred=true;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Getting whether the event has occurred
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	bool get_occurred(){return occurred;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Resolving the type of the watch variable, once the criterion is set
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void compile();
+
+	///////////////////////////////////////////////////////////////////////////
+	//Testing the criterion, optionally locating its crossing in the last step
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	bool test(bool locate,double &lag);
+
+	///////////////////////////////////////////////////////////////////////////
+	//Writing and reading the state of the event, see 'Checkpoint'
+	//The criterion and the new values are read from 'input.asc'
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void save(ostream &fsave)
+	{
+		fsave.write((char *)&occurred,sizeof(occurred));
+		fsave.write((char *)&sample,sizeof(sample));
+		fsave.write((char *)&sampled,sizeof(sampled));
+		fsave.write((char *)&held,sizeof(held));
+	}
+	void load(istream &fload)
+	{
+		fload.read((char *)&occurred,sizeof(occurred));
+		fload.read((char *)&sample,sizeof(sample));
+		fload.read((char *)&sampled,sizeof(sampled));
+		fload.read((char *)&held,sizeof(held));
+	}
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -476,6 +643,61 @@ public:
 	Variable *get_data(){return data;}
 };
 
+///////////////////////////////////////////////////////////////////////////////
+//Slots of the packets in 'combus' by their id, resolved once after the packets
+// are loaded, so that modules reading other packets do not match ids each step
+//'packet_slot(type,number)' returns the slot of the packet 'type''number', e.g.
+// packet_slot('m',2) the slot of "m2", or -1 if there is none
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void resolve_packet_slots(Packet *combus,int num_vehicles);
+int packet_slot(char type,int number);
+
+///////////////////////////////////////////////////////////////////////////////
+//Class 'Combus_frame'
+//Two-phase frame of the communication bus 'combus', 'VEHICLES num nthread'
+// in 'input.asc', see 'Vehicle_pool'
+//During a time step all vehicles read 'combus' as it was at the end of the
+// previous step and publish their new packets into the back buffer. At the
+// step boundary the published packets are swapped into 'combus'. Each packet
+// owns its data, so the result does not depend on the order of the vehicles.
+//'set_status()' calls of the modules on 'combus' are collected at the step
+// boundary by 'combus_status()'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+class Combus_frame
+{
+private:
+	int num_vehicles;
+	Packet *next;       //back buffer of 'combus'
+	Variable **storage; //two data arrays per vehicle, alternating between 'combus' and 'next'
+	bool *published;    //true if the vehicle published its packet in this step
+
+public:
+	Combus_frame():num_vehicles(0),next(NULL),storage(NULL),published(NULL){}
+	~Combus_frame();
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Taking over the packets of 'combus' after the module initialization
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	void init(Packet *combus,int num);
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Publishing the packet of vehicle 'i' into the back buffer
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	void publish(int i,Packet &packet);
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Swapping the published packets into 'combus', with the status of 'status[]'
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	void swap(Packet *combus,int *status);
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 //Class 'Markov'
@@ -705,6 +927,7 @@ public:
 //Stores table data
 //
 //030710 Created by Peter H Zipfel
+//261017 Arrays deleted with 'delete []'
 ///////////////////////////////////////////////////////////////////////////////
 class Table 
 {
@@ -723,10 +946,10 @@ public:
 	Table(){}
 	virtual ~Table()
 	{
-		delete var1_values;
-		delete var2_values;
-		delete var3_values;
-		delete data;
+		delete [] var1_values;
+		delete [] var2_values;
+		delete [] var3_values;
+		delete [] data;
 	}
 
 	///////////////////////////////////////////////////////////////////////////
@@ -819,10 +1042,66 @@ public:
 	}
 };
 ///////////////////////////////////////////////////////////////////////////////
+//Structure 'Lookup_site'
+//Table look-up site of a 'Datadeck', one per table slot
+//Holds the brackets found by the last look-up of the table as starting points
+// of the next search
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+struct Lookup_site
+{
+	int slot;         //table slot in 'Datadeck'
+	int loc1;         //last bracket of 1. independent variable
+	int loc2;         //last bracket of 2. independent variable
+	int loc3;         //last bracket of 3. independent variable
+};
+///////////////////////////////////////////////////////////////////////////////
+//Structure 'Lookup_group'
+//Tables of a 'Datadeck' that share their independent variables and breakpoints,
+// identified by the table name array of the call site
+//Table values are interleaved, the 'num' values of a grid point are adjacent,
+// so that one set of brackets and weights serves all tables
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+struct Lookup_group
+{
+	const char **names;   //table name array of the call site
+	int num;              //number of tables
+	int var1_dim;         //variable 1 dimension
+	int var2_dim;         //variable 2 dimension
+	int var3_dim;         //variable 3 dimension
+	double *var1_values;  //values of variable 1, those of the first table
+	double *var2_values;  //values of variable 2, those of the first table
+	double *var3_values;  //values of variable 3, those of the first table
+	vector<double> data;  //table values, grid point by grid point
+	int loc1;             //last bracket of 1. independent variable
+	int loc2;             //last bracket of 2. independent variable
+	int loc3;             //last bracket of 3. independent variable
+};
+///////////////////////////////////////////////////////////////////////////////
+//Structure 'Deck_file'
+//Tables loaded from one deck file, shared by all 'Datadeck' objects that read
+// the same file; the tables are read-only once loaded
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+struct Deck_file
+{
+	string title;      //title of data deck
+	int capacity;      //total number of tables
+	Table **table_ptr; //tables of the file
+	int users;         //number of 'Datadeck' objects using the tables
+};
+///////////////////////////////////////////////////////////////////////////////
 //Class 'Datadeck'
 //provides the 'Datadeck' class declaration for table look-ups
 //
 //030710 Created by Peter H Zipfel
+//261017 Look-ups of table name literals with cached slots and brackets
+//261017 Batched look-ups of tables sharing their breakpoints
+//261017 Tables shared by all data decks reading the same file
 ///////////////////////////////////////////////////////////////////////////////
 class Datadeck
 {
@@ -831,11 +1110,15 @@ private:
 	int capacity; //total number of tables
 	int tbl_counter; //table counter
 	Table **table_ptr; //table_ptr is pointer to a pointer array of type 'Table'
+	vector<Lookup_site> sites; //look-up sites of table name literals, by table slot
+	map<const char *,int> site_slots; //table slots of the name literals seen, by address
+	vector<Lookup_group> groups; //call sites of look-ups of table groups
+	string file; //deck file of shared tables, see 'Deck_file'
 
 public:
 
-	Datadeck(){}
-	virtual ~Datadeck(){ delete [] table_ptr;}
+	Datadeck():table_ptr(0){}
+	virtual ~Datadeck(){release();}
 
 	///////////////////////////////////////////////////////////////////////////////
 	//Allocating memory  table deck title 
@@ -909,6 +1192,18 @@ public:
 	///////////////////////////////////////////////////////////////////////////////
 	Table * get_tbl(int slot){return table_ptr[slot];}
 
+	///////////////////////////////////////////////////////////////////////////////
+	//Sharing the tables of a deck file, see 'Deck_file'
+	//'share()' takes over the tables if the file was loaded before, returns false otherwise
+	//'keep()' offers the tables just read from the file to later 'Datadeck' objects
+	//'release()' gives up the tables, the last user of a file deletes them
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	bool share(const char *file_name);
+	void keep(const char *file_name);
+	void release();
+
 	///////////////////////////////////////////////////////////////////////////////
 	//Single independent variable look-up
 	//constant extrapolation at the upper end, slope extrapolation at the lower end
@@ -933,6 +1228,48 @@ public:
 	///////////////////////////////////////////////////////////////////////////////
 	double look_up(string name,double value1,double value2,double value3);
 
+	///////////////////////////////////////////////////////////////////////////////
+	//Look-ups with the table name as string literal, one, two and three
+	// independent variables
+	//Brackets are kept per table, see 'Lookup_site'
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	double look_up(const char *name,double value1);
+	double look_up(const char *name,double value1,double value2);
+	double look_up(const char *name,double value1,double value2,double value3);
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Finding the look-up site of a table name literal
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	Lookup_site *find_site(const char *name);
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Look-ups of several tables with identical independent variables and
+	// breakpoints, one, two and three independent variables
+	//Brackets and weights are found once, 'values[k]' returns table 'names[k]'
+	//'names' must be a static array, it identifies the call site like a literal
+	//Example:
+	//	static const char *tables[]={"cl_vs_beta_alpha","cn_vs_beta_alpha"};
+	//	double coef[2];
+	//	aerotable.look_up(tables,2,betax,alphax,coef);
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	void look_up(const char **names,int num,double value1,double *values);
+	void look_up(const char **names,int num,double value1,double value2,double *values);
+	void look_up(const char **names,int num,double value1,double value2,double value3,
+				double *values);
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Finding the table group of a name array, created on first call
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	Lookup_group *find_group(const char **names,int num,int dim);
+
 	///////////////////////////////////////////////////////////////////////////////
 	//Table index finder
 	//This is a binary search method it is O(lgN)
@@ -943,6 +1280,14 @@ public:
 	///////////////////////////////////////////////////////////////////////////////
 	int find_index(int max,double value,double *list);
 
+	///////////////////////////////////////////////////////////////////////////////
+	//Table index finder starting from the bracket 'loc' of the last call
+	//Returns the same locater as 'find_index()' and updates 'loc'
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	int hunt_index(int max,double value,double *list,int &loc);
+
 	///////////////////////////////////////////////////////////////////////////////
 	//Linear one-dimensional interpolation
 	// Constant extrapolation beyond max values of X1
@@ -973,4 +1318,429 @@ public:
 								 int slot,double value1,double value2,double value3);																					
 };
 
+///////////////////////////////////////////////////////////////////////////////
+//Structure 'Mc_worker'
+//Worker process executing one Monte Carlo run
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+struct Mc_worker
+{
+	int pid;      //process id of the worker
+	int nmc;      //MC run executed by the worker
+	FILE *output; //output of the run, written by the worker at its exit
+};
+///////////////////////////////////////////////////////////////////////////////
+//Class 'Monte_carlo'
+//Executes the runs of a Monte Carlo study in worker processes,
+// 'MONTE nmonte iseed nworker' in 'input.asc'
+//The main process initializes each run from 'input.asc' and forks a worker
+// that executes it. The output of a run is buffered by its worker and appended
+// to the screen and the files in run order. Each run seeds 'srand()' and the
+// noise streams of its vehicles ('Random_stream') from 'iseed' and its run number,
+// so the results do not depend on the number of workers.
+//Without 'fork()' (MS VC++) the runs are seeded alike but executed in sequence.
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+class Monte_carlo
+{
+private:
+	bool seeded;  //true if each run is seeded from 'iseed' and its run number
+	bool forking; //true if the runs are executed by worker processes
+	bool worker;  //true in a worker process
+	int nworker;  //maximum number of workers running at a time
+	int iseed;    //seed of the Monte Carlo study
+	vector<ostream *> streams;   //screen, 'tabout.asc', 'traj.asc', 'ploti.asc', 'stati.asc',
+	                             // 'plot.asc', 'stat.asc' and their index files
+	vector<streambuf *> files;   //buffers of 'streams' writing to screen and files
+	vector<stringbuf *> buffers; //buffers of 'streams' collecting the current run
+	deque<Mc_worker> workers;    //running workers in run order
+	FILE *output;                //output of the run in a worker process
+
+public:
+	Monte_carlo():seeded(false),forking(false),worker(false),nworker(0),iseed(0),output(0){}
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Returning true if the runs and their noise streams are seeded by run number
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	bool get_seeded(){return seeded;}
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Returning true if the runs are executed by worker processes
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	bool get_forking(){return forking;}
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Adding 'fout' to the output collected from the workers, before 'start()'
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	void add_stream(ostream &fout){streams.push_back(&fout);}
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Starting the workers with the first run, if 'nworker' is given
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	void start(int nmonte,int nworkers,int seed,ofstream &ftabout,ofstream &ftraj,
+			   ofstream *plot_ostream_list,ofstream *stat_ostream_list,int num_vehicles);
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Seeding run 'nmc' and collecting its output
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	void begin_run(int nmc);
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Forking a worker for run 'nmc'; returns true in the main process
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	bool fork_run(int nmc);
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Handing the output of the run to the main process and exiting, in a worker
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	void end_run();
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Appending the output of the remaining runs and restoring the streams
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	void finish();
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Writing the collected output of the run to 'output', in a worker
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	void write_output();
+
+private:
+	///////////////////////////////////////////////////////////////////////////////
+	//Waiting for the oldest worker and appending its output
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	void merge();
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//Structure 'Vehicle_step'
+//Work of one time step, handed to the threads of 'Vehicle_pool'
+//'step(i)' advances vehicle 'i' and may change only the data of that vehicle
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+struct Vehicle_step
+{
+	virtual ~Vehicle_step(){}
+	virtual void step(int i)=0;
+};
+///////////////////////////////////////////////////////////////////////////////
+//Class 'Pool_console'
+//Stream buffer of the screen while the vehicles are stepped by 'Vehicle_pool'
+//Passes the output of each thread to the buffer of the vehicle it is stepping
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+class Pool_console:public streambuf
+{
+public:
+	static thread_local stringbuf *target; //buffer of the vehicle stepped by the thread
+
+protected:
+	int overflow(int c){return c==EOF?0:target->sputc(char(c));}
+	streamsize xsputn(const char *s,streamsize n){return target->sputn(s,n);}
+};
+///////////////////////////////////////////////////////////////////////////////
+//Class 'Vehicle_pool'
+//Threads stepping the vehicles of a time step concurrently, 'VEHICLES num nthread'
+// in 'input.asc', see 'Combus_frame'
+//The vehicles are handed out one at a time; a thread that is done takes the next
+// vehicle not yet started. The calling thread takes part, so 'nthread=1' steps
+// the vehicles in sequence. The screen output of a vehicle is kept until
+// 'flush()' writes it in vehicle order.
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+class Vehicle_pool
+{
+private:
+	int num;                 //number of vehicles stepped by 'run()'
+	Vehicle_step *work;      //work of the current time step
+	atomic<int> next;        //next vehicle not yet started
+	int busy;                //helper threads still stepping vehicles
+	int generation;          //counts the time steps handed to the helpers
+	bool quit;               //true if the helpers are to exit
+	vector<thread> helpers;  //threads joining the calling thread
+	mutex lock;
+	condition_variable wake; //signals a new time step to the helpers
+	condition_variable done; //signals the end of the time step to 'run()'
+	vector<stringbuf *> screens; //screen output per vehicle
+	Pool_console console;
+
+public:
+	Vehicle_pool(int nthread,int num_vehicles);
+	~Vehicle_pool();
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Executing 'step_work.step(i)' for all vehicles, returns when all are done
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	void run(Vehicle_step &step_work);
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Writing the kept screen output of vehicle 'i'
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	void flush(int i);
+
+private:
+	///////////////////////////////////////////////////////////////////////////////
+	//Stepping vehicles until all are taken
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	void take();
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Waiting for time steps, in a helper thread
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	void serve();
+};
+///////////////////////////////////////////////////////////////////////////////
+//Structure 'Output_slot'
+//Module-variable of a row of 'Output_plan'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+enum Slot_kind{SLOT_REAL,SLOT_INT,SLOT_VEC,SLOT_TAG};
+struct Output_slot
+{
+	int array; //module-variable array, numbered by 'Output_plan::add_array()'
+	int index; //offset of the module-variable in its array
+	int kind;  //'Slot_kind', resolved once from type 'int' and upper case vector names
+};
+///////////////////////////////////////////////////////////////////////////////
+//Class 'Output_plan'
+//Compiled output of module-variables to the plot, stat and traj files
+//Whether a module-variable is an integer, a 3x1 vector or a real is resolved
+// when it is added. Each output step gathers the values into 'row', which is
+// written as text, five accross, or as binary to a stream of 'Output_writer'
+//The first value is replaced by the merge marker '-1.0' if it is module-variable
+// 0 of array 0 ('time')
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+class Output_plan
+{
+private:
+	vector<Variable *> arrays; //module-variable arrays, or data of the 'combus' packets
+	vector<Output_slot> slots; //module-variables in output sequence
+	vector<double> row;        //values of the output step, vectors componentalized
+
+public:
+	///////////////////////////////////////////////////////////////////////////
+	//Adding a module-variable array, returns its number
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	int add_array(Variable *array){arrays.push_back(array);return (int)arrays.size()-1;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Replacing array 'n', e.g. by the current data of a 'combus' packet
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void set_array(int n,Variable *array){arrays[n]=array;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Returning true once module-variables were added
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	bool get_compiled(){return !arrays.empty();}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Returning the number of values of a row
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	int get_ncolumn(){return (int)row.size();}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Adding module-variable 'index' of array 'n'
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void add(int n,int index);
+
+	///////////////////////////////////////////////////////////////////////////
+	//Adding an integer set by the caller, written without line break
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void add_tag();
+
+	///////////////////////////////////////////////////////////////////////////
+	//Gathering the values of the output step, returns 'row'
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	double *gather();
+
+	///////////////////////////////////////////////////////////////////////////
+	//Writing 'row' to 'fout'
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void write(ostream &fout,bool merge);
+};
+class Output_writer;
+///////////////////////////////////////////////////////////////////////////////
+//Structure 'Output_chunk'
+//Rows of a binary output stream, see 'Output_writer'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+struct Output_chunk
+{
+	ostream *file;         //binary output stream
+	int ncolumn;           //values per row
+	int nrow;              //rows in 'values'
+	vector<double> values; //rows in sequence
+	Output_writer *writer; //writer the stream is attached to
+};
+///////////////////////////////////////////////////////////////////////////////
+//Class 'Output_writer'
+//Binary output of the plot, stat and traj files, option 'y_binary'
+//An attached stream receives the banner as in the ASCII file, followed by chunks
+// of rows: 'int' number of rows, 'int' number of columns, then the rows as
+// 'double' values column by column
+//Full chunks are written by a background thread once 'start()' is called;
+// otherwise, as in Monte Carlo worker processes, they are written directly.
+// 'sync()' writes all pending rows and must precede closing the streams.
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+class Output_writer
+{
+private:
+	static int slot;                //'ios_base::pword()' index of the chunk of an attached stream
+	vector<Output_chunk *> chunks;  //chunk being filled, per attached stream
+	deque<Output_chunk *> queue;    //full chunks waiting for 'helper'
+	vector<Output_chunk *> spare;   //written chunks for reuse
+	vector<double> columns;         //values of a chunk, column by column
+	bool threaded;                  //true if 'helper' writes the chunks
+	bool busy;                      //true while 'helper' writes a chunk
+	bool quit;                      //true if 'helper' is to return
+	thread helper;
+	mutex lock;
+	condition_variable wake;        //signals queued chunks or 'quit'
+	condition_variable done;        //signals an empty queue
+
+public:
+	Output_writer():threaded(false),busy(false),quit(false){}
+	~Output_writer();
+
+	///////////////////////////////////////////////////////////////////////////
+	//Returning the chunk of 'fout', NULL if the stream is not attached
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	static Output_chunk *chunk_of(ostream &fout){return (Output_chunk *)fout.pword(slot);}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Starting the background thread
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void start();
+
+	///////////////////////////////////////////////////////////////////////////
+	//Attaching 'fout', opened in binary mode, before its banner is written
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void attach(ostream &fout);
+
+	///////////////////////////////////////////////////////////////////////////
+	//Appending a row of 'n' values to the stream of 'chunk'
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void append(Output_chunk *chunk,const double *values,int n);
+
+	///////////////////////////////////////////////////////////////////////////
+	//Writing all pending rows and waiting for the background thread
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void sync();
+
+private:
+	void submit(Output_chunk *chunk);
+	void store(Output_chunk *chunk);
+	void serve();
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//Class 'Result_store'
+//Plot or stat data of all objects and MC runs streamed onto one file, option 'y_merge'
+//The streams of the objects collect their rows in memory. At the end of each run
+// the rows of each object are appended as one block to the store file ('plot.asc'
+// or 'stat.asc') and the line 'run object rows bytes' to its index file ('plot.idx'
+// or 'stat.idx'). The index starts with the line '0 0 0 bytes' of the banner;
+// a block starts at the sum of the bytes of the preceding index lines.
+//Replaces merging the files of the objects after the study
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+class Result_store
+{
+private:
+	ofstream file;               //banner followed by the blocks of rows
+	ofstream index;              //one line per block
+	vector<ostream *> streams;   //output streams of the objects
+	vector<streambuf *> files;   //buffers of 'streams' writing to their files
+	vector<stringbuf *> buffers; //buffers of 'streams' collecting the rows
+	bool banner;                 //true once the banner is written
+
+public:
+	static int rows; //'ios_base::iword()' index counting the rows written to a stream
+
+	Result_store():banner(false){}
+	~Result_store(){close();}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Returning true if the store file is open
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	bool get_open(){return file.is_open();}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Returning the store and index files, e.g. for output of MC workers
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	ofstream &get_file(){return file;}
+	ofstream &get_index(){return index;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Opening the store file 'name' and the index file 'index_name'
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void open(const char *name,const char *index_name);
+
+	///////////////////////////////////////////////////////////////////////////
+	//Collecting the rows of the 'num_vehicles' streams of 'ostream_list'
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void attach(ofstream *ostream_list,int num_vehicles);
+
+	///////////////////////////////////////////////////////////////////////////
+	//Writing the banner collected by 'fout' once, with the title as first line
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void write_banner(ostream &fout,char *title);
+
+	///////////////////////////////////////////////////////////////////////////
+	//Appending the rows of each object as a block of run 'nmc'
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void end_run(int nmc);
+
+	///////////////////////////////////////////////////////////////////////////
+	//Restoring the streams of the objects and closing the files
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void close();
+};
+
 #endif
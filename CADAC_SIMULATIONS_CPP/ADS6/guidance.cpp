@@ -127,25 +127,21 @@ void Missile::guidance(Packet *combus,int num_vehicles,int vehicle_slot,double i
 	if(guid_mid>=2)
 	{
 		//downloading from combus-package 'fire control radar f1' the IP coordinates
-		string radar_id="f1";
-		for(int i=0;i<num_vehicles;i++)
-		{
-			string id=combus[i].get_id();
-			if (id==radar_id)
-			{						
-				//downloading IP coordinates from radar packet for missiles m1, m2, m3
-				data_t=combus[i].get_data();
-				SIEL1=data_t[4].vec();
-				SIEL2=data_t[5].vec();
-				SIEL3=data_t[6].vec();
-			}
-			//assigning IPs to missiles
-			//!!!assumption: MISSILE6 objects are loaded first in 'input.asc' (usual order)
-			//  and there is a one-on-one (missile-target) assignment for intercept
-			if(vehicle_slot==0) SIBLC=SIEL1-SBELC;
-			if(vehicle_slot==1) SIBLC=SIEL2-SBELC;
-			if(vehicle_slot==2) SIBLC=SIEL3-SBELC;
+		int radar_slot=packet_slot('f',1);
+		if(radar_slot>=0)
+		{						
+			//downloading IP coordinates from radar packet for missiles m1, m2, m3
+			data_t=combus[radar_slot].get_data();
+			SIEL1=data_t[4].vec();
+			SIEL2=data_t[5].vec();
+			SIEL3=data_t[6].vec();
 		}
+		//assigning IPs to missiles
+		//!!!assumption: MISSILE6 objects are loaded first in 'input.asc' (usual order)
+		//  and there is a one-on-one (missile-target) assignment for intercept
+		if(vehicle_slot==0) SIBLC=SIEL1-SBELC;
+		if(vehicle_slot==1) SIBLC=SIEL2-SBELC;
+		if(vehicle_slot==2) SIBLC=SIEL3-SBELC;
 	}	
 	//executing midcouse line guidance towards IP point
 	if(guid_mid==2){
@@ -171,9 +171,7 @@ void Missile::init_ins()
 
 	//drawing Gaussian 9x1 vector with unit std deviation
 	Matrix GAUSS_INIT(9,1);
-	for(int r=0; r<9;r++){
-		GAUSS_INIT.assign_loc(r,0,gauss(0,1));
-	}
+	gauss(GAUSS_INIT.get_pbody(),9,0,1);
 	//forming random initial state vector
 	Matrix XX_INIT=APP_INIT*GAUSS_INIT;
 	XX_INIT*=(1+frax);
@@ -209,25 +209,21 @@ void Flat6::kinematics(double sim_time,double event_time,double &int_step,double
 
 	//*Computing elapsed time since missile launch
 	//downloading missile launch delay from 'combus'
-	string radar_id="f1";
-	for(int i=0;i<num_vehicles;i++)
-	{
-		string id=combus[i].get_id();
-		if (id==radar_id)
-		{						
-			//downloading IP coordiantes from radar packet for missiles m1, m2, m3
-			data_t=combus[i].get_data();
-			lnch_delay1=data_t[1].real();
-			lnch_delay2=data_t[2].real();
-			lnch_delay3=data_t[3].real();
-		}
-		//assigning launch delays to missiles
-		//!!!assumption: MISSILE6 objects are loaded first in 'input.asc' (usual order)
-		//  and there is a one-on-one (missile-rocket) sequence of intercept
-		if(vehicle_slot==0) lnch_delay=lnch_delay1;
-		if(vehicle_slot==1) lnch_delay=lnch_delay2;
-		if(vehicle_slot==2) lnch_delay=lnch_delay3;
+	int radar_slot=packet_slot('f',1);
+	if(radar_slot>=0)
+	{						
+		//downloading IP coordiantes from radar packet for missiles m1, m2, m3
+		data_t=combus[radar_slot].get_data();
+		lnch_delay1=data_t[1].real();
+		lnch_delay2=data_t[2].real();
+		lnch_delay3=data_t[3].real();
 	}
+	//assigning launch delays to missiles
+	//!!!assumption: MISSILE6 objects are loaded first in 'input.asc' (usual order)
+	//  and there is a one-on-one (missile-rocket) sequence of intercept
+	if(vehicle_slot==0) lnch_delay=lnch_delay1;
+	if(vehicle_slot==1) lnch_delay=lnch_delay2;
+	if(vehicle_slot==2) lnch_delay=lnch_delay3;
 	//missile time since launch
 	double del_time=sim_time-lnch_delay;
 	//discrading negative missile time
@@ -408,6 +408,7 @@ Packet Radar::loading_packet_init(int num_missile,int num_aircraft,int num_rocke
 //uses C-code 'sprintf' function to convert 'int' to 'char'
 //
 //010207 Created by Peter H Zipfel
+//261017 Values refreshed only, metadata loaded by 'loading_packet_init()'
 ///////////////////////////////////////////////////////////////////////////////
 Packet Radar::loading_packet(int num_missile,int num_aircraft,int num_rocket,int num_radar)
 {
@@ -427,12 +428,12 @@ Packet Radar::loading_packet(int num_missile,int num_aircraft,int num_rocket,int
 	for(i=0;i<flat0_com_count;i++)
 	{
 		index=flat0_com_ind[i];
-		com_radar0[i]=flat0[index];
+		com_radar0[i].copy_value(flat0[index]);
 	}
 	for(int j=0;j<radar_com_count;j++)
 	{
 		index=radar_com_ind[j];
-		com_radar0[i+j]=radar[index];
+		com_radar0[i+j].copy_value(radar[index]);
 	}
 	//refreshing the packet
 	packet.set_data(com_radar0);
@@ -555,6 +556,7 @@ void Radar::document(ostream &fdoc,char *title,Document *doc_radar0)
 // For debugging puposes un-comment the print out provision of the tables below
 //
 //170916 Created by Peter H Zipfel
+//261017 Tables shared with vehicles reading the same file
 ///////////////////////////////////////////////////////////////////////////////
 void Radar::read_tables(char *file_name,Datadeck &datatable)
 {
@@ -568,6 +570,9 @@ void Radar::read_tables(char *file_name,Datadeck &datatable)
 	int var_dim[3]={1,1,1,};
 	int tt(0);
 
+	//taking the tables of another vehicle that has read the file already
+	if(datatable.share(file_name)) return;
+
 	//opening traj-deck file stream
 	ifstream tbl_stream(file_name);
 
@@ -683,4 +688,7 @@ void Radar::read_tables(char *file_name,Datadeck &datatable)
 		tbl_stream>>temp; //reading next DIM entry
 		
 	}//end of 'for' loop, finished loading all tables
+
+	//offering the tables to vehicles reading the same file
+	datatable.keep(file_name);
 }
\ No newline at end of file
@@ -195,13 +195,7 @@ void Radar::sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim_t
 			for(int i=0;i<num_vehicles;i++)
 			{
 				//downloading from 'combus' rocket variables
-				//getting vehicle id
-				string id=combus[i].get_id();
-				char number[4];	
-				sprintf(number,"%i",rocket_num);
-				string rocket_id="r"+string(number);
-
-				if (id==rocket_id)
+				if (i==packet_slot('r',rocket_num))
 				{
 					//downloading data from rocket packet
 					//(though in 'Flat3' the letter 'A' represents the air-target, which comprises both rocket and aircraft
@@ -269,12 +263,7 @@ void Radar::sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim_t
 
 						//**Missile tracking & calculating IP altitude differential 
 						//*Downloading missile coordinates from 'combus'
-						//getting vehicle id
-						string id=combus[i].get_id();
-						char number[4];	
-						sprintf(number,"%i",rocket_num);
-						string missile_id="m"+string(number);
-						if (id==missile_id)
+						if (i==packet_slot('m',rocket_num))
 						{
 							data_m=combus[i].get_data();
 							SBEL=data_m[3].vec();
@@ -391,13 +380,7 @@ void Radar::sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim_t
 			for(int i=0;i<num_vehicles;i++)
 			{
 				//*Downloading from 'combus' aircraft variables
-				//getting vehicle id
-				string id=combus[i].get_id();
-				char number[4];	
-				sprintf(number,"%i",aircraft_num);
-				string aircraft_id="a"+string(number);
-
-				if (id==aircraft_id)
+				if (i==packet_slot('a',aircraft_num))
 				{
 					//downloading data from aircraft packet
 					//(though in 'Flat3' the letter 'A' represents the air-target, which comprises both aircraft and aircraft
@@ -410,6 +410,7 @@ Packet Rocket::loading_packet_init(int num_missile,int num_aircraft,int num_rock
 //uses C-code 'sprintf' function to convert 'int' to 'char'
 //
 //010207 Created by Peter H Zipfel
+//261017 Values refreshed only, metadata loaded by 'loading_packet_init()'
 ///////////////////////////////////////////////////////////////////////////////
 Packet Rocket::loading_packet(int num_missile,int num_aircraft,int num_rocket,int num_radar)
 {
@@ -429,12 +430,12 @@ Packet Rocket::loading_packet(int num_missile,int num_aircraft,int num_rocket,in
 	for(i=0;i<flat3_com_count;i++)
 	{
 		index=flat3_com_ind[i];
-		com_rocket3[i]=flat3[index];
+		com_rocket3[i].copy_value(flat3[index]);
 	}
 	for(int j=0;j<rocket_com_count;j++)
 	{
 		index=rocket_com_ind[j];
-		com_rocket3[i+j]=rocket[index];
+		com_rocket3[i+j].copy_value(rocket[index]);
 	}
 	//refreshing the packet
 	packet.set_data(com_rocket3);
@@ -562,6 +563,7 @@ void Rocket::document(ostream &fdoc,char *title,Document *doc_rocket5)
 //031104 Corrected table diagnostic, PZi
 //060505 Corrected line 1742 (changed 'else if' to 'if'), TPo
 //070419 Included here in rocket_functions.cpp', PZi
+//261017 Tables shared with vehicles reading the same file
 ///////////////////////////////////////////////////////////////////////////////
 void Rocket::read_tables(char *file_name,Datadeck &datatable)
 {
@@ -575,6 +577,9 @@ void Rocket::read_tables(char *file_name,Datadeck &datatable)
 	int var_dim[3]={1,1,1,};
 	int tt(0);
 
+	//taking the tables of another vehicle that has read the file already
+	if(datatable.share(file_name)) return;
+
 	//opening file stream
 	ifstream tbl_stream(file_name);
 
@@ -690,4 +695,7 @@ void Rocket::read_tables(char *file_name,Datadeck &datatable)
 		tbl_stream>>temp; //reading next DIM entry
 		
 	}//end of 'for' loop, finished loading all tables
+
+	//offering the tables to vehicles reading the same file
+	datatable.keep(file_name);
 }
\ No newline at end of file
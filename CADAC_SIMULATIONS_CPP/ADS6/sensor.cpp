@@ -236,15 +236,9 @@ void Missile::sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim
 	//rocket-target
 	if(mtarget==1)
 	{
-		//finding 1st rocket-target slot in 'combus'
-		char number[4];
-		sprintf(number,"%i",1);
-		string first_rocket_id="r"+string(number);
-		for(int i=0;i<num_vehicles;i++)
-		{
-			string id=combus[i].get_id();
-			if (id==first_rocket_id) fst_tgt_slot=i;
-		}
+		//1st rocket-target slot in 'combus'
+		int first_slot=packet_slot('r',1);
+		if(first_slot>=0) fst_tgt_slot=first_slot;
 		//pairing rocket-target slot to 'this' missile
 		//!!!assumption for 'input.asc': MISSILE6 objects are loaded first in  (usual order)
 		//  and there is a one-on-one missile-rocket assignement (m1->r1, m2->r2, m3->r3)
@@ -261,15 +255,9 @@ void Missile::sensor(Packet *combus,int num_vehicles,int vehicle_slot,double sim
 	//aircraft-target
 	else if(mtarget==2)
 	{
-		//finding 1st aircraft-target slot in 'combus'
-		char number[4];
-		sprintf(number,"%i",1);
-		string first_aircraft_id="a"+string(number);
-		for(int i=0;i<num_vehicles;i++)
-		{
-			string id=combus[i].get_id();
-			if (id==first_aircraft_id) fst_tgt_slot=i;
-		}
+		//1st aircraft-target slot in 'combus'
+		int first_slot=packet_slot('a',1);
+		if(first_slot>=0) fst_tgt_slot=first_slot;
 		//pairing aircraft-target slot to 'this' missile
 		//!!!assumption for 'input.asc': MISSILE6 objects are loaded first in  (usual order)
 		//  and there is a one-on-one missile-aircraft assignement (m1->a1, m2->a2, m3->a3)
@@ -83,23 +83,16 @@ void Aircraft::guidance(Packet *combus,int num_vehicles)
 	//escape maneuver from red target
 	if(acft_option==2){
 		//downloading from 'combus' red target states
-		int i(0);
-		char number[4];	
 		Matrix STEL(3,1);
 		Matrix VTEL(3,1);
-		//building target id = t(j+1); first red target is used
-		sprintf(number,"%i",1);
-		string target_id="t"+string(number);
-		//finding slot 'i' of target in 'combus' (same as in vehicle_list)
-		for(i=0;i<num_vehicles;i++){
-			string id=combus[i].get_id();
-			if (id==target_id){
-				//downloading data from target packet
-				tgt_com_slot=i;
-				data_t=combus[i].get_data();
-				STEL=data_t[1].vec();
-				VTEL=data_t[2].vec();
-			}
+		//slot 'i' of the first red target 't1' in 'combus' (same as in vehicle_list)
+		int i=packet_slot('t',1);
+		if(i>=0){
+			//downloading data from target packet
+			tgt_com_slot=i;
+			data_t=combus[i].get_data();
+			STEL=data_t[1].vec();
+			VTEL=data_t[2].vec();
 		}
 		//distance to target
 		Matrix SATL(3,1);
@@ -414,14 +407,7 @@ void Aircraft::sensor(Packet *combus,int num_vehicles,double sim_time,double int
 		for(int i=0;i<num_vehicles;i++){
 
 			//downloading from 'combus' target variables
-			//getting vehicle id
-			string id=combus[i].get_id();
-			//building target id = t(j+1)
-			char number[4];	
-			sprintf(number,"%i",target_num);
-			string target_id="t"+string(number);
-
-			if (id==target_id){
+			if (i==packet_slot('t',target_num)){
 
 				//downloading data from target packet
 				data_t=combus[i].get_data();
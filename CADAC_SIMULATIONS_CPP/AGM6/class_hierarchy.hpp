@@ -26,6 +26,12 @@ class Cadac
 {
 private:
 	char name[CHARN]; //vehicle object name
+	//noise streams by source, see 'Random_source'
+	Random_stream random[NRANDOM];
+	//source of the draws, set by the executive
+	int random_source;
+	//true if drawing from 'random', else from 'rand()'
+	bool random_seeded;
 		
 protected:
 	//module-variable array of class 'Flat6'
@@ -55,14 +61,54 @@ public:
 	//time elapsed in event 
 	double event_time;
 
+	//fraction of the integration step elapsed since the located event
+	double event_lag;
+
 	virtual~Cadac(){};
 
 	///////////////////////////////////////////////////////////////////////////
 	//Constructor of class 'Cadac'
 	//
 	//010703 Created by Peter H Zipfel
+	//261017 Event state zeroed, read before the first event
+	///////////////////////////////////////////////////////////////////////////
+	Cadac():event_epoch(false),event_time(0),event_lag(0),random_source(RANDOM_INPUT),random_seeded(false){}
+
 	///////////////////////////////////////////////////////////////////////////
-	Cadac(){}
+	//Noise streams of the vehicle object, one per source, see 'Random_source'
+	//Within the vehicle classes these functions hide the global stochastic
+	// functions, so each module draws from the stream of its own source.
+	//Unless 'seed_random()' is called the draws come from 'rand()' as before.
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void seed_random(int iseed,int nmc,int vehicle)
+	{
+		for(int i=0;i<NRANDOM;i++) random[i].seed(iseed,nmc,vehicle,i);
+		random_seeded=true;
+	}
+	void set_random_source(int source){random_source=source;}
+
+	double unituni()
+	{return random_seeded?random[random_source].unituni(): ::unituni();}
+	double uniform(double min,double max)
+	{return random_seeded?random[random_source].uniform(min,max): ::uniform(min,max);}
+	double gauss(double mean,double sig)
+	{return random_seeded?random[random_source].gauss(mean,sig): ::gauss(mean,sig);}
+	void gauss(double *values,int num,double mean,double sig)
+	{
+		if(random_seeded) random[random_source].gauss(values,num,mean,sig);
+		else for(int i=0;i<num;i++) values[i]=::gauss(mean,sig);
+	}
+	double markov(double sigma,double bcor,double time,double intstep,double &value_saved)
+	{
+		if(random_seeded) return random[random_source].markov(sigma,bcor,time,intstep,value_saved);
+		return ::markov(sigma,bcor,time,intstep,value_saved);
+	}
+	double rayleigh(double mode)
+	{return random_seeded?random[random_source].rayleigh(mode): ::rayleigh(mode);}
+	double exponential(double density)
+	{return random_seeded?random[random_source].exponential(density): ::exponential(density);}
 
 	///////////////////////////////////////////////////////////////////////////
 	//Setting vehicle object name
@@ -280,6 +326,10 @@ protected:
 	//be written to the 'ploti.asc' files
 	int *missile_plot_ind; int missile_plot_count;
 
+	//compiled output plans of the 'ploti.asc' and 'stati.asc' files
+	Output_plan plot_plan;
+	Output_plan stat_plan;
+
 	//Indicator array pointing to the module-variable which are to 
 	//be written to 'combus' 'packets'
 	int *missile_com_ind; int missile_com_count;
@@ -65,29 +65,24 @@ void Missile::datalink(Packet *combus,int num_vehicles)
 	double time=flat6[0].real();// for debugging
 	//-------------------------------------------------------------------------
 	//downloading from 'combus' the target track file
-	string aircft_id="a1";
+	//slot of aircraft 'a1' in 'combus' (same as in vehicle_list)
+	int aircft_slot=packet_slot('a',1);
+	if(aircft_slot>=0)
+	{						
+		//downloading track file of target identified by 'tgt_num'
+		data_t=combus[aircft_slot].get_data();
+		STCEL=data_t[2*tgt_num+5].vec();
+		VTCEL=data_t[2*tgt_num+6].vec();
 
-	//finding slot 'i' of aircraft in 'combus' (same as in vehicle_list)
-	for(int i=0;i<num_vehicles;i++)
-	{
-		string id=combus[i].get_id();
-		if (id==aircft_id)
-		{						
-			//downloading track file of target identified by 'tgt_num'
-			data_t=combus[i].get_data();
-			STCEL=data_t[2*tgt_num+5].vec();
-			VTCEL=data_t[2*tgt_num+6].vec();
-
-			//downloading aircraft position and velocity
-			SAEL=data_t[2].vec();
-			VAEL=data_t[3].vec();
-		}
-		//datalink sets update flag (mnav=3) if target position has changed
-		tgt_pos_new=STCEL.absolute();
-		if(fabs(tgt_pos-tgt_pos_new)>EPS){
-			mnav=3;
-			tgt_pos=tgt_pos_new;
-		}
+		//downloading aircraft position and velocity
+		SAEL=data_t[2].vec();
+		VAEL=data_t[3].vec();
+	}
+	//datalink sets update flag (mnav=3) if target position has changed
+	tgt_pos_new=STCEL.absolute();
+	if(fabs(tgt_pos-tgt_pos_new)>EPS){
+		mnav=3;
+		tgt_pos=tgt_pos_new;
 	}
 	//-------------------------------------------------------------------------
 	//loading module-variables
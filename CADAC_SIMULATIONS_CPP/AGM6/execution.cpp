@@ -11,6 +11,7 @@
 //081010 Modified for GENSIM6, PZi
 //100405 Modified for AGM6, PZi
 //140824 Upgraded to Visual C++ V12 (2013), PZi
+//261017 Monte Carlo runs executed by worker processes
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "class_hierarchy.hpp"
@@ -24,7 +25,7 @@ using namespace std;
 
 //acquiring the simmulation title
 void acquire_title_options(fstream &input,char *title,char *options,int &nmonte,
-						   int &iseed,int &nmc);
+						   int &iseed,int &nmc,int &nworker);
 
 //acquiring the simulation run time
 double acquire_endtime(fstream &input);
@@ -57,12 +58,6 @@ void combus_status(Packet *combus,int *status,int num_vehicles);
 void acquire_timing(fstream &input,double &plot_step,double &scn_step,double &com_step,
 					double &traj_step,double &int_step);
 
-//merging the 'ploti.asc' files onto 'plot.asc' 
-void merge_plot_files(string *plot_file_list,int num_missile,char *title);
-
-//merging the 'stati.asc' files onto 'stat.asc' 
-void merge_stat_files(string *stat_file_list,int num_missile,char *title);
-
 //writing 'combus' data on screen
 void comscrn_data(Packet *combus,int num_vehicles);
 
@@ -116,7 +111,12 @@ int main()
 	int nmonte=0; //number of MC runs to be executed
 	int nmc=0; //MC counter
 	int iseed; //seeding srand()
+	int nworker=0; //number of worker processes executing the MC runs
+	Monte_carlo mc; //executes the MC runs in worker processes
 	bool one_traj_banner=true; //write just one banner on file 'traj.asc'
+	Output_writer writer; //binary output of the plot, stat and traj files, option 'y_binary'
+	Result_store plot_store; //plot data of all objects and runs on 'plot.asc', option 'y_merge'
+	Result_store stat_store; //stat data of all objects and runs on 'stat.asc', option 'y_merge'
 	bool *stati_write_term = NULL; //flag for writing impact data on 'stati.asc' once
 	Document *doc_missile6 = NULL;  //array for documenting MISSILE6 module-variables of 'input.asc'
 	Document *doc_target3 = NULL;  //array for documenting TARGET3 module-variables of 'input.asc'
@@ -164,8 +164,21 @@ int main()
 		bool document_aircraft=true; //write  to 'doc.asc' aircraft module-variables only once
 		bool traj_merge=false; //flag used in writing 'time=-1' endblock on 'traj.asc'
 		
+		//seeding the run and collecting its output, if executed by a worker
+		mc.begin_run(nmc);
+
 		//aqcuiring title statement and option selections
-		acquire_title_options(input,title,options,nmonte,iseed,nmc);
+		acquire_title_options(input,title,options,nmonte,iseed,nmc,nworker);
+
+		//binary output of the 'traj' file, 'y_binary' on the OPTIONS line
+		if(!nmc&&strstr(options,"y_binary")&&strstr(options,"y_traj"))
+		{
+			ftraj.close();
+			remove("traj.asc");
+			ftraj.open("traj.bin",ios::binary);
+			if(!ftraj){cout<<" *** Error: cannot open 'traj.bin' file *** \n";exit(1);}
+			writer.attach(ftraj);
+		}
 
 		//initializing random number generator
 		if(!nmc) srand(iseed); 
@@ -237,6 +250,31 @@ int main()
 		//initialize 'stati_write_term' to true
 		for(int ii=0;ii<num_vehicles;ii++) stati_write_term[ii]=true;
 
+		//collecting the rows of all objects and runs on 'plot.asc' and 'stat.asc', option 'y_merge'
+		if(!nmc&&strstr(options,"y_merge")&&!strstr(options,"y_binary"))
+		{
+			if(strstr(options,"y_plot"))
+			{
+				plot_store.open("plot.asc","plot.idx");
+				plot_store.attach(plot_ostream_list,num_vehicles);
+				mc.add_stream(plot_store.get_file());
+				mc.add_stream(plot_store.get_index());
+			}
+			if(strstr(options,"y_stat"))
+			{
+				stat_store.open("stat.asc","stat.idx");
+				stat_store.attach(stat_ostream_list,num_vehicles);
+				mc.add_stream(stat_store.get_file());
+				mc.add_stream(stat_store.get_index());
+			}
+		}
+
+		//starting the workers with the first run, if 'MONTE' gives their number
+		if(!nmc) mc.start(nmonte,nworker,iseed,ftabout,ftraj,plot_ostream_list,stat_ostream_list,num_vehicles);
+
+		//binary chunks written in the background, unless the runs are forked to workers
+		if(!nmc&&strstr(options,"y_binary")&&!mc.get_forking()) writer.start();
+
 		///////////////////////////////////////////////////////////////////////
 		////////////////// Initializing each vehicle object  ///////////////
 		///////////////////////////////////////////////////////////////////////
@@ -258,24 +296,32 @@ int main()
 			//getting the name of the type of vehicle
 			strcpy(vehicle_name,vehicle_list[i]->get_vname());
 
+			//seeding the noise streams of the vehicle, if the runs are seeded by run number
+			if(mc.get_seeded()) vehicle_list[i]->seed_random(iseed,nmc,i);
+
 			//vehicle data and tables read from 'input.asc' 
+			vehicle_list[i]->set_random_source(RANDOM_INPUT);
 			vehicle_list[i]->vehicle_data(input,nmonte);
 
 			//executing initialization computations -MOD		
 			for (int j=0;j<num_modules;j++)
 			{
-				if((module_list[j].name=="kinematics")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_kinematics(sim_time,int_step,launch_delay);
-				else if((module_list[j].name=="aerodynamics")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_aerodynamics();
-				else if((module_list[j].name=="environment")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_environment();
-				else if((module_list[j].name=="propulsion")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_propulsion();
-				else if((module_list[j].name=="ins")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_ins();
-				else if((module_list[j].name=="newton")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_newton();
+				vehicle_list[i]->set_random_source(module_list[j].id);
+				if(module_list[j].init)
+					switch(module_list[j].id){
+					case MOD_KINEMATICS:
+						vehicle_list[i]->init_kinematics(sim_time,int_step,launch_delay);break;
+					case MOD_AERODYNAMICS:
+						vehicle_list[i]->init_aerodynamics();break;
+					case MOD_ENVIRONMENT:
+						vehicle_list[i]->init_environment();break;
+					case MOD_PROPULSION:
+						vehicle_list[i]->init_propulsion();break;
+					case MOD_INS:
+						vehicle_list[i]->init_ins();break;
+					case MOD_NEWTON:
+						vehicle_list[i]->init_newton();break;
+					}
 			}
 			//populating the launch delay list
 			launch_delay_list[i]=launch_delay;
@@ -318,15 +364,24 @@ int main()
 
 						//building names for plot files
 						sprintf(index,"%i",i+1);
-						plotiasc="plot"+string(index)+".asc"; //using Standard Library string constructor
+						plotiasc="plot"+string(index)+(strstr(options,"y_binary")?".bin":".asc"); //using Standard Library string constructor
 						plot_file_list[i]=plotiasc;
 						name=plotiasc.c_str(); //using string member function to convert to char array 
 
 						//creating output stream list 'plot_ostream_list[i]', each will write on file 'ploti.asc'
-						plot_ostream_list[i].open(name); //'name' must be 'char' type
+						if(strstr(options,"y_binary"))
+						{
+							plot_ostream_list[i].open(name,ios::binary);
+							writer.attach(plot_ostream_list[i]);
+						}
+						else if(!plot_store.get_open())
+							plot_ostream_list[i].open(name); //'name' must be 'char' type
 
 						//writing banner on 'ploti.asc'
-						vehicle_list[i]->plot_banner(plot_ostream_list[i],title);				}
+						vehicle_list[i]->plot_banner(plot_ostream_list[i],title);
+
+						//with option 'y_merge', the banner of the first object heads 'plot.asc'
+						plot_store.write_banner(plot_ostream_list[i],title);				}
 				}
 
 				//creating output stream objects in 'stat_ostream_list[i]' for every file "stati.asc"
@@ -341,15 +396,24 @@ int main()
 
 						//building names for stat files
 						sprintf(index,"%i",i+1);
-						statiasc="stat"+string(index)+".asc"; //using Standard Library string constructor
+						statiasc="stat"+string(index)+(strstr(options,"y_binary")?".bin":".asc"); //using Standard Library string constructor
 						stat_file_list[i]=statiasc;
 						name=statiasc.c_str(); //using string member function to convert to char array 
 
 						//creating output stream list 'stat_ostream_list[i]', each will write on file 'stati.asc'
-						stat_ostream_list[i].open(name); //'name' must be 'char' type
+						if(strstr(options,"y_binary"))
+						{
+							stat_ostream_list[i].open(name,ios::binary);
+							writer.attach(stat_ostream_list[i]);
+						}
+						else if(!stat_store.get_open())
+							stat_ostream_list[i].open(name); //'name' must be 'char' type
 
 						//writing banner on 'stati.asc'
-						vehicle_list[i]->plot_banner(stat_ostream_list[i],title);				}
+						vehicle_list[i]->plot_banner(stat_ostream_list[i],title);
+
+						//with option 'y_merge', the banner of the first object heads 'stat.asc'
+						stat_store.write_banner(stat_ostream_list[i],title);				}
 				}
 
 				//composing documentation of 'flat6','missile','flat3','target' and 'aircraft' module-variables
@@ -391,6 +455,9 @@ int main()
 
 		} //end of initialization of vehicle object loop
 
+		//resolving the 'combus' slots of the packet ids for the modules reading other packets
+		resolve_packet_slots(combus,num_vehicles);
+
 		//writing 'combus' data to screen at time=0, after module initialization			
 		if(strstr(options,"y_comscrn"))
 		{
@@ -422,11 +489,26 @@ int main()
 		/////////////////////// Simulation Execution //////////////////////////
 		///////////////////////////////////////////////////////////////////////	
 
-		execute(vehicle_list,module_list,sim_time,
-				 end_time,num_vehicles,num_modules,plot_step,
-				 int_step,scrn_step,com_step,traj_step,options,ftabout,
-				 plot_ostream_list,combus,status,num_missile,num_target,num_aircraft,ftraj,title,
-				 traj_merge,nmonte,nmc,stat_ostream_list,stati_write_term,launch_delay_list);
+		//writing the pending binary rows, so a worker does not inherit them
+		writer.sync();
+
+		//the main process hands the run to a worker and initializes the next run
+		if(!mc.fork_run(nmc))
+		{
+			execute(vehicle_list,module_list,sim_time,
+					 end_time,num_vehicles,num_modules,plot_step,
+					 int_step,scrn_step,com_step,traj_step,options,ftabout,
+					 plot_ostream_list,combus,status,num_missile,num_target,num_aircraft,ftraj,title,
+					 traj_merge,nmonte,nmc,stat_ostream_list,stati_write_term,launch_delay_list);
+
+			//appending the rows of the run to 'plot.asc' and 'stat.asc', option 'y_merge'
+			plot_store.end_run(nmc);
+			stat_store.end_run(nmc);
+
+			//a worker hands its output to the main process and exits
+			writer.sync();
+			mc.end_run();
+		}
 
 		//deallocating dynamic memory
 		delete [] module_list;
@@ -440,6 +522,9 @@ int main()
 	}	// at this point the destructor of the object 'Vehicle vehicle_list' is called 
 	while(nmc<nmonte); 
 
+	//appending the output of the remaining runs in run order
+	mc.finish();
+
 	///////////////////////////////////////////////////////////////////////////	
 	///////////////////////// End of Monte Carlo Loop /////////////////////////
 	///////////////////////////////////////////////////////////////////////////	
@@ -451,6 +536,13 @@ int main()
 	fcopy.close();
 	int f(0);
 
+	//writing the pending binary rows of the plot, stat and traj files
+	writer.sync();
+
+	//closing 'plot.asc' and 'stat.asc', restoring the streams of the objects
+	plot_store.close();
+	stat_store.close();
+
 	//Close file streams
 	ftabout.close();
 	for(f=0;f<num_vehicles;f++) plot_ostream_list[f].close();
@@ -458,17 +550,6 @@ int main()
 	for(f=0;f<num_vehicles;f++) stat_ostream_list[f].close();
 	ftraj.close();
 
-	//merging 'ploti.asc' files into 'plot.asc'
-	if(strstr(options,"y_merge")&&strstr(options,"y_plot"))
-	{
-		merge_plot_files(plot_file_list,num_missile,title);
-	}
-	//merging 'stati.asc' files into 'stat.asc'm using 'merge_plot_data' function
-	//adding at the end: time=-1 and dummy block of data
-	if(strstr(options,"y_merge")&&strstr(options,"y_stat"))
-	{
-		merge_stat_files(stat_file_list,num_missile,title);
-	}
 	//deallocate dynamic memory
 	delete [] plot_ostream_list;
 	delete [] plot_file_list;
@@ -528,6 +609,7 @@ int main()
 //070531 Incrementing 'sim_time' in 'combus' until 'ENDTIME' is reached, PZi
 //081010 Modified for GENSIM6, PZi
 //100405 Modified for AGM6, PZi
+//261017 Module dispatch on 'Module_id' instead of name comparisons
 ///////////////////////////////////////////////////////////////////////////////
 void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			 double end_time,int num_vehicles,int num_modules,double plot_step,
@@ -563,48 +645,53 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 				//watching for the next event			
 				vehicle_list[i]->event(options);
 
-				//fixing 'event_epoch' and initializing 'event_time'
+				//fixing 'event_epoch' and initializing 'event_time' at the (located) event
+				//the event's new values took effect at the end of this step, not at the crossing
 				if(vehicle_list[i]->event_epoch)
-					vehicle_list[i]->event_time=0;
+					vehicle_list[i]->event_time=vehicle_list[i]->event_lag*int_step;
 
 				//continue only if vehicle is alive (health=1:alive; =-1:hit('target' only); =0:dead)
 				int health=combus[i].get_status();
 				if(health==1)
 				{
 					//refreshing Markov variables
+					vehicle_list[i]->set_random_source(RANDOM_MARKOV);
 					vehicle_list[i]->markov_noise(sim_time,int_step,nmonte);
 
 					//module loop -MOD
 					for(int j=0;j<num_modules;j++)
 					{
-						if(module_list[j].name=="environment")
-							vehicle_list[i]->environment(int_step);
-						else if(module_list[j].name=="kinematics")
-							vehicle_list[i]->kinematics(sim_time,vehicle_list[i]->event_time,int_step,out_fact);
-						else if(module_list[j].name=="newton")
-							vehicle_list[i]->newton(int_step);
-						else if(module_list[j].name=="euler")
-							vehicle_list[i]->euler(int_step);
-						else if(module_list[j].name=="aerodynamics")
-							vehicle_list[i]->aerodynamics();
-						else if(module_list[j].name=="propulsion")
-							vehicle_list[i]->propulsion(int_step);
-						else if(module_list[j].name=="forces")
-							vehicle_list[i]->forces();
-						else if(module_list[j].name=="actuator")
-							vehicle_list[i]->actuator(int_step);
-						else if(module_list[j].name=="control") 
-							vehicle_list[i]->control(int_step);
-						else if(module_list[j].name=="datalink")
-							vehicle_list[i]->datalink(combus,num_vehicles);
-						else if(module_list[j].name=="guidance")
-							vehicle_list[i]->guidance(combus,num_vehicles);
-						else if(module_list[j].name=="ins")
-							vehicle_list[i]->ins(int_step);
-						else if(module_list[j].name=="sensor")
-							vehicle_list[i]->sensor(combus,num_vehicles,sim_time,int_step);
-						else if(module_list[j].name=="intercept")
-							vehicle_list[i]->intercept(combus,vehicle_slot,num_vehicles,int_step,title);
+						vehicle_list[i]->set_random_source(module_list[j].id);
+						switch(module_list[j].id){
+						case MOD_ENVIRONMENT:
+							vehicle_list[i]->environment(int_step);break;
+						case MOD_KINEMATICS:
+							vehicle_list[i]->kinematics(sim_time,vehicle_list[i]->event_time,int_step,out_fact);break;
+						case MOD_NEWTON:
+							vehicle_list[i]->newton(int_step);break;
+						case MOD_EULER:
+							vehicle_list[i]->euler(int_step);break;
+						case MOD_AERODYNAMICS:
+							vehicle_list[i]->aerodynamics();break;
+						case MOD_PROPULSION:
+							vehicle_list[i]->propulsion(int_step);break;
+						case MOD_FORCES:
+							vehicle_list[i]->forces();break;
+						case MOD_ACTUATOR:
+							vehicle_list[i]->actuator(int_step);break;
+						case MOD_CONTROL:
+							vehicle_list[i]->control(int_step);break;
+						case MOD_DATALINK:
+							vehicle_list[i]->datalink(combus,num_vehicles);break;
+						case MOD_GUIDANCE:
+							vehicle_list[i]->guidance(combus,num_vehicles);break;
+						case MOD_INS:
+							vehicle_list[i]->ins(int_step);break;
+						case MOD_SENSOR:
+							vehicle_list[i]->sensor(combus,num_vehicles,sim_time,int_step);break;
+						case MOD_INTERCEPT:
+							vehicle_list[i]->intercept(combus,vehicle_slot,num_vehicles,int_step,title);break;
+						}
 					} //end of module loop
 
 					//preserving 'health' status of vehicle objects
@@ -561,8 +561,8 @@ void Missile::vehicle_data(fstream &input,int nmonte)
 				nmarkov++;						
 			}
 
-			//reading events into 'Event' pointer array 'event_ptr_list' of size NEVENT
-			if(!strcmp(read,"IF"))
+			//reading events ('IF' in sequence, 'WHEN' pending) into 'Event' pointer array 'event_ptr_list' of size NEVENT
+			if(!strcmp(read,"IF")||!strcmp(read,"WHEN"))
 			{
 				event_total++;
 				//reading name of watch variable
@@ -587,6 +587,8 @@ void Missile::vehicle_data(fstream &input,int nmonte)
 				event_ptr_list[e]->set_variable(variable);
 				event_ptr_list[e]->set_value(value);
 				event_ptr_list[e]->set_operator(oper);
+				event_ptr_list[e]->set_pending(!strcmp(read,"WHEN"));
+				event_ptr_list[e]->compile();
 				input.getline(line_clear,CHARL,'\n');
 
 				//acquiring indices and values of event variables
@@ -996,114 +998,21 @@ void Missile::plot_index_arrays()
 //
 //010116 Created by Peter H Zipfel
 //011129 Adapted to MISSILE6 simulation, PZi
+//261017 Written from the compiled output plan
 ///////////////////////////////////////////////////////////////////////////////
 void Missile::plot_data(ofstream &fplot,bool merge)
 {
-
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
-	int k(0);
-	int i(0);
-	
-	fplot.setf(ios::left);
-
-	//writing to 'ploti.asc' the variables from the 'Flat6' class
-	for(i=0;i<flat6_plot_count;i++)
-	{
-		index=flat6_plot_ind[i];
-		//checking for integers
-		integer=flat6[index].get_type();
-		vector=flat6[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			//casting integer to real variable
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<(double) flat6[index].integer();			
-			k++;
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=flat6[index].vec();
-
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++; 
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
-			k++;
-		}
-		else
-		{
-			//real variables
-			if(merge&&(index==0))
-				//for merging files, time at last entry must be '-1'
-			{
-				fplot.width(16);
-				fplot<<"-1.0";
-				k++;
-			}
-			else
-			{
-				if(k>4){k=0;fplot<<'\n';}
-				fplot.width(16);
-				fplot<<flat6[index].real(); 
-				k++;
-			}
-		}
-	}
-	//writing to 'ploti.asc' the variables from the 'Missile' class
-	for(i=0;i<missile_plot_count;i++)
+	//compiling the output plan of the 'Flat6' and 'Missile' variables at the first output
+	if(!plot_plan.get_compiled())
 	{
-		index=missile_plot_ind[i];
-		//checking for integers
-		integer=missile[index].get_type();
-		vector=missile[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			//casting integer to real variable
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<(double) missile[index].integer();			
-			k++;
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=missile[index].vec();
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
-			k++;
-		}
-		else
-		{
-			//real variables
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<missile[index].real();
-			k++;
-		}
+		int n=plot_plan.add_array(flat6);
+		for(int i=0;i<flat6_plot_count;i++) plot_plan.add(n,flat6_plot_ind[i]);
+		n=plot_plan.add_array(missile);
+		for(int i=0;i<missile_plot_count;i++) plot_plan.add(n,missile_plot_ind[i]);
 	}
-	fplot<<"\n";
+	//writing to 'ploti.asc' the variables of the plan
+	plot_plan.gather();
+	plot_plan.write(fplot,merge);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Watching for and executing events
@@ -1117,16 +1026,14 @@ void Missile::plot_data(ofstream &fplot,bool merge)
 //010125 Created by Peter H Zipfel
 //011026 Making event_epoch a 'Missile' member for 'stat.asc' file usage, PZi
 //011129 Adapted to MISSILE6 simulation, PZi
+//261017 Pending 'WHEN' events, compiled criteria, located crossings
 ///////////////////////////////////////////////////////////////////////////////
 void Missile::event(char *options)
 {
 	Variable *watch_variable_ptr;
-	double current_value=0;
-	int current_value_int=0;
 	double crit_value=0;
-	int crit_value_int=0;
 	char oper;
-	char *intest=NULL;
+	int e(0);
 	int i(0);
 
 	//initializing event flag ('Missile' member)
@@ -1136,60 +1043,28 @@ void Missile::event(char *options)
 	//or if all events have already occurred
 	if(!event_total)return;
 	
-	//getting watch variable's current value and critical value
-	watch_variable_ptr=event_ptr_list[nevent]->get_variable();
-	crit_value=event_ptr_list[nevent]->get_value();
-
-	//testing for integer
-	intest=watch_variable_ptr->get_type();
-	if(!strcmp(intest,"int"))
-	{
-		current_value_int=watch_variable_ptr->integer();
-		crit_value_int=(int)crit_value;
-	}
-	else
-		current_value=watch_variable_ptr->real();
-
-	//getting relational operator
-	oper=event_ptr_list[nevent]->get_operator();
-
-	//checking if event occurred
-	if(oper=='<')
-	{
-		if(!strcmp(intest,"int"))
-		{
-			if(current_value_int<crit_value_int)
-				event_epoch=true;
-		}
-		else
-		{
-			if(current_value<crit_value)
-				event_epoch=true;
-		}
-	}
-	else if(oper=='=')
-	{
-		if(!strcmp(intest,"int"))
-		{
-			if(current_value_int==crit_value_int)
-				event_epoch=true;
-		}
-		else
-		{
-			if(current_value==crit_value)event_epoch=true;
-		}
-	}
-	else if(oper=='>')
+	//testing the next 'IF' event in sequence and all pending 'WHEN' events
+	//the first criterion satisfied fires; the others are tested nevertheless
+	// to keep their previous values current for locating crossings
+	bool locate=strstr(options,"y_crossing")!=NULL;
+	bool sequence=true;
+	for(int n=0;n<event_total;n++)
 	{
-		if(!strcmp(intest,"int"))
+		if(event_ptr_list[n]->get_occurred()) continue;
+		if(!event_ptr_list[n]->get_pending())
 		{
-			if(current_value_int>crit_value_int)
-				event_epoch=true;
+			if(!sequence) continue;
+			sequence=false;
 		}
-		else
+		double lag(0);
+		if(event_ptr_list[n]->test(locate,lag)&&!event_epoch)
 		{
-			if(current_value>crit_value)
-				event_epoch=true;
+			event_epoch=true;
+			e=n;
+			event_lag=lag;
+			watch_variable_ptr=event_ptr_list[e]->get_variable();
+			crit_value=event_ptr_list[e]->get_value();
+			oper=event_ptr_list[e]->get_operator();
 		}
 	}
 
@@ -1207,13 +1082,13 @@ void Missile::event(char *options)
 		double value;
 		int value_int;
 
-		flat6_index_list=event_ptr_list[nevent]->get_flat6_indices();
-		flat6_value_list=event_ptr_list[nevent]->get_flat6_values();
-		flat6_size=event_ptr_list[nevent]->get_flat6_size();
+		flat6_index_list=event_ptr_list[e]->get_flat6_indices();
+		flat6_value_list=event_ptr_list[e]->get_flat6_values();
+		flat6_size=event_ptr_list[e]->get_flat6_size();
 
-		missile_index_list=event_ptr_list[nevent]->get_missile_indices();
-		missile_value_list=event_ptr_list[nevent]->get_missile_values();
-		missile_size=event_ptr_list[nevent]->get_missile_size();
+		missile_index_list=event_ptr_list[e]->get_missile_indices();
+		missile_value_list=event_ptr_list[e]->get_missile_values();
+		missile_size=event_ptr_list[e]->get_missile_size();
 
 		for(i=0;i<flat6_size;i++)
 		{
@@ -1247,10 +1122,11 @@ void Missile::event(char *options)
 		char *name=watch_variable_ptr->get_name();
 		if(strstr(options,"y_events"))
 		{
-			cout<<" *** Event #"<<nevent+1<<'\t'<<missile6_name<<'\t'<<"time = "<<time
+			cout<<" *** Event #"<<e+1<<'\t'<<missile6_name<<'\t'<<"time = "<<time
 				<<"\tsec;  criteria:  "<<name<<" "<<oper<<" "<<crit_value<<"\t***\n";
 		}
-		//increment event number
+		//marking the event, counting the events occurred
+		event_ptr_list[e]->set_occurred();
 		nevent++;
 		//reset 'event_total' to zero after last event has occured
 		if(nevent==event_total)event_total=0;	
@@ -1449,6 +1325,7 @@ Packet Missile::loading_packet_init(int num_missile,int num_aircraft,int num_tar
 //
 //010206 Created by Peter H Zipfel
 //011129 Adapted to MISSILE6 simulation, PZi
+//261017 Values refreshed only, metadata loaded by 'loading_packet_init()'
 ///////////////////////////////////////////////////////////////////////////////
 Packet Missile::loading_packet(int num_missile,int num_aircraft,int num_target)
 {
@@ -1468,12 +1345,12 @@ Packet Missile::loading_packet(int num_missile,int num_aircraft,int num_target)
 	for(i=0;i<flat6_com_count;i++)
 	{
 		index=flat6_com_ind[i];
-		com_missile6[i]=flat6[index];
+		com_missile6[i].copy_value(flat6[index]);
 	}
 	for(int j=0;j<missile_com_count;j++)
 	{
 		index=missile_com_ind[j];
-		com_missile6[i+j]=missile[index];
+		com_missile6[i+j].copy_value(missile[index]);
 	}
 	//refreshing the packet
 //	packet.set_id(id);
@@ -1538,105 +1415,26 @@ void Missile::markov_noise(double time,double int_step,int nmonte)
 //
 //011029 Created by Peter H Zipfel
 //011129 Adapted to MISSILE6 simulation, PZi
+//261017 Written from the compiled output plan
 ///////////////////////////////////////////////////////////////////////////////
 void Missile::stat_data(ofstream &fstat,int nmc,int vehicle_slot)
 {
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
-	int k(0);
-	int i(0);
-	
-	fstat.setf(ios::left);
-
-	//writing to 'stati.asc' the variables from the 'Flat6' class
-	for(i=0;i<flat6_plot_count;i++)
+	//compiling the output plan of the 'Flat6' and 'Missile' variables at the first output
+	if(!stat_plan.get_compiled())
 	{
-		index=flat6_plot_ind[i];
-		//checking for integers
-		integer=flat6[index].get_type();
-		vector=flat6[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			//casting integer to real variable
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<(double) flat6[index].integer();			
-			k++;
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=flat6[index].vec();
-
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(0,0);
-			k++; 
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(2,0);
-			k++;
-		}
-		else
-		{
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<flat6[index].real(); 
-			k++;
-		}
+		int n=stat_plan.add_array(flat6);
+		for(int i=0;i<flat6_plot_count;i++) stat_plan.add(n,flat6_plot_ind[i]);
+		n=stat_plan.add_array(missile);
+		for(int i=0;i<missile_plot_count;i++) stat_plan.add(n,missile_plot_ind[i]);
+		stat_plan.add_tag();
+		stat_plan.add_tag();
 	}
-	//writing to 'stati.asc' the variables from the 'Missile' class
-	for(i=0;i<missile_plot_count;i++)
-	{
-		index=missile_plot_ind[i];
-		//checking for integers
-		integer=missile[index].get_type();
-		vector=missile[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			//casting integer to real variable
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<(double) missile[index].integer();			
-			k++;
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=missile[index].vec();
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(0,0);
-			k++;
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(2,0);
-			k++;
-		}
-		else
-		{
-			//real variables
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<missile[index].real();
-			k++;
-		}
-	}
-	fstat.width(16);fstat<<nmc+1;
-	fstat.width(16);fstat<<vehicle_slot+1;
-
-	fstat<<"\n";
+	//writing to 'stati.asc' the variables of the plan and the identification integers |MC#||object#|
+	double *row=stat_plan.gather();
+	int ncolumn=stat_plan.get_ncolumn();
+	row[ncolumn-2]=nmc+1;
+	row[ncolumn-1]=vehicle_slot+1;
+	stat_plan.write(fstat,false);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Reading tables from table decks
@@ -1655,6 +1453,7 @@ void Missile::stat_data(ofstream &fstat,int nmc,int vehicle_slot)
 //030721 Created by Peter H Zipfel
 //031104 Corrected table diagnostic, PZi
 //060505 Corrected line 1742 (changed 'else if' to 'if'), TPo
+//261017 Tables shared with vehicles reading the same file
 ///////////////////////////////////////////////////////////////////////////////
 void Missile::read_tables(char *file_name,Datadeck &datatable)
 {
@@ -1669,6 +1468,9 @@ void Missile::read_tables(char *file_name,Datadeck &datatable)
 	int var_dim[3]={1,1,1,};
 	int tt(0);
 
+	//taking the tables of another vehicle that has read the file already
+	if(datatable.share(file_name)) return;
+
 	//opening aero-deck file stream
 	ifstream tbl_stream(file_name);
 
@@ -1788,6 +1590,9 @@ void Missile::read_tables(char *file_name,Datadeck &datatable)
 		
 	}//end of 'for' loop, finished loading all tables
 
+	//offering the tables to vehicles reading the same file
+	datatable.keep(file_name);
+
 	/*/////////////////////// DIAGNOSTICS //////////////////////////////////////
 	//Diagnostic display of tables on console
 	int num_tables=datatable.get_capacity();
@@ -171,22 +171,15 @@ void Missile::sensor(Packet *combus,int num_vehicles,double sim_time,double int_
 	//-------------------------------------------------------------------------
 
 	//downloading from 'combus' target variables
-	//building target id = t(j+1)
-	char number[4];	
-	sprintf(number,"%i",tgt_num);
-	string target_id="t"+string(number);
-	//finding slot 'i' of target in 'combus' (same as in 'vehicle_list')
-	for(int i=0;i<num_vehicles;i++)
-	{
-		string id=combus[i].get_id();
-		if (id==target_id)
-		{						
-			//downloading data from target packet
-			tgt_com_slot=i;
-			data_t=combus[i].get_data();
-			STEL=data_t[2].vec();
-			VTEL=data_t[3].vec();
-		}
+	//slot 'i' of target 't'tgt_num in 'combus' (same as in 'vehicle_list')
+	int i=packet_slot('t',tgt_num);
+	if(i>=0)
+	{						
+		//downloading data from target packet
+		tgt_com_slot=i;
+		data_t=combus[i].get_data();
+		STEL=data_t[2].vec();
+		VTEL=data_t[3].vec();
 	}
 	//IIR gimbaled sensor
 	//target aspect angles
@@ -409,6 +409,7 @@ Packet Target::loading_packet_init(int num_missile,int num_aircraft,int num_targ
 //uses C-code 'sprintf' function to convert 'int' to 'char'
 //
 //010207 Created by Peter H Zipfel
+//261017 Values refreshed only, metadata loaded by 'loading_packet_init()'
 ///////////////////////////////////////////////////////////////////////////////
 Packet Target::loading_packet(int num_missile,int num_aircraft,int num_target)
 {
@@ -428,12 +429,12 @@ Packet Target::loading_packet(int num_missile,int num_aircraft,int num_target)
 	for(i=0;i<flat3_com_count;i++)
 	{
 		index=flat3_com_ind[i];
-		com_target3[i]=flat3[index];
+		com_target3[i].copy_value(flat3[index]);
 	}
 	for(int j=0;j<target_com_count;j++)
 	{
 		index=target_com_ind[j];
-		com_target3[i+j]=target[index];
+		com_target3[i+j].copy_value(target[index]);
 	}
 	//refreshing the packet
 	packet.set_data(com_target3);
@@ -561,6 +562,7 @@ void Target::document(ostream &fdoc,char *title,Document *doc_target3)
 //031104 Corrected table diagnostic, PZi
 //060505 Corrected line 1742 (changed 'else if' to 'if'), TPo
 //070419 Included here in target_functions.cpp', PZi
+//261017 Tables shared with vehicles reading the same file
 ///////////////////////////////////////////////////////////////////////////////
 void Target::read_tables(char *file_name,Datadeck &datatable)
 {
@@ -574,6 +576,9 @@ void Target::read_tables(char *file_name,Datadeck &datatable)
 	int var_dim[3]={1,1,1,};
 	int tt(0);
 
+	//taking the tables of another vehicle that has read the file already
+	if(datatable.share(file_name)) return;
+
 	//opening aero-deck file stream
 	ifstream tbl_stream(file_name);
 
@@ -689,4 +694,7 @@ void Target::read_tables(char *file_name,Datadeck &datatable)
 		tbl_stream>>temp; //reading next DIM entry
 		
 	}//end of 'for' loop, finished loading all tables
+
+	//offering the tables to vehicles reading the same file
+	datatable.keep(file_name);
 }
\ No newline at end of file
@@ -383,8 +383,8 @@ void Aim::vehicle_data(fstream &input)
 
 				read_tables(file_name,proptable);
 			}
-			//reading events into 'Event' pointer array 'event_ptr_list' of size NEVENT
-			if(!strcmp(read,"IF"))
+			//reading events ('IF' in sequence, 'WHEN' pending) into 'Event' pointer array 'event_ptr_list' of size NEVENT
+			if(!strcmp(read,"IF")||!strcmp(read,"WHEN"))
 			{
 				event_total++;
 				//reading name of watch variable
@@ -409,6 +409,8 @@ void Aim::vehicle_data(fstream &input)
 				event_ptr_list[e]->set_variable(variable);
 				event_ptr_list[e]->set_value(value);
 				event_ptr_list[e]->set_operator(oper);
+				event_ptr_list[e]->set_pending(!strcmp(read,"WHEN"));
+				event_ptr_list[e]->compile();
 				input.getline(line_clear,CHARL,'\n');
 
 				//acquiring indices and values of event variables
@@ -818,114 +820,21 @@ void Aim::plot_index_arrays()
 //
 //010116 Created by Peter H Zipfel
 //011129 Adapted to AIM5 simulation, PZi
+//261017 Written from the compiled output plan
 ///////////////////////////////////////////////////////////////////////////////
 void Aim::plot_data(ofstream &fplot,bool merge)
 {
-
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
-	int k(0);
-	int i(0);
-	
-	fplot.setf(ios::left);
-
-	//writing to 'ploti.asc' the variables from the 'Flat3' class
-	for(i=0;i<flat3_plot_count;i++)
-	{
-		index=flat3_plot_ind[i];
-		//checking for integers
-		integer=flat3[index].get_type();
-		vector=flat3[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			//casting integer to real variable
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<(double) flat3[index].integer();			
-			k++;
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=flat3[index].vec();
-
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++; 
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
-			k++;
-		}
-		else
-		{
-			//real variables
-			if(merge&&(index==0))
-				//for merging files, time at last entry must be '-1'
-			{
-				fplot.width(16);
-				fplot<<"-1.0";
-				k++;
-			}
-			else
-			{
-				if(k>4){k=0;fplot<<'\n';}
-				fplot.width(16);
-				fplot<<flat3[index].real(); 
-				k++;
-			}
-		}
-	}
-	//writing to 'ploti.asc' the variables from the 'Aim' class
-	for(i=0;i<aim_plot_count;i++)
+	//compiling the output plan of the 'Flat3' and 'Aim' variables at the first output
+	if(!plot_plan.get_compiled())
 	{
-		index=aim_plot_ind[i];
-		//checking for integers
-		integer=aim[index].get_type();
-		vector=aim[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			//casting integer to real variable
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<(double) aim[index].integer();			
-			k++;
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=aim[index].vec();
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
-			k++;
-		}
-		else
-		{
-			//real variables
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<aim[index].real();
-			k++;
-		}
+		int n=plot_plan.add_array(flat3);
+		for(int i=0;i<flat3_plot_count;i++) plot_plan.add(n,flat3_plot_ind[i]);
+		n=plot_plan.add_array(aim);
+		for(int i=0;i<aim_plot_count;i++) plot_plan.add(n,aim_plot_ind[i]);
 	}
-	fplot<<"\n";
+	//writing to 'ploti.asc' the variables of the plan
+	plot_plan.gather();
+	plot_plan.write(fplot,merge);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Watching for and executing events
@@ -939,16 +848,14 @@ void Aim::plot_data(ofstream &fplot,bool merge)
 //010125 Created by Peter H Zipfel
 //011026 Making event_epoch a 'Aim' member for 'stat.asc' file usage, PZi
 //011129 Adapted to AIM5 simulation, PZi
+//261017 Pending 'WHEN' events, compiled criteria, located crossings
 ///////////////////////////////////////////////////////////////////////////////
 void Aim::event(char *options)
 {
 	Variable *watch_variable_ptr;
-	double current_value=0;
-	int current_value_int=0;
 	double crit_value=0;
-	int crit_value_int=0;
 	char oper;
-	char *intest=NULL;
+	int e(0);
 	int i(0);
 
 	//initializing event flag ('Aim' member)
@@ -958,60 +865,28 @@ void Aim::event(char *options)
 	//or if all events have already occurred
 	if(!event_total)return;
 	
-	//getting watch variable's current value and critical value
-	watch_variable_ptr=event_ptr_list[nevent]->get_variable();
-	crit_value=event_ptr_list[nevent]->get_value();
-
-	//testing for integer
-	intest=watch_variable_ptr->get_type();
-	if(!strcmp(intest,"int"))
-	{
-		current_value_int=watch_variable_ptr->integer();
-		crit_value_int=(int)crit_value;
-	}
-	else
-		current_value=watch_variable_ptr->real();
-
-	//getting relational operator
-	oper=event_ptr_list[nevent]->get_operator();
-
-	//checking if event occurred
-	if(oper=='<')
+	//testing the next 'IF' event in sequence and all pending 'WHEN' events
+	//the first criterion satisfied fires; the others are tested nevertheless
+	// to keep their previous values current for locating crossings
+	bool locate=strstr(options,"y_crossing")!=NULL;
+	bool sequence=true;
+	for(int n=0;n<event_total;n++)
 	{
-		if(!strcmp(intest,"int"))
+		if(event_ptr_list[n]->get_occurred()) continue;
+		if(!event_ptr_list[n]->get_pending())
 		{
-			if(current_value_int<crit_value_int)
-				event_epoch=true;
+			if(!sequence) continue;
+			sequence=false;
 		}
-		else
+		double lag(0);
+		if(event_ptr_list[n]->test(locate,lag)&&!event_epoch)
 		{
-			if(current_value<crit_value)
-				event_epoch=true;
-		}
-	}
-	else if(oper=='=')
-	{
-		if(!strcmp(intest,"int"))
-		{
-			if(current_value_int==crit_value_int)
-				event_epoch=true;
-		}
-		else
-		{
-			if(current_value==crit_value)event_epoch=true;
-		}
-	}
-	else if(oper=='>')
-	{
-		if(!strcmp(intest,"int"))
-		{
-			if(current_value_int>crit_value_int)
-				event_epoch=true;
-		}
-		else
-		{
-			if(current_value>crit_value)
-				event_epoch=true;
+			event_epoch=true;
+			e=n;
+			event_lag=lag;
+			watch_variable_ptr=event_ptr_list[e]->get_variable();
+			crit_value=event_ptr_list[e]->get_value();
+			oper=event_ptr_list[e]->get_operator();
 		}
 	}
 
@@ -1029,13 +904,13 @@ void Aim::event(char *options)
 		double value;
 		int value_int;
 
-		flat3_index_list=event_ptr_list[nevent]->get_flat3_indices();
-		flat3_value_list=event_ptr_list[nevent]->get_flat3_values();
-		flat3_size=event_ptr_list[nevent]->get_flat3_size();
+		flat3_index_list=event_ptr_list[e]->get_flat3_indices();
+		flat3_value_list=event_ptr_list[e]->get_flat3_values();
+		flat3_size=event_ptr_list[e]->get_flat3_size();
 
-		aim_index_list=event_ptr_list[nevent]->get_aim_indices();
-		aim_value_list=event_ptr_list[nevent]->get_aim_values();
-		aim_size=event_ptr_list[nevent]->get_aim_size();
+		aim_index_list=event_ptr_list[e]->get_aim_indices();
+		aim_value_list=event_ptr_list[e]->get_aim_values();
+		aim_size=event_ptr_list[e]->get_aim_size();
 
 		for(i=0;i<flat3_size;i++)
 		{
@@ -1069,10 +944,11 @@ void Aim::event(char *options)
 		char *name=watch_variable_ptr->get_name();
 		if(strstr(options,"y_events"))
 		{
-			cout<<" *** Event #"<<nevent+1<<'\t'<<aim5_name<<'\t'<<"time = "<<time
+			cout<<" *** Event #"<<e+1<<'\t'<<aim5_name<<'\t'<<"time = "<<time
 				<<"\tsec;  criteria:  "<<name<<" "<<oper<<" "<<crit_value<<"\t***\n";
 		}
-		//increment event number
+		//marking the event, counting the events occurred
+		event_ptr_list[e]->set_occurred();
 		nevent++;
 		//reset 'event_total' to zero after last event has occured
 		if(nevent==event_total)event_total=0;	
@@ -1271,6 +1147,7 @@ Packet Aim::loading_packet_init(int num_aim,int num_aircraft)
 //
 //010206 Created by Peter H Zipfel
 //011129 Adapted to AIM5 simulation, PZi
+//261017 Values refreshed only, metadata loaded by 'loading_packet_init()'
 ///////////////////////////////////////////////////////////////////////////////
 Packet Aim::loading_packet(int num_aim,int num_aircraft)
 {
@@ -1281,12 +1158,12 @@ Packet Aim::loading_packet(int num_aim,int num_aircraft)
 	for(i=0;i<flat3_com_count;i++)
 	{
 		index=flat3_com_ind[i];
-		com_aim5[i]=flat3[index];
+		com_aim5[i].copy_value(flat3[index]);
 	}
 	for(int j=0;j<aim_com_count;j++)
 	{
 		index=aim_com_ind[j];
-		com_aim5[i+j]=aim[index];
+		com_aim5[i+j].copy_value(aim[index]);
 	}
 	//refreshing the packet
 	packet.set_data(com_aim5);
@@ -1311,6 +1188,7 @@ Packet Aim::loading_packet(int num_aim,int num_aircraft)
 //030721 Created by Peter H Zipfel
 //031104 Corrected table diagnostic, PZi
 //060505 Corrected line 1742 (changed 'else if' to 'if'), TPo
+//261017 Tables shared with vehicles reading the same file
 ///////////////////////////////////////////////////////////////////////////////
 void Aim::read_tables(char *file_name,Datadeck &datatable)
 {
@@ -1325,6 +1203,9 @@ void Aim::read_tables(char *file_name,Datadeck &datatable)
 	int var_dim[3]={1,1,1,};
 	int tt(0);
 
+	//taking the tables of another vehicle that has read the file already
+	if(datatable.share(file_name)) return;
+
 	//opening aero-deck file stream
 	ifstream tbl_stream(file_name);
 
@@ -1444,6 +1325,9 @@ void Aim::read_tables(char *file_name,Datadeck &datatable)
 		
 	}//end of 'for' loop, finished loading all tables
 
+	//offering the tables to vehicles reading the same file
+	datatable.keep(file_name);
+
 	/*/////////////////////// DIAGNOSTICS //////////////////////////////////////
 	//Diagnostic display of tables on console
 	int num_tables=datatable.get_capacity();
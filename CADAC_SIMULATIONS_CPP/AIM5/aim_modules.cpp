@@ -298,26 +298,18 @@ void Aim::seeker(Packet *combus,int num_vehicles,double sim_time,double int_step
 	Matrix VAEL=flat3[27].vec();
 	//-------------------------------------------------------------------------
 	//downloading from 'combus' target aircraft variables 
-	//building aim id = t(j+1)
-	int i(0);
-	char number[4];
-	sprintf(number,"%i",tgt_num);
-	string aircraft_id="a"+string(number);
-	//finding slot 'i' of aircraft in 'combus' (same as in vehicle_list)
-	for(i=0;i<num_vehicles;i++)
-	{
-		string id=combus[i].get_id();
-		if (id==aircraft_id)
-		{						
-			//downloading data from aircraft packet
-			data_t=combus[i].get_data();
-			STEL=data_t[2].vec();
-			VTEL=data_t[3].vec();
-			psivlx_acft=data_t[4].real();
-			thtvlx_acft=data_t[5].real();
-			//save aircraft com slot
-			acft_com_slot=i;
-		}
+	//slot 'i' of aircraft 'a'tgt_num in 'combus' (same as in vehicle_list)
+	int i=packet_slot('a',tgt_num);
+	if(i>=0)
+	{						
+		//downloading data from aircraft packet
+		data_t=combus[i].get_data();
+		STEL=data_t[2].vec();
+		VTEL=data_t[3].vec();
+		psivlx_acft=data_t[4].real();
+		thtvlx_acft=data_t[5].real();
+		//save aircraft com slot
+		acft_com_slot=i;
 	}
 	if(mseek){
 		//LOS kinematics of target aircraft  wrt missile
@@ -83,23 +83,16 @@ void Aircraft::guidance(Packet *combus,int num_vehicles)
 	//escape maneuver from red missile
 	if(acft_option==2){
 		//downloading from 'combus' red missile states
-		int i(0);
-		char number[4];	
 		Matrix STEL(3,1);
 		Matrix VTEL(3,1);
-		//building target id = t(j+1); first red missile is used
-		sprintf(number,"%i",1);
-		string target_id="t"+string(number);
-		//finding slot 'i' of target in 'combus' (same as in vehicle_list)
-		for(i=0;i<num_vehicles;i++){
-			string id=combus[i].get_id();
-			if (id==target_id){
-				//downloading data from target packet
-				tgt_com_slot=i;
-				data_t=combus[i].get_data();
-				STEL=data_t[1].vec();
-				VTEL=data_t[2].vec();
-			}
+		//slot 'i' of the first red missile 't1' in 'combus' (same as in vehicle_list)
+		int i=packet_slot('t',1);
+		if(i>=0){
+			//downloading data from target packet
+			tgt_com_slot=i;
+			data_t=combus[i].get_data();
+			STEL=data_t[1].vec();
+			VTEL=data_t[2].vec();
 		}
 		//distance to missile
 		Matrix SATL(3,1);
@@ -48,14 +48,18 @@ public:
 	//time elapsed in event 
 	double event_time;
 
+	//fraction of the integration step elapsed since the located event
+	double event_lag;
+
 	virtual~Cadac(){};
 
 	///////////////////////////////////////////////////////////////////////////
 	//Constructor of class 'Cadac'
 	//
 	//010703 Created by Peter H Zipfel
+	//261017 Zeroing 'event_lag'
 	///////////////////////////////////////////////////////////////////////////
-	Cadac(){}
+	Cadac():event_lag(0){}
 
 	///////////////////////////////////////////////////////////////////////////
 	//Setting vehicle object name
@@ -240,6 +244,9 @@ protected:
 	//be written to the 'ploti.asc' files
 	int *aim_plot_ind; int aim_plot_count;
 
+	//compiled output plan of the 'ploti.asc' files
+	Output_plan plot_plan;
+
 	//indicator array pointing to the module-variable which are to 
 	//be written to 'combus' 'packets'
 	int *aim_com_ind; int aim_com_count;
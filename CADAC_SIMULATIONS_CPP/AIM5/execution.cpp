@@ -10,6 +10,7 @@
 //081010 Modified for GENSIM6, PZi
 //130724 Building AIM5, PZi
 //131025 Compatible with MS C++ V12, PZi
+//261017 Vehicles stepped concurrently on a two-phase 'combus' frame
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "class_hierarchy.hpp"
@@ -34,7 +35,7 @@ void number_modules(fstream &input,int &num);
 void order_modules(fstream &input,int &num,Module *module_list);
 
 //acquiring the number of vehicle objects
-void number_objects(fstream &input,int &num_vehicles,int &num_aim,int &num_aircraft);
+void number_objects(fstream &input,int &num_vehicles,int &num_aim,int &num_aircraft,int &nthread);
 
 //creating a type of vehicle object
 Cadac *set_obj_type(fstream &input,Module *module_list,int num_modules,
@@ -45,8 +46,31 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			 double end_time,int num_vehicles,int num_modules,double plot_step,
 			 double int_step,double scrn_step,double com_step,double traj_step,char *options,
 			 ofstream &ftabout,ofstream *plot_ostream_list,Packet *combus,int *status,
-			 int num_aim,int num_aircraft,ofstream &ftraj,char *title,bool traj_merge);
+			 int num_aim,int num_aircraft,ofstream &ftraj,char *title,bool traj_merge,int nthread);
 
+//executing the modules of a vehicle
+void execute_modules(Cadac *vehicle,Module *module_list,int num_modules,double sim_time,double int_step,
+					 Packet *combus,int num_vehicles,int vehicle_slot,char *title);
+
+//time step of a vehicle on the two-phase frame of 'combus', executed by 'Vehicle_pool'
+struct Frame_step:public Vehicle_step
+{
+	Vehicle *vehicle_list;
+	Module *module_list;
+	int num_modules;
+	int num_vehicles;
+	double sim_time;
+	double int_step;
+	char *options;
+	char *title;
+	Packet *combus;    //'combus' of the previous step, read-only but for 'set_status()'
+	int *status;       //status of the vehicles at the previous step
+	int num_aim;
+	int num_aircraft;
+	Combus_frame *frame;
+
+	void step(int i);
+};
 
 // saving status of 'combus' vehicle objects
 void combus_status(Packet *combus,int *status,int num_vehicles);
@@ -55,9 +79,6 @@ void combus_status(Packet *combus,int *status,int num_vehicles);
 void acquire_timing(fstream &input,double &plot_step,double &scn_step,double &com_step,
 					double &traj_step,double &int_step);
 
-//merging the 'ploti.asc' files onto 'plot.asc' 
-void merge_plot_files(string *plot_file_list,int num_aim,char *title);
-
 //writing 'combus' data on screen
 void comscrn_data(Packet *combus,int num_vehicles);
 
@@ -97,6 +118,7 @@ int main()
 	int num_vehicles; //total number of vehicle objects
 	int num_aim; //number of aim objects
 	int num_aircraft; //number of aircraft objects
+	int nthread; //number of threads stepping the vehicles, see 'Vehicle_pool'
 	Cadac *vehicle_type=NULL; //array of vehicle object pointers
 	char vehicle_name[CHARN]; //name of each vehicle type
 	double end_time; //run termination time from 'input.asc'
@@ -106,6 +128,8 @@ int main()
 					//in same sequence as 'vehicle_list'
 	int *status=NULL; //array containing status of each vehicle object
 	bool one_traj_banner=true; //write just one banner on file 'traj.asc'
+	Output_writer writer; //binary output of the plot, stat and traj files, option 'y_binary'
+	Result_store plot_store; //plot data of all objects on 'plot.asc', option 'y_merge'
 	Document *doc_aim5=NULL;  //array for documenting AIM5 module-variables of 'input.asc'
 	Document *doc_aircraft3=NULL;  //array for documenting AIRCRAFT3 module-variables of 'input.asc'
 	bool document_aim5=false; //true if doc_aim5 was created
@@ -147,6 +171,20 @@ int main()
 	//aqcuiring title statement and option selections
 	acquire_title_options(input,title,options);
 
+	//binary output of the plot and traj files, 'y_binary' on the OPTIONS line
+	if(strstr(options,"y_binary"))
+	{
+		writer.start();
+		if(strstr(options,"y_traj"))
+		{
+			ftraj.close();
+			remove("CADAC_SIMULATIONS/AIM5/traj.asc");
+			ftraj.open("CADAC_SIMULATIONS/AIM5/traj.bin",ios::binary);
+			if(!ftraj){cout<<" *** Error: cannot open 'traj.bin' file *** \n";exit(1);}
+			writer.attach(ftraj);
+		}
+	}
+
 	//acquiring number of module 
 	number_modules(input,num_modules);
 
@@ -161,7 +199,7 @@ int main()
 	acquire_timing(input,plot_step,scrn_step,int_step,com_step,traj_step);
 
 	//acquiring number of vehicle objects from 'input.asc'
-	number_objects(input,num_vehicles,num_aim,num_aircraft);
+	number_objects(input,num_vehicles,num_aim,num_aircraft,nthread);
 
 	//creating the 'vehicle_list' object
 	// at this point the constructor 'Vehicle' is called and memory is allocated
@@ -171,6 +209,13 @@ int main()
 	try{plot_ostream_list=new ofstream[num_vehicles];}
 	catch(bad_alloc xa){cerr<<"*** Allocation failure of 'plot_ostream_list' *** \n";return 1;}
 
+	//collecting the rows of all objects on 'plot.asc', option 'y_merge'
+	if(strstr(options,"y_merge")&&strstr(options,"y_plot")&&!strstr(options,"y_binary"))
+	{
+		plot_store.open("CADAC_SIMULATIONS/AIM5/plot.asc","CADAC_SIMULATIONS/AIM5/plot.idx");
+		plot_store.attach(plot_ostream_list,num_vehicles);
+	}
+
 	//allocating memory for 'ploti.asc' files
 	try{plot_file_list=new string[num_vehicles];}
 	catch(bad_alloc xa){cerr<<"*** Allocation failure of 'plot_file_list' *** \n";return 1;}
@@ -213,12 +258,15 @@ int main()
 		//executing initialization computations -MOD		
 		for (int j=0;j<num_modules;j++)
 		{
-			if((module_list[j].name=="kinematics")&&(module_list[j].initialization=="init"))
-				vehicle_list[i]->init_kinematics(sim_time);
-			else if((module_list[j].name=="control")&&(module_list[j].initialization=="init"))
-				vehicle_list[i]->init_control();
-			else if((module_list[j].name=="newton")&&(module_list[j].initialization=="init"))
-				vehicle_list[i]->init_newton();
+			if(module_list[j].init)
+				switch(module_list[j].id){
+				case MOD_KINEMATICS:
+					vehicle_list[i]->init_kinematics(sim_time);break;
+				case MOD_CONTROL:
+					vehicle_list[i]->init_control();break;
+				case MOD_NEWTON:
+					vehicle_list[i]->init_newton();break;
+				}
 		}
 		//writing banner to screen and file 'tabout.asc'
 		if(!strcmp(vehicle_name,"AIM5")&&one_screen_banner)
@@ -255,15 +303,24 @@ int main()
 
 				//building names for plot files
 				sprintf(index,"%i",i+1);
-				plotiasc="CADAC_SIMULATIONS/AIM5/plot"+string(index)+".asc"; //using Standard Library string constructor
+				plotiasc="CADAC_SIMULATIONS/AIM5/plot"+string(index)+(strstr(options,"y_binary")?".bin":".asc"); //using Standard Library string constructor
 				plot_file_list[i]=plotiasc;
 				name=plotiasc.c_str(); //using string member function to convert to char array 
 
 				//creating output stream list 'plot_ostream_list[i]', each will write on file 'ploti.asc'
-				plot_ostream_list[i].open(name); //'name' must be 'char' type
+				if(strstr(options,"y_binary"))
+				{
+					plot_ostream_list[i].open(name,ios::binary);
+					writer.attach(plot_ostream_list[i]);
+				}
+				else if(!plot_store.get_open())
+					plot_ostream_list[i].open(name); //'name' must be 'char' type
 
 				//writing banner on 'ploti.asc'
-				vehicle_list[i]->plot_banner(plot_ostream_list[i],title);				}
+				vehicle_list[i]->plot_banner(plot_ostream_list[i],title);
+
+				//with option 'y_merge', the banner of the first object heads 'plot.asc'
+				plot_store.write_banner(plot_ostream_list[i],title);				}
 		}
 
 		//composing documentation of 'flat3','aim' and 'aircraft' module-variables
@@ -295,6 +352,9 @@ int main()
 
 	} //end of initialization of vehicle object loop
 
+	//resolving the 'combus' slots of the packet ids for the modules reading other packets
+	resolve_packet_slots(combus,num_vehicles);
+
 	//writing 'combus' data to screen at time=0, after module initialization			
 	if(strstr(options,"y_comscrn"))
 	{
@@ -328,7 +388,10 @@ int main()
 				end_time,num_vehicles,num_modules,plot_step,
 				int_step,scrn_step,com_step,traj_step,options,
 				ftabout,plot_ostream_list,combus,status,
-				num_aim,num_aircraft,ftraj,title,traj_merge);
+				num_aim,num_aircraft,ftraj,title,traj_merge,nthread);
+
+	//appending the rows to 'plot.asc', option 'y_merge'
+	plot_store.end_run(0);
 
 	//deallocating dynamic memory
 	delete [] module_list;
@@ -344,16 +407,17 @@ int main()
 	fcopy.close();
 	int f(0);
 
+	//writing the pending binary rows of the plot and traj files
+	writer.sync();
+
+	//closing 'plot.asc', restoring the streams of the objects
+	plot_store.close();
+
 	//Close file streams
 	ftabout.close();
 	for(f=0;f<num_vehicles;f++) plot_ostream_list[f].close();
 	fdoc.close();
 
-	//merging 'ploti.asc' files into 'plot.asc'
-	if(strstr(options,"y_merge")&&strstr(options,"y_plot"))
-	{
-		merge_plot_files(plot_file_list,num_aim,title);
-	}
 	//deallocate dynamic memory
 	delete [] plot_ostream_list;
 	delete [] plot_file_list;
@@ -399,18 +463,23 @@ int main()
 //				&ftraj = output file-stream to 'traj.asc'
 //				*title = idenfication of run
 //				traj_merge = flag for merging MC runs in 'traj.asc'
+//				nthread = number of threads stepping the vehicles on the two-phase frame
+//								of 'combus' (see 'Combus_frame'); =0 vehicles step in sequence
+//								and read 'combus' as it is loaded
 //				  				
 //011128 Created by Peter H Zipfel
 //040705 Calculating 'event_time', PZi
 //070531 Incrementing 'sim_time' in 'combus' until 'ENDTIME' is reached, PZi
 //081010 Modified for GENSIM6, PZi
 //130724 Building AIM5, PZi
+//261017 Module dispatch on 'Module_id' instead of name comparisons
+//261017 Vehicles stepped concurrently on a two-phase 'combus' frame, if 'nthread' is given
 ///////////////////////////////////////////////////////////////////////////////
 void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			 double end_time,int num_vehicles,int num_modules,double plot_step,
 			 double int_step,double scrn_step,double com_step,double traj_step,char *options,
 			 ofstream &ftabout,ofstream *plot_ostream_list,Packet *combus,int *status,
-			 int num_aim,int num_aircraft,ofstream &ftraj,char *title,bool traj_merge)
+			 int num_aim,int num_aircraft,ofstream &ftraj,char *title,bool traj_merge,int nthread)
 {
 	double scrn_time(0);
 	double plot_time(0);
@@ -421,63 +490,89 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 	bool increment_plot_time(false);
 	bool plot_merge(false);
 
+	//two-phase frame of 'combus' and the threads stepping the vehicles on it
+	Combus_frame frame;
+	Vehicle_pool *pool=NULL;
+	vector<int> health_list(num_vehicles);
+	Frame_step frame_step;
+	if(nthread)
+	{
+		frame.init(combus,num_vehicles);
+		pool=new Vehicle_pool(nthread,num_vehicles);
+
+		frame_step.vehicle_list=&vehicle_list;
+		frame_step.module_list=module_list;
+		frame_step.num_modules=num_modules;
+		frame_step.num_vehicles=num_vehicles;
+		frame_step.int_step=int_step;
+		frame_step.options=options;
+		frame_step.title=title;
+		frame_step.combus=combus;
+		frame_step.status=status;
+		frame_step.num_aim=num_aim;
+		frame_step.num_aircraft=num_aircraft;
+		frame_step.frame=&frame;
+	}
+
 	//integration loop
 	while (sim_time<=(end_time+int_step))
 	{
+		if(pool)
+		{
+			//stepping all vehicles on 'combus' of the previous step
+			for(int i=0;i<num_vehicles;i++) health_list[i]=status[i];
+			frame_step.sim_time=sim_time;
+			pool->run(frame_step);
+
+			//collecting the status changes and swapping the published packets into 'combus'
+			combus_status(combus,status,num_vehicles);
+			frame.swap(combus,status);
+		}
+
 		//vehicle loop
 		for (int i=0;i<num_vehicles;i++)
 		{
 			//vehicle is progressing
+			int health(0);
+			if(pool)
+			{
+				//writing the screen messages of the vehicle's step
+				pool->flush(i);
+				health=health_list[i];
+			}
+			else
+			{
+				//slot occupied by current vehicle in 'vehicle_list[]'
+				vehicle_slot=i;
 
-			//slot occupied by current vehicle in 'vehicle_list[]'
-			vehicle_slot=i;
-
-			//watching for the next event			
-			vehicle_list[i]->event(options);
+				//watching for the next event			
+				vehicle_list[i]->event(options);
 
-			//fixing 'event_epoch' and initializing 'event_time'
-			if(vehicle_list[i]->event_epoch)
-				vehicle_list[i]->event_time=0;
+				//fixing 'event_epoch' and initializing 'event_time' at the (located) event
+				//the event's new values took effect at the end of this step, not at the crossing
+				if(vehicle_list[i]->event_epoch)
+					vehicle_list[i]->event_time=vehicle_list[i]->event_lag*int_step;
 
-			//continue only if vehicle is alive (health=1:alive; =-1:hit('aim' only); =0:dead)
-			int health=combus[i].get_status();
-			if(health==1)
-			{
-				//module loop -MOD
-				for(int j=0;j<num_modules;j++)
+				//continue only if vehicle is alive (health=1:alive; =-1:hit('aim' only); =0:dead)
+				health=combus[i].get_status();
+				if(health==1)
 				{
-					if(module_list[j].name=="environment")
-						vehicle_list[i]->environment();
-					else if(module_list[j].name=="kinematics")
-						vehicle_list[i]->kinematics(sim_time,vehicle_list[i]->event_time);
-					else if(module_list[j].name=="newton")
-						vehicle_list[i]->newton(int_step);
-					else if(module_list[j].name=="aerodynamics")
-						vehicle_list[i]->aerodynamics();
-					else if(module_list[j].name=="propulsion")
-						vehicle_list[i]->propulsion();
-					else if(module_list[j].name=="forces")
-						vehicle_list[i]->forces();
-					else if(module_list[j].name=="control") 
-						vehicle_list[i]->control(int_step);
-					else if(module_list[j].name=="guidance")
-						vehicle_list[i]->guidance(combus,num_vehicles);
-					else if(module_list[j].name=="seeker")
-						vehicle_list[i]->seeker(combus,num_vehicles,sim_time,int_step);
-					else if(module_list[j].name=="intercept")
-						vehicle_list[i]->intercept(combus,vehicle_slot,int_step,title);
-				} //end of module loop
-
-				//preserving 'health' status of vehicle objects
-				combus_status(combus,status,num_vehicles);
-
-				//loading data packet into 'combus' communication bus
-				combus[i]=vehicle_list[i]->loading_packet(num_aircraft,num_aim);
-
-				//refreshing 'health' status of vehicle objects
-				combus[i].set_status(status[i]);
+					//module loop -MOD
+					execute_modules(vehicle_list[i],module_list,num_modules,sim_time,int_step,
+									combus,num_vehicles,vehicle_slot,title);
 
+					//preserving 'health' status of vehicle objects
+					combus_status(combus,status,num_vehicles);
 
+					//loading data packet into 'combus' communication bus
+					combus[i]=vehicle_list[i]->loading_packet(num_aircraft,num_aim);
+
+					//refreshing 'health' status of vehicle objects
+					combus[i].set_status(status[i]);
+				}
+			}
+			if(health==1)
+			{
 				//continuing incrementing 'sim_time' in combus packets until 'ENDTIME' is reached
 				combus[i].set_data_variable(0,sim_time);
 
@@ -555,4 +650,72 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 		traj_merge=true;
 		traj_data(ftraj,combus,num_vehicles,traj_merge);
 	}
-} 
\ No newline at end of file
+	delete pool;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Executing the modules of a vehicle in the sequence of 'module_list'
+//
+//Parameters:	*vehicle = vehicle object
+//				vehicle_slot = slot of the vehicle in 'vehicle_list' and 'combus'
+//				others as in 'execute()'
+//
+//261017 Created from 'execute()'
+///////////////////////////////////////////////////////////////////////////////
+void execute_modules(Cadac *vehicle,Module *module_list,int num_modules,double sim_time,double int_step,
+					 Packet *combus,int num_vehicles,int vehicle_slot,char *title)
+{
+	for(int j=0;j<num_modules;j++)
+	{
+		switch(module_list[j].id){
+		case MOD_ENVIRONMENT:
+			vehicle->environment();break;
+		case MOD_KINEMATICS:
+			vehicle->kinematics(sim_time,vehicle->event_time);break;
+		case MOD_NEWTON:
+			vehicle->newton(int_step);break;
+		case MOD_AERODYNAMICS:
+			vehicle->aerodynamics();break;
+		case MOD_PROPULSION:
+			vehicle->propulsion();break;
+		case MOD_FORCES:
+			vehicle->forces();break;
+		case MOD_CONTROL:
+			vehicle->control(int_step);break;
+		case MOD_GUIDANCE:
+			vehicle->guidance(combus,num_vehicles);break;
+		case MOD_SEEKER:
+			vehicle->seeker(combus,num_vehicles,sim_time,int_step);break;
+		case MOD_INTERCEPT:
+			vehicle->intercept(combus,vehicle_slot,int_step,title);break;
+		}
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Time step of a vehicle on the two-phase frame of 'combus', see 'Combus_frame'
+//The vehicle reads 'combus' and 'status' of the previous step and publishes
+// its packet into the back buffer
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Frame_step::step(int i)
+{
+	Cadac *vehicle=(*vehicle_list)[i];
+
+	//watching for the next event			
+	vehicle->event(options);
+
+	//fixing 'event_epoch' and initializing 'event_time' at the (located) event
+	//the event's new values took effect at the end of this step, not at the crossing
+	if(vehicle->event_epoch)
+		vehicle->event_time=vehicle->event_lag*int_step;
+
+	//continue only if vehicle is alive
+	if(status[i]!=1) return;
+
+	//module loop -MOD
+	execute_modules(vehicle,module_list,num_modules,sim_time,int_step,combus,num_vehicles,i,title);
+
+	//publishing data packet for the next step
+	Packet packet=vehicle->loading_packet(num_aircraft,num_aim);
+	frame->publish(i,packet);
+}
\ No newline at end of file
@@ -48,6 +48,7 @@ double const INCH=12;					//conversion factor ft->in
 //sizing of char arrays
 int const CHARN=31;						//character numbers in variable names
 int const CHARL=200;					//character numbers in a line
+int const NOUTPUT_CHUNK=8192;			//values per chunk of binary output, option 'y_binary'
 //verify the following array sizes. If too small, dynamic memory allocation will fail!
 int const NFLAT3=40;					//size of 'flat3' module-variable array 
 int const NAIM=175;						//size of 'target' module-variable array
@@ -10,6 +10,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "class_hierarchy.hpp"
+#include <map>
 
 using namespace std;
 
@@ -96,10 +97,14 @@ void number_modules(fstream &input,int &num)
 //Argument output: *module_list, list of module names in the sequence of 'input.asc' 
 //
 //011128 Created by Peter H Zipfel
+//261017 Resolving 'id', 'init' and 'term' of each module
 ///////////////////////////////////////////////////////////////////////////////
 
 void order_modules(fstream &input,int &num,Module *module_list)
 {	
+	//module names in the sequence of 'Module_id'
+	const char *module_names[]={"","environment","kinematics","newton","aerodynamics","propulsion","forces","control","guidance","seeker","intercept"};
+	int num_names=sizeof(module_names)/sizeof(char *);
 	string temp;
 	char module_type[CHARL];
 	char line_clear[CHARL];
@@ -124,6 +129,13 @@ void order_modules(fstream &input,int &num,Module *module_list)
 		if(strstr(module_type,"init"))module_list[i].initialization="init";
 		if(strstr(module_type,"exec"))module_list[i].execution="exec";
 		if(strstr(module_type,"term"))module_list[i].termination="term";
+
+		//resolving the module name once, for dispatch in the module loops
+		module_list[i].id=MOD_NONE;
+		for(int k=1;k<num_names;k++)
+			if(temp==module_names[k]) module_list[i].id=k;
+		module_list[i].init=(module_list[i].initialization=="init");
+		module_list[i].term=(module_list[i].termination=="term");
 	}
 	input.getline(line_clear,CHARL,'\n');
 }
@@ -171,13 +183,15 @@ void acquire_timing(fstream &input,double &plot_step,double &scrn_step,double &i
 //Parameter output: &num_vehicle, number of vehicles, (call-by-reference)
 //					&num_aim, number of aims					
 //					&num_aircraft, number of aircraft					
+//					&nthread, number of threads stepping the vehicles, optional; =0 if absent
 //
 //010330 Created by Peter H Zipfel
 //020920 Added check for illigal '=' signs and missing numerical entries, PZi
 //070411 Added Aircraft, PZi
+//261017 Optional number of threads on 'VEHICLES' line
 ///////////////////////////////////////////////////////////////////////////////
 
-void number_objects(fstream &input,int &num_vehicles,int &num_aim,int &num_aircraft)
+void number_objects(fstream &input,int &num_vehicles,int &num_aim,int &num_aircraft,int &nthread)
 {
 	char read[CHARN];
 	char line_clear[CHARL];
@@ -192,6 +206,10 @@ void number_objects(fstream &input,int &num_vehicles,int &num_aim,int &num_aircr
 	if (!strcmp(read,"VEHICLES")){
 		input>>num_vehicles;		
 		input.getline(line_clear,CHARL,'\n');
+
+		//optional number of threads, see 'Vehicle_pool'
+		nthread=0;
+		sscanf(line_clear,"%d",&nthread);
 	}
 	else
 		cout<<"*** 'VEHICLES' must follow 'TIMING' ***\n";
@@ -215,7 +233,7 @@ void number_objects(fstream &input,int &num_vehicles,int &num_aim,int &num_aircr
 	int icount=0;
 	while(!input.eof()){
 		input>>read;
-		if(strstr(read,comment)||!strcmp(read,"IF")){
+		if(strstr(read,comment)||!strcmp(read,"IF")||!strcmp(read,"WHEN")){
 			input.getline(line_clear,CHARL,'\n');
 		}
 		else{
@@ -332,84 +350,6 @@ double acquire_endtime(fstream &input)
 	return num;
 }
 
-///////////////////////////////////////////////////////////////////////////////
-//Merging the 'ploti.asc' files onto 'plot.asc' 
-//Compatible witch CADAC Studio plotting
-//
-//010117 Created by Peter H Zipfel
-//011022 Changed treatment of plot_file_list;'num_vehicles'replaced by'num_missile',PZi
-//020304 Correction in first while loop, PZi
-///////////////////////////////////////////////////////////////////////////////
-void merge_plot_files(string *plot_file_list,int num_aim,char *title)
-{	
-	char line_clear[CHARL];
-	char line[CHARL];
-	char buff[CHARN];
-	int num_labels;
-	int num_label_lines;
-	int strip_lines;
-	ifstream *file_istream_list;
-	bool first_time=true;
-	const char *name;
-	int i(0);
-
-	//Allocating memory for 'ploti.asc' file streams
-	file_istream_list=new ifstream[num_aim];
-	if(file_istream_list==0)
-		{cerr<<"*** Error: file_istream_list[] allocation failed *** \n";system("pause");exit(1);}
-
-	ofstream fmerge("CADAC_SIMULATIONS/AIM5/plot.asc");
-
-	for(i=0;i<num_aim;i++)
-	{
-		name=plot_file_list[i].c_str(); //conversion from 'string' to 'char' type
-		file_istream_list[i].open(name);
-	}
-
-	//determining number of lines to be stripped of ploti.asc, i=1,2,3...
-	ifstream fplot1("CADAC_SIMULATIONS/AIM5/plot1.asc");
-	fplot1.getline(line_clear,CHARL,'\n');
-	fplot1>>buff;
-	fplot1>>buff;
-	fplot1>>num_labels;
-	num_label_lines=num_labels/5;
-	if(num_labels%5>0) num_label_lines=num_label_lines+1;
-	strip_lines=num_label_lines+2;
-
-	//copying first file 'plot1.asc' onto 'plot.asc'
-	while(!file_istream_list[0].eof())
-	{
-		file_istream_list[0].getline(line,CHARL,'\n');
-			if(first_time)
-			{
-				first_time=false;
-				fmerge<<"1"<<title<<"  "<< __DATE__ <<" "<< __TIME__;
-			}
-			else
-				//copy only non-blank lines
-				if(file_istream_list[0].gcount()) fmerge<<'\n'<<line;
-	}
-	//copying remaining files onto 'plot.asc'
-	for(i=1;i<num_aim;i++)
-	{
-		//discarding header lines
-		int n=0;
-		for(n=0;n<strip_lines;n++)
-			file_istream_list[i].getline(line_clear,CHARL,'\n');
-
-			//copying data lines
-		while(!file_istream_list[i].eof())
-		{
-			file_istream_list[i].getline(line,CHARL,'\n');
-			//copy only non-blank lines
-			if(file_istream_list[i].gcount()) fmerge<<line<<'\n';
-		}
-	}
-	//closing files and deallocating memory
-	fmerge.close();
-	for(i=0;i<num_aim;i++) file_istream_list[i].close();
-	delete [] file_istream_list;
-}
 ///////////////////////////////////////////////////////////////////////////////
 //Writing out banner of labels to 'traj.asc' from 'combus' module-variable array
 //
@@ -583,6 +523,51 @@ void traj_banner(ofstream &ftraj,Packet *combus,char *title,int num_vehicles,
 		ftraj<<"\n";
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//Slots of the packets in 'combus', by the letter and the number of their id
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+static vector<int> packet_slots[26];
+
+///////////////////////////////////////////////////////////////////////////////
+//Resolving the slots of the packet ids of the form letter and number
+//Called after 'loading_packet_init()'; the slots hold for the whole run
+//
+//Parameter input: *combus, packets loaded by 'loading_packet_init()'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void resolve_packet_slots(Packet *combus,int num_vehicles)
+{
+	for(int k=0;k<26;k++) packet_slots[k].clear();
+	for(int i=0;i<num_vehicles;i++)
+	{
+		string id=combus[i].get_id();
+		if(id.size()<2||id[0]<'a'||id[0]>'z') continue;
+		int number=atoi(id.c_str()+1);
+		char buff[12];
+		sprintf(buff,"%c%i",id[0],number);
+		if(number<1||id!=buff) continue;
+
+		vector<int> &slots=packet_slots[id[0]-'a'];
+		if((int)slots.size()<number) slots.resize(number,-1);
+		slots[number-1]=i;
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Slot of the packet with id 'type''number' in 'combus', -1 if there is none
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+int packet_slot(char type,int number)
+{
+	if(type<'a'||type>'z'||number<1) return -1;
+	vector<int> &slots=packet_slots[type-'a'];
+	if(number>(int)slots.size()) return -1;
+	return slots[number-1];
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //Writing data to 'traj.asc'
 //
@@ -593,150 +578,31 @@ void traj_banner(ofstream &ftraj,Packet *combus,char *title,int num_vehicles,
 //010212 Created by Peter H Zipfel
 //011129 Adapted to Missile6 simulation, PZi
 //071104 Added 'Aircraft', PZi
+//261017 Written from a compiled output plan
 ///////////////////////////////////////////////////////////////////////////////
 
 void traj_data(ofstream &ftraj,Packet *combus,int num_vehicles,bool merge)
 {
+	static Output_plan plan; //compiled at the first call, the packets keep their sequence in 'combus'
 
-	char *integer;
-	char *name;
-	Matrix VEC(3,1);
-	int k(0);
-	Variable *data;
-	int ndata(0);
-	string id;
-	int aim_object(0);
-	int aircraft_object(0);
-	
-	ftraj.setf(ios::left);
-
-	//first data entry is 'time'
-	if(merge)
-	//for merging files, time at last entry must be '-1'
+	//compiling 'time' and the 'combus' data of the 'Aim' and 'Aircraft' objects (without their 'time')
+	if(!plan.get_compiled())
 	{
-		ftraj.width(16);
-		ftraj<<"-1.0";
-		k++;
-	}
-	else
-	{
-		Variable *data_m1=combus[0].get_data();
-		double time=data_m1[0].real();
-		ftraj.width(16);
-		ftraj<<time;
-		k=1;
-	}
-	//writing to 'traj.asc' the 'data' of the vehicle objects in the sequence their 
-	//packets are stored in 'combus' (except for 'time')
-	for(int i=0;i<num_vehicles;i++)
-	{
-		//determining wether 'Aircraft', or 'Aim' object
-		id=combus[i].get_id();
-		aim_object=id.find("m");
-		aircraft_object=id.find("a");
-		if(!aim_object)
-
-		//'Aim' object
+		for(int i=0;i<num_vehicles;i++) plan.add_array(combus[i].get_data());
+		plan.add(0,0);
+		for(int i=0;i<num_vehicles;i++)
 		{
-			data=combus[i].get_data();
-			ndata=combus[i].get_ndata();
-
-			//writing communication variables to 'traj.asc'
-			for(int j=1;j<ndata;j++)
-			{
-				integer=data[j].get_type();
-				name=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
-				{
-					//casting integer to real variable
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<(double) data[j].integer();			
-					k++;
-				}
-				//checking for vectors
-				else if(isupper(name[0]))
-				{
-					VEC=data[j].vec();
-
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(0,0);
-					k++; 
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(1,0);
-					k++;
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(2,0);
-					k++;
-				}
-				//left are real variables
-				else
-				{
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<data[j].real(); 
-					k++;
-				}
-			}
-		}//end of 'Aim' object
-		else if(!aircraft_object)
-
-		//'Aircraft' object
-		{
-			data=combus[i].get_data();
-			ndata=combus[i].get_ndata();
-
-			//writing communication variables to 'traj.asc'
-			for(int j=1;j<ndata;j++)
-			{
-				integer=data[j].get_type();
-				name=data[j].get_name();
-
-				//checking for integer variables
-				if(!strcmp(integer,"int"))
-				{
-					//casting integer to real variable
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<(double) data[j].integer();			
-					k++;
-				}
-				//checking for vectors
-				else if(isupper(name[0]))
-				{
-					VEC=data[j].vec();
-
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(0,0);
-					k++; 
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(1,0);
-					k++;
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<VEC.get_loc(2,0);
-					k++;
-				}
-				//left are real variables
-				else
-				{
-					if(k>4){k=0;ftraj<<'\n';}
-					ftraj.width(16);
-					ftraj<<data[j].real(); 
-					k++;
-				}
-			}
-
-		}//end of 'Aircraft' object
+			string id=combus[i].get_id();
+			if(!id.find("m")||!id.find("a"))
+				for(int j=1;j<combus[i].get_ndata();j++) plan.add(i,j);
+		}
 	}
-	ftraj<<"\n";
+	//the data arrays of the packets are swapped in frame mode
+	for(int i=0;i<num_vehicles;i++) plan.set_array(i,combus[i].get_data());
+
+	//writing to 'traj.asc', the first entry is 'time' of the first packet
+	plan.gather();
+	plan.write(ftraj,merge);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1030,37 +896,28 @@ void combus_status(Packet *combus,int *status,int num_vehicles)
 void Variable::init(char *na,double rv,char *de,char *mo,char *ro,char *ou)
 {
 
-	if(!strcmp(name,"empty")==0) error[0]='*'; //if not 'empty', slot is illigally occupied
-	strcpy(name,na);
+	if(!strcmp(meta->name,"empty")==0) error[0]='*'; //if not 'empty', slot is illigally occupied
+	meta=share(na,meta->type,de,mo,ro,ou);
 	rval=rv;
-	strcpy(def,de);
-	strcpy(mod,mo);
-	strcpy(role,ro);
-	strcpy(out,ou);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Initialization of module-variables of type 'int'
 //
-// privat class member output: name, type, ival, def, mod, role, out
+// privat class member output: meta, ival
 //
 //001128 Created by Peter H Zipfel
 //020909 Added error code handling, PZi
 ///////////////////////////////////////////////////////////////////////////////
 void Variable::init(char *na,char *ty,int iv,char *de,char *mo,char *ro,char *ou)
 {
-	if(!strcmp(name,"empty")==0) error[0]='*';
-	strcpy(name,na);
-	strcpy(type,ty);
+	if(!strcmp(meta->name,"empty")==0) error[0]='*';
+	meta=share(na,ty,de,mo,ro,ou);
 	ival=iv;
-	strcpy(def,de);
-	strcpy(mod,mo);
-	strcpy(role,ro);
-	strcpy(out,ou);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Initialization of module-variables of type 'Matrix' for 3x1 vectors
 //
-//private class member output: name, VEC, def, mod, role, out
+//private class member output: meta, kind, body
 //
 //001128 Created by Peter H Zipfel
 //020909 Added error code handling, PZi
@@ -1068,23 +925,20 @@ void Variable::init(char *na,char *ty,int iv,char *de,char *mo,char *ro,char *ou
 void Variable::init(char *na,double v1,double v2,double v3,char *de,char *mo,char *ro,char *ou)
 {
 	double *pbody;
-	pbody=VEC.get_pbody();
+	pbody=body;
+	kind=KIND_VEC;
 	*pbody=v1;
 	*(pbody+1)=v2;
 	*(pbody+2)=v3;
 
-	if(!strcmp(name,"empty")==0) error[0]='*';
-	strcpy(name,na);
-	strcpy(def,de);
-	strcpy(mod,mo);
-	strcpy(role,ro);
-	strcpy(out,ou);
+	if(!strcmp(meta->name,"empty")==0) error[0]='*';
+	meta=share(na,meta->type,de,mo,ro,ou);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 //Initialization of module-variables of type 'Matrix' for 3x3 matrices
 //
-//private class member output: name, MAT, def, mod, role, out
+//private class member output: meta, kind, body
 //
 //001226 Created by Peter H Zipfel
 //020104 Corrected element assigment errors, PZi
@@ -1095,7 +949,8 @@ void Variable::init(char *na,double v11,double v12,double v13,double v21,double
 					double v31,double v32,double v33,char *de,char *mo,char *ro,char *ou)
 {
 	double *pbody;
-	pbody=MAT.get_pbody();
+	pbody=body;
+	kind=KIND_MAT;
 	*pbody=v11;
 	*(pbody+1)=v12;
 	*(pbody+2)=v13;
@@ -1106,17 +961,13 @@ void Variable::init(char *na,double v11,double v12,double v13,double v21,double
 	*(pbody+7)=v32;
 	*(pbody+8)=v33;
 
-	if(!strcmp(name,"empty")==0) error[0]='*';
-	strcpy(name,na);
-	strcpy(def,de);
-	strcpy(mod,mo);
-	strcpy(role,ro);
-	strcpy(out,ou);
+	if(!strcmp(meta->name,"empty")==0) error[0]='*';
+	meta=share(na,meta->type,de,mo,ro,ou);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Initialization of module-variables of type 'Matrix' for 5x1 vectors
 //
-//private class member output: name, VEC5, def, mod, role, out
+//private class member output: meta, kind, body
 //
 //071101 Created by Peter H Zipfel
 ///////////////////////////////////////////////////////////////////////////////
@@ -1124,25 +975,22 @@ void Variable::init(char *na,double v1,double v2,double v3,double v4,double v5,
 					char *de,char *mo,char *ro,char *ou)
 {
 	double *pbody;
-	pbody=VEC5.get_pbody();
+	pbody=body;
+	kind=KIND_VEC5;
 	*pbody=v1;
 	*(pbody+1)=v2;
 	*(pbody+2)=v3;
 	*(pbody+3)=v4;
 	*(pbody+4)=v5;
 
-//!	if(!strcmp(name,"empty")==0) error[0]='*';
-	strcpy(name,na);
-	strcpy(def,de);
-	strcpy(mod,mo);
-	strcpy(role,ro);
-	strcpy(out,ou);
+//!	if(!strcmp(meta->name,"empty")==0) error[0]='*';
+	meta=share(na,meta->type,de,mo,ro,ou);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 //Initialization of module-variables of type 'Matrix' for 5x5 matrices
 //
-//private class member output: name, MAT5, def, mod, role, out
+//private class member output: meta, kind, body5
 //
 //071101 Created by Peter H Zipfel
 ///////////////////////////////////////////////////////////////////////////////
@@ -1156,19 +1004,97 @@ void Variable::init(char *na,
 					char *de,char *mo,char *ro,char *ou)
 {
 	double *pbody;
-	pbody=MAT5.get_pbody();
+	if(body5==NULL) body5=new double[25];
+	pbody=body5;
+	kind=KIND_MAT5;
 	*pbody=v11;     *(pbody+1)=v12; *(pbody+2)=v13; *(pbody+3)=v14; *(pbody+4)=v15;	
 	*(pbody+5)=v21; *(pbody+6)=v22; *(pbody+7)=v23; *(pbody+8)=v24; *(pbody+9)=v25;
 	*(pbody+10)=v31;*(pbody+11)=v32;*(pbody+12)=v33;*(pbody+13)=v34;*(pbody+14)=v35;
 	*(pbody+15)=v41;*(pbody+16)=v42;*(pbody+17)=v43;*(pbody+18)=v44;*(pbody+19)=v45;
 	*(pbody+20)=v51;*(pbody+21)=v52;*(pbody+22)=v53;*(pbody+23)=v54;*(pbody+24)=v55;
 
-//!	if(!strcmp(name,"empty")==0) error[0]='*';
-	strcpy(name,na);
-	strcpy(def,de);
-	strcpy(mod,mo);
-	strcpy(role,ro);
-	strcpy(out,ou);
+//!	if(!strcmp(meta->name,"empty")==0) error[0]='*';
+	meta=share(na,meta->type,de,mo,ro,ou);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Returning the shared metadata record of a module-variable definition
+//Records are created on first use and kept until the end of the run
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+Variable_meta *Variable::share(char *na,char *ty,char *de,char *mo,char *ro,char *ou)
+{
+	static map<string,Variable_meta> table;
+
+	string key=string(na)+'\n'+ty+'\n'+de+'\n'+mo+'\n'+ro+'\n'+ou;
+	map<string,Variable_meta>::iterator it=table.find(key);
+	if(it==table.end())
+	{
+		Variable_meta record;
+		strcpy(record.name,na);
+		strcpy(record.type,ty);
+		strcpy(record.def,de);
+		strcpy(record.mod,mo);
+		strcpy(record.role,ro);
+		strcpy(record.out,ou);
+		it=table.insert(make_pair(key,record)).first;
+	}
+	return &it->second;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Copying a module-variable, the 5x5 matrix storage is allocated as needed
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+Variable &Variable::operator=(const Variable &var)
+{
+	if(this==&var) return *this;
+
+	meta=var.meta;
+	rval=var.rval;
+	ival=var.ival;
+	kind=var.kind;
+	error[0]=var.error[0];error[1]=var.error[1];
+	for(int i=0;i<9;i++)
+		body[i]=var.body[i];
+	if(var.body5!=NULL)
+	{
+		if(body5==NULL) body5=new double[25];
+		for(int i=0;i<25;i++)
+			body5[i]=var.body5[i];
+	}
+	return *this;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Copying only the value of a module-variable, metadata and error code are kept
+//Only the elements of the stored 'kind' are copied
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Variable::copy_value(const Variable &var)
+{
+	rval=var.rval;
+	ival=var.ival;
+	kind=var.kind;
+	switch(kind)
+	{
+	case KIND_VEC:
+		body[0]=var.body[0];body[1]=var.body[1];body[2]=var.body[2];
+		break;
+	case KIND_MAT:
+		for(int i=0;i<9;i++)
+			body[i]=var.body[i];
+		break;
+	case KIND_VEC5:
+		for(int i=0;i<5;i++)
+			body[i]=var.body[i];
+		break;
+	case KIND_MAT5:
+		if(body5==NULL) body5=new double[25];
+		for(int i=0;i<25;i++)
+			body5[i]=var.body5[i];
+		break;
+	}
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Documenting 'input.asc' with module-variable definitions
@@ -1232,8 +1158,8 @@ void document_input(Document *doc_aim5,Document *doc_aircraft3)
 			//inside AIM5 loop until 'END' is reached
 			do{
 				fcopy>>buffn;
-				//inserting whole line starting with key word IF
-				if(!strcmp(buffn,"IF")){
+				//inserting whole line starting with key word IF or WHEN
+				if(!strcmp(buffn,"IF")||!strcmp(buffn,"WHEN")){
 					input<<"\t\t\t"<<buffn;
 					fcopy.getline(line_clear,CHARL,'\n');
 					input<<line_clear<<endl;
@@ -1313,8 +1239,8 @@ void document_input(Document *doc_aim5,Document *doc_aircraft3)
 			//inside aircraft3 loop until 'END' is reached
 			do{
 				fcopy>>buffn;
-				//inserting whole line starting with key word IF
-				if(!strcmp(buffn,"IF")){
+				//inserting whole line starting with key word IF or WHEN
+				if(!strcmp(buffn,"IF")||!strcmp(buffn,"WHEN")){
 					input<<"\t\t\t"<<buffn;
 					fcopy.getline(line_clear,CHARL,'\n');
 					input<<line_clear<<endl;
@@ -1403,3 +1329,683 @@ void document_input(Document *doc_aim5,Document *doc_aircraft3)
 	input.close();
 	fcopy.close();  
 }
+
+///////////////////////////////////////////////////////////////////////////////
+////////////////// Definitions of 'Combus_frame' member functions /////////////
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+//Taking over the packets of 'combus' after the module initialization
+//The packet data are copied into the two data arrays of each vehicle
+//
+//Parameter input: *combus, packets loaded by 'loading_packet_init()'
+//                 num, number of vehicles
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Combus_frame::init(Packet *combus,int num)
+{
+	num_vehicles=num;
+	try{
+		next=new Packet[num_vehicles];
+		storage=new Variable*[2*num_vehicles];
+		published=new bool[num_vehicles];
+	}
+	catch(bad_alloc xa){cerr<<"*** Allocation failure of 'Combus_frame' *** \n";exit(1);}
+
+	for(int i=0;i<num_vehicles;i++)
+	{
+		int ndata=combus[i].get_ndata();
+		Variable *data=combus[i].get_data();
+		try{
+			storage[2*i]=new Variable[ndata];
+			storage[2*i+1]=new Variable[ndata];
+		}
+		catch(bad_alloc xa){cerr<<"*** Allocation failure of 'Combus_frame' *** \n";exit(1);}
+		for(int k=0;k<ndata;k++){storage[2*i][k]=data[k];storage[2*i+1][k]=data[k];}
+
+		combus[i].set_data(storage[2*i]);
+		next[i]=combus[i];
+		next[i].set_data(storage[2*i+1]);
+		published[i]=false;
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Publishing the packet of vehicle 'i' into the back buffer
+//Called by the thread stepping the vehicle; touches only the vehicle's slot
+//
+//Parameter input: i, slot of the vehicle; &packet, packet of 'loading_packet()'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Combus_frame::publish(int i,Packet &packet)
+{
+	Variable *data=packet.get_data();
+	Variable *back=next[i].get_data();
+	int ndata=packet.get_ndata();
+
+	for(int k=0;k<ndata;k++) back[k].copy_value(data[k]);
+	published[i]=true;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Swapping the published packets into 'combus' at the step boundary
+//Packets of vehicles that did not step remain in 'combus'
+//
+//Parameter input: *status, status of the vehicles after 'combus_status()'
+//Parameter output: *combus
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Combus_frame::swap(Packet *combus,int *status)
+{
+	for(int i=0;i<num_vehicles;i++)
+	{
+		if(!published[i]) continue;
+		Packet front=combus[i];
+		combus[i]=next[i];
+		combus[i].set_status(status[i]);
+		next[i]=front;
+		published[i]=false;
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Releasing the data arrays
+//'combus' must not be read after the frame is destroyed
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+Combus_frame::~Combus_frame()
+{
+	for(int i=0;i<2*num_vehicles;i++) delete [] storage[i];
+	delete [] storage;
+	delete [] next;
+	delete [] published;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+////////////////// Definitions of 'Vehicle_pool' member functions /////////////
+///////////////////////////////////////////////////////////////////////////////
+
+thread_local stringbuf *Pool_console::target=NULL;
+
+///////////////////////////////////////////////////////////////////////////////
+//Starting the helper threads
+//
+//Parameter input: nthread, number of threads including the calling thread
+//                 num_vehicles, number of vehicles
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+Vehicle_pool::Vehicle_pool(int nthread,int num_vehicles)
+	:num(num_vehicles),work(NULL),next(0),busy(0),generation(0),quit(false)
+{
+	for(int i=0;i<num;i++) screens.push_back(new stringbuf);
+	for(int i=1;i<nthread&&i<num;i++) helpers.push_back(thread(&Vehicle_pool::serve,this));
+}
+///////////////////////////////////////////////////////////////////////////////
+//Stopping the helper threads
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+Vehicle_pool::~Vehicle_pool()
+{
+	{
+		lock_guard<mutex> guard(lock);
+		quit=true;
+	}
+	wake.notify_all();
+	for(unsigned i=0;i<helpers.size();i++) helpers[i].join();
+	for(int i=0;i<num;i++){flush(i);delete screens[i];}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Executing 'work.step(i)' for all vehicles
+//The screen is redirected to 'console' until all vehicles are done
+//
+//Parameter input: &step_work, work of the time step
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Vehicle_pool::run(Vehicle_step &step_work)
+{
+	streambuf *screen=cout.rdbuf(&console);
+	{
+		lock_guard<mutex> guard(lock);
+		work=&step_work;
+		next=0;
+		busy=int(helpers.size());
+		generation++;
+	}
+	wake.notify_all();
+	take();
+
+	unique_lock<mutex> guard(lock);
+	while(busy) done.wait(guard);
+	work=NULL;
+	guard.unlock();
+	cout.rdbuf(screen);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Writing the kept screen output of vehicle 'i'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Vehicle_pool::flush(int i)
+{
+	string text=screens[i]->str();
+	if(text.empty()) return;
+	cout<<text;
+	screens[i]->str("");
+}
+///////////////////////////////////////////////////////////////////////////////
+//Stepping vehicles until all are taken
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Vehicle_pool::take()
+{
+	int i;
+	while((i=next++)<num)
+	{
+		Pool_console::target=screens[i];
+		work->step(i);
+	}
+	Pool_console::target=NULL;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Waiting for time steps, in a helper thread
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Vehicle_pool::serve()
+{
+	int served=0;
+	unique_lock<mutex> guard(lock);
+	while(true)
+	{
+		while(!quit&&served==generation) wake.wait(guard);
+		if(quit) return;
+		served=generation;
+		guard.unlock();
+		take();
+		guard.lock();
+		if(!--busy) done.notify_one();
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Adding module-variable 'index' of array 'n' to the output plan
+//Integers are recognized by their type 'int', vectors by the upper case
+// first character of their name
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Output_plan::add(int n,int index)
+{
+	Output_slot slot;
+	slot.array=n;
+	slot.index=index;
+	if(!strcmp(arrays[n][index].get_type(),"int"))
+		slot.kind=SLOT_INT;
+	else if(isupper(arrays[n][index].get_name()[0]))
+		slot.kind=SLOT_VEC;
+	else
+		slot.kind=SLOT_REAL;
+	slots.push_back(slot);
+	row.resize(row.size()+(slot.kind==SLOT_VEC?3:1));
+}
+///////////////////////////////////////////////////////////////////////////////
+//Adding an integer to the output plan, set by the caller in the gathered row
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Output_plan::add_tag()
+{
+	Output_slot slot;
+	slot.array=-1;
+	slot.index=0;
+	slot.kind=SLOT_TAG;
+	slots.push_back(slot);
+	row.resize(row.size()+1);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Gathering the values of the output step into 'row'
+//Integers are cast to real, vectors are componentalized
+//
+//Return output: pointer to 'row', NULL if the plan is empty
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+double *Output_plan::gather()
+{
+	if(row.empty()) return NULL;
+
+	double *value=&row[0];
+	for(unsigned i=0;i<slots.size();i++)
+	{
+		Output_slot &slot=slots[i];
+		switch(slot.kind)
+		{
+		case SLOT_REAL:
+			*value++=arrays[slot.array][slot.index].real();
+			break;
+		case SLOT_INT:
+			*value++=(double) arrays[slot.array][slot.index].integer();
+			break;
+		case SLOT_VEC:
+		{
+			double *vec=arrays[slot.array][slot.index].get_vec();
+			*value++=vec?vec[0]:0;
+			*value++=vec?vec[1]:0;
+			*value++=vec?vec[2]:0;
+			break;
+		}
+		case SLOT_TAG:
+			value++;
+			break;
+		}
+	}
+	return &row[0];
+}
+///////////////////////////////////////////////////////////////////////////////
+//Writing 'row' to 'fout'
+//As text: five accross, data field 16 spaces, tags appended without line break
+//To a stream attached to 'Output_writer': as binary row
+//If 'merge' the first value 'time' is replaced by the marker '-1.0'
+//The rows of 'fout' are counted for 'Result_store'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Output_plan::write(ostream &fout,bool merge)
+{
+	int k(0);
+	int c(0);
+
+	fout.iword(Result_store::rows)++;
+
+	bool marker=merge&&!slots.empty()&&slots[0].kind==SLOT_REAL&&!slots[0].array&&!slots[0].index;
+
+	//binary output
+	Output_chunk *chunk=Output_writer::chunk_of(fout);
+	if(chunk)
+	{
+		if(marker) row[0]=-1;
+		chunk->writer->append(chunk,row.empty()?NULL:&row[0],(int)row.size());
+		return;
+	}
+	//text output
+	fout.setf(ios::left);
+	for(unsigned i=0;i<slots.size();i++)
+	{
+		if(slots[i].kind==SLOT_TAG)
+		{
+			fout.width(16);
+			fout<<(int)row[c++];
+		}
+		else if(!i&&marker)
+		{
+			//for merging files, time at last entry must be '-1'
+			fout.width(16);
+			fout<<"-1.0";
+			c++;
+			k++;
+		}
+		else
+		{
+			int n=(slots[i].kind==SLOT_VEC)?3:1;
+			for(int m=0;m<n;m++)
+			{
+				if(k>4){k=0;fout<<'\n';}
+				fout.width(16);
+				fout<<row[c++];
+				k++;
+			}
+		}
+	}
+	fout<<"\n";
+}
+///////////////////////////////////////////////////////////////////////////////
+//Index of 'ios_base::pword()' holding the chunk of a stream attached to 'Output_writer'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+int Output_writer::slot=ios_base::xalloc();
+///////////////////////////////////////////////////////////////////////////////
+//Stopping the background thread and releasing the chunks
+//The attached streams must not be written afterwards
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+Output_writer::~Output_writer()
+{
+	if(threaded)
+	{
+		{
+			lock_guard<mutex> guard(lock);
+			quit=true;
+		}
+		wake.notify_one();
+		helper.join();
+	}
+	for(unsigned i=0;i<chunks.size();i++) delete chunks[i];
+	for(unsigned i=0;i<queue.size();i++) delete queue[i];
+	for(unsigned i=0;i<spare.size();i++) delete spare[i];
+}
+///////////////////////////////////////////////////////////////////////////////
+//Starting the background thread writing the full chunks
+//Not to be called in a process that forks workers, see 'Monte_carlo'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Output_writer::start()
+{
+	if(threaded) return;
+	threaded=true;
+	helper=thread(&Output_writer::serve,this);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Attaching 'fout' for binary output of 'Output_plan' rows
+//The stream must be opened with 'ios::binary'; the banner written to it
+// afterwards precedes the rows
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Output_writer::attach(ostream &fout)
+{
+	Output_chunk *chunk=NULL;
+	try{chunk=new Output_chunk;}
+	catch(bad_alloc xa){cerr<<"*** Allocation failure of 'Output_chunk' *** \n";exit(1);}
+	chunk->file=&fout;
+	chunk->ncolumn=0;
+	chunk->nrow=0;
+	chunk->writer=this;
+	chunk->values.reserve(NOUTPUT_CHUNK);
+	chunks.push_back(chunk);
+	fout.pword(slot)=chunk;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Appending a row of 'n' values to the stream of 'chunk'
+//A full chunk, or one with rows of another length, is submitted for writing
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Output_writer::append(Output_chunk *chunk,const double *values,int n)
+{
+	if(chunk->nrow&&chunk->ncolumn!=n) submit(chunk);
+
+	chunk->ncolumn=n;
+	chunk->values.insert(chunk->values.end(),values,values+n);
+	chunk->nrow++;
+	if((int)chunk->values.size()>=NOUTPUT_CHUNK) submit(chunk);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Writing all pending rows and waiting until the background thread is idle
+//Called before the attached streams are closed or handed to a worker process
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Output_writer::sync()
+{
+	for(unsigned i=0;i<chunks.size();i++) submit(chunks[i]);
+
+	if(!threaded) return;
+	unique_lock<mutex> guard(lock);
+	while(!queue.empty()||busy) done.wait(guard);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Handing the rows of 'chunk' to the background thread, or writing them directly
+//The values are swapped with a written chunk, so no memory is allocated once
+// the spare chunks exist
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Output_writer::submit(Output_chunk *chunk)
+{
+	if(!chunk->nrow) return;
+
+	if(!threaded)
+	{
+		store(chunk);
+	}
+	else
+	{
+		Output_chunk *full=NULL;
+		{
+			lock_guard<mutex> guard(lock);
+			if(!spare.empty()){full=spare.back();spare.pop_back();}
+		}
+		if(full==NULL)
+		{
+			try{full=new Output_chunk;}
+			catch(bad_alloc xa){cerr<<"*** Allocation failure of 'Output_chunk' *** \n";exit(1);}
+			full->values.reserve(NOUTPUT_CHUNK);
+		}
+		full->file=chunk->file;
+		full->ncolumn=chunk->ncolumn;
+		full->nrow=chunk->nrow;
+		full->writer=this;
+		full->values.swap(chunk->values);
+		{
+			lock_guard<mutex> guard(lock);
+			queue.push_back(full);
+		}
+		wake.notify_one();
+	}
+	chunk->values.clear();
+	chunk->nrow=0;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Writing 'chunk' to its stream: number of rows, number of columns,
+// then the values column by column
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Output_writer::store(Output_chunk *chunk)
+{
+	int size[2]={chunk->nrow,chunk->ncolumn};
+	int nvalue=chunk->nrow*chunk->ncolumn;
+	streambuf *file=chunk->file->rdbuf();
+
+	columns.resize(nvalue);
+	for(int j=0;j<chunk->ncolumn;j++)
+		for(int i=0;i<chunk->nrow;i++)
+			columns[j*chunk->nrow+i]=chunk->values[i*chunk->ncolumn+j];
+
+	file->sputn((char *)size,sizeof(size));
+	if(nvalue) file->sputn((char *)&columns[0],nvalue*sizeof(double));
+}
+///////////////////////////////////////////////////////////////////////////////
+//Background thread writing the queued chunks in sequence
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Output_writer::serve()
+{
+	unique_lock<mutex> guard(lock);
+	while(true)
+	{
+		while(queue.empty()&&!quit) wake.wait(guard);
+		if(queue.empty()) return;
+
+		Output_chunk *full=queue.front();
+		queue.pop_front();
+		busy=true;
+		guard.unlock();
+		store(full);
+		guard.lock();
+		busy=false;
+		full->values.clear();
+		spare.push_back(full);
+		if(queue.empty()) done.notify_all();
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Index of 'ios_base::iword()' counting the rows written by 'Output_plan::write()'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+int Result_store::rows=ios_base::xalloc();
+///////////////////////////////////////////////////////////////////////////////
+//Opening the store file 'name' and the index file 'index_name'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Result_store::open(const char *name,const char *index_name)
+{
+	file.open(name);
+	if(!file){cout<<" *** Error: cannot open '"<<name<<"' file *** \n";exit(1);}
+	index.open(index_name);
+	if(!index){cout<<" *** Error: cannot open '"<<index_name<<"' file *** \n";exit(1);}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Collecting the rows of the 'num_vehicles' streams of 'ostream_list' in memory
+//Must precede 'Monte_carlo::start()', which then collects the rows of each run
+// in its own buffers
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Result_store::attach(ofstream *ostream_list,int num_vehicles)
+{
+	for(int i=0;i<num_vehicles;i++)
+	{
+		stringbuf *buffer=NULL;
+		try{buffer=new stringbuf;}
+		catch(bad_alloc xa){cerr<<"*** Allocation failure of 'Result_store' buffer *** \n";exit(1);}
+		ostream *fout=&ostream_list[i];
+		streams.push_back(fout);
+		files.push_back(fout->rdbuf());
+		buffers.push_back(buffer);
+		fout->rdbuf(buffer);
+		fout->iword(rows)=0;
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Writing the banner collected by 'fout' onto the store file, only once
+//The first line is replaced by the title of the study
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Result_store::write_banner(ostream &fout,char *title)
+{
+	if(!get_open()) return;
+
+	stringbuf *buffer=dynamic_cast<stringbuf *>(fout.rdbuf());
+	if(buffer==NULL) return;
+	string text=buffer->str();
+	buffer->str("");
+	if(banner) return;
+	banner=true;
+
+	ostringstream head;
+	head<<"1"<<title<<"  "<< __DATE__ <<" "<< __TIME__;
+	size_t end=text.find('\n');
+	if(end!=string::npos) head<<text.substr(end);
+	string text_banner=head.str();
+
+	file<<text_banner;
+	index<<"0 0 0 "<<text_banner.size()<<'\n';
+}
+///////////////////////////////////////////////////////////////////////////////
+//Appending the rows of each object as one block of run 'nmc' to the store file,
+// and its line 'run object rows bytes' to the index file
+//The rows are taken from the current buffer of each stream, which is the buffer
+// of 'Monte_carlo' if the run is executed by a worker
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Result_store::end_run(int nmc)
+{
+	if(!get_open()) return;
+
+	for(unsigned i=0;i<streams.size();i++)
+	{
+		stringbuf *buffer=dynamic_cast<stringbuf *>(streams[i]->rdbuf());
+		if(buffer==NULL) continue;
+		string text=buffer->str();
+		if(text.empty()) continue;
+
+		file<<text;
+		index<<nmc+1<<' '<<i+1<<' '<<streams[i]->iword(rows)<<' '<<text.size()<<'\n';
+		buffer->str("");
+		streams[i]->iword(rows)=0;
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Restoring the file buffers of the streams of the objects and closing the files
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Result_store::close()
+{
+	for(unsigned i=0;i<streams.size();i++)
+	{
+		streams[i]->rdbuf(files[i]);
+		delete buffers[i];
+	}
+	streams.clear();
+	files.clear();
+	buffers.clear();
+	if(file.is_open()) file.close();
+	if(index.is_open()) index.close();
+}
+///////////////////////////////////////////////////////////////////////////////
+//Resolving whether the watch variable of the event is an integer
+//Called once the watch variable and the critical value are set
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Event::compile()
+{
+	if(watch_variable_ptr==NULL)
+		{cerr<<" *** Error: watch variable of event not found in 'input.asc' *** \n";exit(1);}
+
+	integer=!strcmp(watch_variable_ptr->get_type(),"int");
+	watch_value_int=(int)watch_value;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Testing the event criterion on the current value of the watch variable
+//Integers are compared as integers, reals as reals
+//If 'locate', a real criterion '<' or '>', which did not hold at the previous
+// test, is located by linear interpolation between the two values
+//The lag corrects 'event_time' only, the new values of the event are loaded at
+// the end of the step, which is not integrated again to the crossing
+//
+//Return output:
+//   true if the criterion holds
+//   lag = fraction of the last integration step elapsed since the crossing,
+//         0 if not located
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+bool Event::test(bool locate,double &lag)
+{
+	bool hold(false);
+	lag=0;
+
+	if(integer)
+	{
+		int value=watch_variable_ptr->integer();
+		switch(event_operator)
+		{
+		case '<': hold=value<watch_value_int;break;
+		case '=': hold=value==watch_value_int;break;
+		case '>': hold=value>watch_value_int;break;
+		}
+		return hold;
+	}
+	double value=watch_variable_ptr->real();
+	switch(event_operator)
+	{
+	case '<': hold=value<watch_value;break;
+	case '=': hold=value==watch_value;break;
+	case '>': hold=value>watch_value;break;
+	}
+	if(locate&&hold&&sampled&&!held&&event_operator!='='&&value!=sample)
+	{
+		lag=(value-watch_value)/(value-sample);
+		if(lag<0) lag=0;
+		if(lag>1) lag=1;
+	}
+	sample=value;
+	sampled=true;
+	held=hold;
+	return hold;
+}
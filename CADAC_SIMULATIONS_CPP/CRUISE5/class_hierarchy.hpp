@@ -53,14 +53,18 @@ public:
 	//time elapsed in event 
 	double event_time; //event_time
 
+	//fraction of the integration step elapsed since the located event
+	double event_lag;
+
 	virtual~Cadac(){};
 
 	///////////////////////////////////////////////////////////////////////////
 	//Constructor of class 'Cadac'
 	//
 	//010703 Created by Peter H Zipfel
+	//261017 Zeroing 'event_lag'
 	///////////////////////////////////////////////////////////////////////////
-	Cadac(){}
+	Cadac():event_lag(0){}
 
 	///////////////////////////////////////////////////////////////////////////
 	//Setting vehicle object name
@@ -249,6 +253,9 @@ protected:
 	// be written to the 'ploti.asc' files
 	int *cruise_plot_ind; int cruise_plot_count;
 
+	//compiled output plan of the 'ploti.asc' files
+	Output_plan plot_plan;
+
 	//indicator array pointing to the module-variable which are to 
 	// be written to 'combus' 'packets'
 	int *cruise_com_ind; int cruise_com_count;
@@ -15,11 +15,20 @@
 
 #include <fstream>
 #include <string>		
+#include <vector>
+#include <sstream>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include "utility_header.hpp"
 
 using namespace std;
 
 
+//module identifiers of the simulation, 'MOD_NONE' for module names not called
+enum Module_id{MOD_NONE,MOD_ENVIRONMENT,MOD_NEWTON,MOD_AERODYNAMICS,MOD_PROPULSION,MOD_FORCES,MOD_SEEKER,MOD_CONTROL,MOD_GUIDANCE,MOD_INTERCEPT,MOD_TARGETING};
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 //Structure 'Module'
@@ -27,6 +36,7 @@ using namespace std;
 //Provides the structure for the modules of the simulation
 //
 //010107 Created by Peter Zipfel
+//261017 Added 'id', 'init' and 'term' resolved once for module dispatch
 ///////////////////////////////////////////////////////////////////////////////
 struct Module
 {
@@ -35,8 +45,32 @@ struct Module
 	string initialization;
 	string execution;
 	string termination;
+	int id;		//'Module_id' resolved from 'name' by 'order_modules()'
+	bool init;	//'initialization' is "init"
+	bool term;	//'termination' is "term"
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//Structure 'Variable_meta'
+//Name, type, definition, module, role and output of a module-variable
+//One record is shared by all variables of the same definition, i.e., by
+// the same slot of the module-variable arrays of all objects of a class
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+struct Variable_meta
+{
+	char name[CHARN]; //label of variable
+	char type[CHARN]; //type of variable 'int'; default is real
+	char def[CHARL];  //definition and units
+	char mod[CHARN];  //module name where variable is calculated
+	char role[CHARN]; //role that variable plays: 'data', 'state', 'diag', 'out'
+	char out[CHARN];  //output for: 'scrn', 'plot', 'com'
 };
 
+//matrix value held by a 'Variable'
+enum Variable_kind{KIND_NONE,KIND_VEC,KIND_MAT};
+
 ///////////////////////////////////////////////////////////////////////////////
 //Class 'Variable'
 //Establishing module-variables as type Variable
@@ -44,34 +78,54 @@ struct Module
 //
 //001125 Created by Peter Zipfel
 //030627 Adapted to CRUISE simulation, PZi
+//261017 Metadata in shared 'Variable_meta' records, compact value storage
 ///////////////////////////////////////////////////////////////////////////////
 
 class Variable 
 {
 private:
-	char name[CHARN]; //label of variable
-	char type[CHARN]; //type of variable 'int'; default is real
+	Variable_meta *meta; //name, type, def, mod, role, out; shared, see 'Variable_meta'
 	double rval;	  //real value
 	int ival;         //integer value
-	Matrix VEC;       //3x1 vector 
-	Matrix MAT;       //3x3 matrix 
-	char def[CHARL];  //definition and units
-	char mod[CHARN];  //module name where variable is calculated
-	char role[CHARN]; //role that variable plays: 'data', 'state', 'diag', 'out'
-	char out[CHARN];  //output for: 'scrn', 'plot', 'com'
+	char kind;        //matrix held in 'body', see 'Variable_kind'
 	char error[2];	  //error code '*' = SAME LOCATION multiple, overwritten definitions
 					  //           'A' = SAME NAME assigned to multiple locations 
+	double body[9];   //3x1 vector or 3x3 matrix
+
+	//copying the matrix value into a new 'Matrix', zero if 'kind' differs
+	Matrix matrix(char kind_wanted,int num_row,int num_col)
+	{
+		Matrix VALUE(num_row,num_col);
+		if(kind!=kind_wanted) return VALUE;
+		double *pbody=VALUE.get_pbody();
+		double *pvalue=body;
+		for(int i=0;i<num_row*num_col;i++)
+			*(pbody+i)=*(pvalue+i);
+		return VALUE;
+	}
+	//storing 'VALUE' as the matrix value of type 'kind_new'
+	void store(char kind_new,int num_row,int num_col,Matrix &VALUE)
+	{
+		if((VALUE.get_rows()!=num_row)||(VALUE.get_cols()!=num_col))
+		{cerr<<" *** Error: incompatible dimensions 'Variable::store()' *** \n";exit(1);}
+
+		kind=kind_new;
+		double *pvalue=body;
+		double *pbody=VALUE.get_pbody();
+		for(int i=0;i<num_row*num_col;i++)
+			*(pvalue+i)=*(pbody+i);
+	}
 public:
 	Variable()
 	{
-		VEC.dimension(3,1);MAT.dimension(3,3);
-		strcpy(name,"empty");
+		meta=share("empty","","","","","");
+		kind=KIND_NONE;
 		error[0]=' ';error[1]='\0';
-		int dum=1;
 	}; 
 	~Variable(){};
 
 	//////////////////////////// Protopypes ///////////////////////////////////////
+static Variable_meta *share(char *na,char *ty,char *de,char *mo,char *ro,char *ou);
 	void init(char *na,double rv,char *de,char *mo,char *ro,char *ou);
 	void init(char *na,char *ty,int iv,char *de,char *mo,char *ro,char *ou);
 	void init(char *na,double v1,double v2,double v3,char *de,char *mo,char *ro,char *ou);
@@ -85,14 +139,14 @@ public:
 	//
 	//001213 Created by Peter Zipfel
 	///////////////////////////////////////////////////////////////////////////
-	char *get_name(){return name;}
+	char *get_name(){return meta->name;}
 	
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining 'type' from module-variable array 
 	//
 	//001213 Created by Peter Zipfel
 	///////////////////////////////////////////////////////////////////////////
-	char *get_type(){return type;}
+	char *get_type(){return meta->type;}
 	
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining value (of type 'double') from module-variable array to local variable
@@ -116,7 +170,15 @@ public:
 	//
 	//001128 Created by Peter Zipfel
 	///////////////////////////////////////////////////////////////////////////
-	Matrix vec(){return VEC;}
+	Matrix vec(){return matrix(KIND_VEC,3,1);}
+	
+	///////////////////////////////////////////////////////////////////////////
+	//Obtaining the 3x1 vector components in place, NULL if no vector is stored
+	//Used by 'Output_plan' for writing vectors without a 'Matrix' copy
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	double *get_vec(){return (kind==KIND_VEC)?body:NULL;}
 	
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining matrix value (of type 'Matrix') from module-variable array to local variable
@@ -124,7 +186,7 @@ public:
 	//
 	//001226 Created by Peter Zipfel
 	///////////////////////////////////////////////////////////////////////////
-	Matrix mat(){return MAT;}
+	Matrix mat(){return matrix(KIND_MAT,3,3);}
 	
 	///////////////////////////////////////////////////////////////////////////
 	//Four-times overloaded function gets()
@@ -147,14 +209,14 @@ public:
 	} 
 	Matrix gets_vec(Matrix VE)
 	{
-		VEC=VE;
-		return VEC;
+		store(KIND_VEC,3,1,VE);
+		return VE;
 	} 
 
 	Matrix gets_mat(Matrix MA)
 	{
-		MAT=MA;
-		return MAT;
+		store(KIND_MAT,3,3,MA);
+		return MA;
 	} 
 
 	///////////////////////////////////////////////////////////////////////////
@@ -162,28 +224,28 @@ public:
 	//
 	//001213 Created by Peter Zipfel
 	///////////////////////////////////////////////////////////////////////////
-	char *get_def(){return def;}
+	char *get_def(){return meta->def;}
 	
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining 'mod' from module-variable array 
 	//
 	//001213 Created by Peter Zipfel
 	///////////////////////////////////////////////////////////////////////////
-	char *get_mod(){return mod;}
+	char *get_mod(){return meta->mod;}
 	
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining 'role' from module-variable array 
 	//
 	//001213 Created by Peter Zipfel
 	///////////////////////////////////////////////////////////////////////////
-	char *get_role(){return role;}
+	char *get_role(){return meta->role;}
 	
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining 'out' from module-variable array 
 	//
 	//001213 Created by Peter Zipfel
 	///////////////////////////////////////////////////////////////////////////
-	char *get_out(){return out;}
+	char *get_out(){return meta->out;}
 
 	///////////////////////////////////////////////////////////////////////////
 	//Obtaining 'error' code from module-variable array 
@@ -209,6 +271,7 @@ public:
 //
 //010119 Created by Peter Zipfel
 //030627 Adapted to CRUISE simulation, PZi
+//261017 Pending events, compiled criteria, located crossings
 ///////////////////////////////////////////////////////////////////////////////
 class Event
 {
@@ -216,6 +279,13 @@ private:
 	Variable *watch_variable_ptr;	//pointer to variable to be watched
 	double watch_value;			//numerical value for comparison (integers will be converted later)
 	char event_operator;		// < , > , =  three options of relational opertors	
+	bool pending;				//'WHEN' event: watched from the start, not in sequence
+	bool occurred;				//event has occurred
+	bool integer;				//watch variable is 'int', resolved by 'compile()'
+	int watch_value_int;		//'watch_value' of an integer watch variable
+	double sample;				//value of a real watch variable at the previous test
+	bool sampled;				//'sample' is set
+	bool held;					//criterion held at the previous test
 	int round3_indices[NVAR];	//new variables to be read from 'round3[]'
 	double round3_values[NVAR];	//new values to be given to variables 
 	int round3_size;				//size (number) of variables from round3 array
@@ -223,7 +293,7 @@ private:
 	double cruise_values[NVAR];	//new values to be given to variables
 	int cruise_size;				//size (number) of variables from cruise array
 public:
-	Event(){};
+	Event():pending(false),occurred(false),integer(false),watch_value_int(0),sample(0),sampled(false),held(false){};
 	~Event(){};
 
 	///////////////////////////////////////////////////////////////////////////
@@ -354,6 +424,48 @@ public:
 	//010123 Created by Peter Zipfel
 	///////////////////////////////////////////////////////////////////////////
 	int get_cruise_size(){return cruise_size;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Setting a 'WHEN' event, watched from the start instead of in sequence
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void set_pending(bool when){pending=when;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Getting whether the event is a 'WHEN' event
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	bool get_pending(){return pending;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Marking the event as occurred
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void set_occurred(){occurred=true;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Getting whether the event has occurred
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	bool get_occurred(){return occurred;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Resolving the type of the watch variable, once the criterion is set
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void compile();
+
+	///////////////////////////////////////////////////////////////////////////
+	//Testing the criterion, optionally locating its crossing in the last step
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	bool test(bool locate,double &lag);
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -535,6 +647,239 @@ public:
 	///////////////////////////////////////////////////////////////////////////
 	void put_mod(char *mo){strcpy(mod,mo);}	
 };
+///////////////////////////////////////////////////////////////////////////////
+//Structure 'Output_slot'
+//Module-variable of a row of 'Output_plan'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+enum Slot_kind{SLOT_REAL,SLOT_INT,SLOT_VEC,SLOT_TAG};
+struct Output_slot
+{
+	int array; //module-variable array, numbered by 'Output_plan::add_array()'
+	int index; //offset of the module-variable in its array
+	int kind;  //'Slot_kind', resolved once from type 'int' and upper case vector names
+};
+///////////////////////////////////////////////////////////////////////////////
+//Class 'Output_plan'
+//Compiled output of module-variables to the plot, stat and traj files
+//Whether a module-variable is an integer, a 3x1 vector or a real is resolved
+// when it is added. Each output step gathers the values into 'row', which is
+// written as text, five accross, or as binary to a stream of 'Output_writer'
+//The first value is replaced by the merge marker '-1.0' if it is module-variable
+// 0 of array 0 ('time')
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+class Output_plan
+{
+private:
+	vector<Variable *> arrays; //module-variable arrays, or data of the 'combus' packets
+	vector<Output_slot> slots; //module-variables in output sequence
+	vector<double> row;        //values of the output step, vectors componentalized
+
+public:
+	///////////////////////////////////////////////////////////////////////////
+	//Adding a module-variable array, returns its number
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	int add_array(Variable *array){arrays.push_back(array);return (int)arrays.size()-1;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Replacing array 'n', e.g. by the current data of a 'combus' packet
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void set_array(int n,Variable *array){arrays[n]=array;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Returning true once module-variables were added
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	bool get_compiled(){return !arrays.empty();}
 
+	///////////////////////////////////////////////////////////////////////////
+	//Returning the number of values of a row
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	int get_ncolumn(){return (int)row.size();}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Adding module-variable 'index' of array 'n'
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void add(int n,int index);
+
+	///////////////////////////////////////////////////////////////////////////
+	//Adding an integer set by the caller, written without line break
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void add_tag();
+
+	///////////////////////////////////////////////////////////////////////////
+	//Gathering the values of the output step, returns 'row'
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	double *gather();
+
+	///////////////////////////////////////////////////////////////////////////
+	//Writing 'row' to 'fout'
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void write(ostream &fout,bool merge);
+};
+class Output_writer;
+///////////////////////////////////////////////////////////////////////////////
+//Structure 'Output_chunk'
+//Rows of a binary output stream, see 'Output_writer'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+struct Output_chunk
+{
+	ostream *file;         //binary output stream
+	int ncolumn;           //values per row
+	int nrow;              //rows in 'values'
+	vector<double> values; //rows in sequence
+	Output_writer *writer; //writer the stream is attached to
+};
+///////////////////////////////////////////////////////////////////////////////
+//Class 'Output_writer'
+//Binary output of the plot, stat and traj files, option 'y_binary'
+//An attached stream receives the banner as in the ASCII file, followed by chunks
+// of rows: 'int' number of rows, 'int' number of columns, then the rows as
+// 'double' values column by column
+//Full chunks are written by a background thread once 'start()' is called;
+// otherwise, as in Monte Carlo worker processes, they are written directly.
+// 'sync()' writes all pending rows and must precede closing the streams.
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+class Output_writer
+{
+private:
+	static int slot;                //'ios_base::pword()' index of the chunk of an attached stream
+	vector<Output_chunk *> chunks;  //chunk being filled, per attached stream
+	deque<Output_chunk *> queue;    //full chunks waiting for 'helper'
+	vector<Output_chunk *> spare;   //written chunks for reuse
+	vector<double> columns;         //values of a chunk, column by column
+	bool threaded;                  //true if 'helper' writes the chunks
+	bool busy;                      //true while 'helper' writes a chunk
+	bool quit;                      //true if 'helper' is to return
+	thread helper;
+	mutex lock;
+	condition_variable wake;        //signals queued chunks or 'quit'
+	condition_variable done;        //signals an empty queue
+
+public:
+	Output_writer():threaded(false),busy(false),quit(false){}
+	~Output_writer();
+
+	///////////////////////////////////////////////////////////////////////////
+	//Returning the chunk of 'fout', NULL if the stream is not attached
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	static Output_chunk *chunk_of(ostream &fout){return (Output_chunk *)fout.pword(slot);}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Starting the background thread
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void start();
+
+	///////////////////////////////////////////////////////////////////////////
+	//Attaching 'fout', opened in binary mode, before its banner is written
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void attach(ostream &fout);
+
+	///////////////////////////////////////////////////////////////////////////
+	//Appending a row of 'n' values to the stream of 'chunk'
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void append(Output_chunk *chunk,const double *values,int n);
+
+	///////////////////////////////////////////////////////////////////////////
+	//Writing all pending rows and waiting for the background thread
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void sync();
+
+private:
+	void submit(Output_chunk *chunk);
+	void store(Output_chunk *chunk);
+	void serve();
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//Class 'Result_store'
+//Plot or stat data of all objects and MC runs streamed onto one file, option 'y_merge'
+//The streams of the objects collect their rows in memory. At the end of each run
+// the rows of each object are appended as one block to the store file ('plot.asc'
+// or 'stat.asc') and the line 'run object rows bytes' to its index file ('plot.idx'
+// or 'stat.idx'). The index starts with the line '0 0 0 bytes' of the banner;
+// a block starts at the sum of the bytes of the preceding index lines.
+//Replaces merging the files of the objects after the study
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+class Result_store
+{
+private:
+	ofstream file;               //banner followed by the blocks of rows
+	ofstream index;              //one line per block
+	vector<ostream *> streams;   //output streams of the objects
+	vector<streambuf *> files;   //buffers of 'streams' writing to their files
+	vector<stringbuf *> buffers; //buffers of 'streams' collecting the rows
+	bool banner;                 //true once the banner is written
+
+public:
+	static int rows; //'ios_base::iword()' index counting the rows written to a stream
+
+	Result_store():banner(false){}
+	~Result_store(){close();}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Returning true if the store file is open
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	bool get_open(){return file.is_open();}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Returning the store and index files, e.g. for output of MC workers
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	ofstream &get_file(){return file;}
+	ofstream &get_index(){return index;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Opening the store file 'name' and the index file 'index_name'
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void open(const char *name,const char *index_name);
+
+	///////////////////////////////////////////////////////////////////////////
+	//Collecting the rows of the 'num_vehicles' streams of 'ostream_list'
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void attach(ofstream *ostream_list,int num_vehicles);
+
+	///////////////////////////////////////////////////////////////////////////
+	//Writing the banner collected by 'fout' once, with the title as first line
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void write_banner(ostream &fout,char *title);
+
+	///////////////////////////////////////////////////////////////////////////
+	//Appending the rows of each object as a block of run 'nmc'
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void end_run(int nmc);
+
+	///////////////////////////////////////////////////////////////////////////
+	//Restoring the streams of the objects and closing the files
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void close();
+};
 
 #endif
@@ -268,42 +268,67 @@ void Plane::aerodynamics()
 	double c2v=refc/(2*dvba);
 	double b2v=refb/(2*dvba);
 
+	//looking up all coefficients of the alpha tables at once
+	static const char *tables_alpha[]={
+		"cxq_vs_alpha","cyr_vs_alpha","cyp_vs_alpha","cz_vs_alpha",
+		"czq_vs_alpha","clr_vs_alpha","clp_vs_alpha","cmq_vs_alpha",
+		"cnr_vs_alpha","cnp_vs_alpha"};
+	double coef_alpha[10];
+	aerotable.look_up(tables_alpha,10,alphax,coef_alpha);
+
+	//looking up all coefficients of the beta, alpha tables at once
+	// (the base moments are tabulated for positive beta, the derivatives for both signs)
+	static const char *tables_beta_alpha[]={
+		"cl_vs_beta_alpha","cn_vs_beta_alpha"};
+	double coef_beta_alpha[2];
+	aerotable.look_up(tables_beta_alpha,2,betax,alphax,coef_beta_alpha);
+	static const char *tables_deriv_beta_alpha[]={
+		"cldr_vs_beta_alpha","clda_vs_beta_alpha","cnda_vs_beta_alpha","cndr_vs_beta_alpha"};
+	double coef_deriv_beta_alpha[4];
+	aerotable.look_up(tables_deriv_beta_alpha,4,betax,alphax,coef_deriv_beta_alpha);
+
+	//looking up all coefficients of the elevator, alpha tables at once
+	static const char *tables_elev_alpha[]={
+		"cx_vs_elev_alpha","cm_vs_elev_alpha"};
+	double coef_elev_alpha[2];
+	aerotable.look_up(tables_elev_alpha,2,delex,alphax,coef_elev_alpha);
+
 	//axial force coefficient
-	double cx=aerotable.look_up("cx_vs_elev_alpha",delex,alphax);
-	double cxq=aerotable.look_up("cxq_vs_alpha",alphax);
+	double cx=coef_elev_alpha[0];
+	double cxq=coef_alpha[0];
 	cxt=cx+c2v*cxq*qqx*RAD;
 
 	//side force coefficient
-	double cyr=aerotable.look_up("cyr_vs_alpha",alphax);
+	double cyr=coef_alpha[1];
 
-	double cyp=aerotable.look_up("cyp_vs_alpha",alphax);
+	double cyp=coef_alpha[2];
 	cyt=-0.02*betax+0.021*delax/20+0.086*delrx/30+b2v*(cyr*rrx*RAD+cyp*ppx*RAD);
 
 	//down force coefficient
-	double cz=aerotable.look_up("cz_vs_alpha",alphax);
-	double czq=aerotable.look_up("czq_vs_alpha",alphax);
+	double cz=coef_alpha[3];
+	double czq=coef_alpha[4];
 	czt=cz*(1-pow(betax*RAD,2))-0.19*delex/25+c2v*czq*qqx*RAD;
 
 	//rolling moment coefficient
-	double cl=aerotable.look_up("cl_vs_beta_alpha",betax,alphax);
-	double cldr=aerotable.look_up("cldr_vs_beta_alpha",betax,alphax);
-	double clda=aerotable.look_up("clda_vs_beta_alpha",betax,alphax);
+	double cl=coef_beta_alpha[0];
+	double cldr=coef_deriv_beta_alpha[0];
+	double clda=coef_deriv_beta_alpha[1];
 	clda=-clda; //see note in header!
-	double clr=aerotable.look_up("clr_vs_alpha",alphax);
-	double clp=aerotable.look_up("clp_vs_alpha",alphax);
+	double clr=coef_alpha[5];
+	double clp=coef_alpha[6];
 	clt=cl+clda*delax/20+cldr*delrx/30+b2v*(cllr*rrx*RAD+clp*ppx*RAD);
 
 	//pitching moment coefficient
-	double cm=aerotable.look_up("cm_vs_elev_alpha",delex,alphax);
-	double cmq=aerotable.look_up("cmq_vs_alpha",alphax);
+	double cm=coef_elev_alpha[1];
+	double cmq=coef_alpha[7];
 	cmt=cm+c2v*cmq*qqx*RAD+czt*(xcgr-xcg)/refc;
 
 	//yawing moment coefficient
-	double cn=aerotable.look_up("cn_vs_beta_alpha",betax,alphax);
-	double cnda=aerotable.look_up("cnda_vs_beta_alpha",betax,alphax);
-	double cndr=aerotable.look_up("cndr_vs_beta_alpha",betax,alphax);
-	double cnr=aerotable.look_up("cnr_vs_alpha",alphax);
-	double cnp=aerotable.look_up("cnp_vs_alpha",alphax);
+	double cn=coef_beta_alpha[1];
+	double cnda=coef_deriv_beta_alpha[2];
+	double cndr=coef_deriv_beta_alpha[3];
+	double cnr=coef_alpha[8];
+	double cnp=coef_alpha[9];
 	cnt=cn+cnda*delax/20+cndr*delrx/30-cyt*(xcgr-xcg)/refb
 		+b2v*(cnr*rrx*RAD+cnp*ppx*RAD);
 
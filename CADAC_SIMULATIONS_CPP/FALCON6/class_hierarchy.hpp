@@ -244,6 +244,9 @@ protected:
 	//be written to the 'ploti.asc' files
 	int *plane_plot_ind; int plane_plot_count;
 
+	//compiled output plan of the 'ploti.asc' files
+	Output_plan plot_plan;
+
 	//indicator array pointing to the module-variable which are to 
 	//be written to 'combus' 'packets'
 	int *plane_com_ind; int plane_com_count;
@@ -380,8 +380,8 @@ void Plane::vehicle_data(fstream &input)
 				read_tables(file_name,proptable);
 			}
 
-			//reading events into 'Event' pointer array 'event_ptr_list' of size NEVENT
-			if(!strcmp(read,"IF"))
+			//reading events ('IF' in sequence, 'WHEN' pending) into 'Event' pointer array 'event_ptr_list' of size NEVENT
+			if(!strcmp(read,"IF")||!strcmp(read,"WHEN"))
 			{
 				event_total++;
 				//reading name of watch variable
@@ -406,6 +406,8 @@ void Plane::vehicle_data(fstream &input)
 				event_ptr_list[e]->set_variable(variable);
 				event_ptr_list[e]->set_value(value);
 				event_ptr_list[e]->set_operator(oper);
+				event_ptr_list[e]->set_pending(!strcmp(read,"WHEN"));
+				event_ptr_list[e]->compile();
 				input.getline(line_clear,CHARL,'\n');
 
 				//acquiring indices and values of event variables
@@ -812,114 +814,22 @@ void Plane::plot_index_arrays()
 //
 //010116 Created by Peter Zipfel
 //030627 Adapted to PLANE6 simulation, PZi
+//261017 Written from the compiled output plan
 ///////////////////////////////////////////////////////////////////////////////
 
 void Plane::plot_data(ofstream &fplot,bool merge)
 {
-
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
-	int k(0),i(0);
-	
-	fplot.setf(ios::left);
-
-	//writing to 'ploti.asc' the variables from the 'Flat6' class
-	for(i=0;i<flat6_plot_count;i++)
+	//compiling the output plan of the 'Flat6' and 'Plane' variables at the first output
+	if(!plot_plan.get_compiled())
 	{
-		index=flat6_plot_ind[i];
-		//checking for integers
-		integer=flat6[index].get_type();
-		vector=flat6[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			//casting integer to real variable
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<(double) flat6[index].integer();			
-			k++;
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=flat6[index].vec();
-
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++; 
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
-			k++;
-		}
-		else
-		{
-			//real variables
-			if(merge&&(index==0))
-				//for merging files, time at last entry must be '-1'
-			{
-				fplot.width(16);
-				fplot<<"-1.0";
-				k++;
-			}
-			else
-			{
-				if(k>4){k=0;fplot<<'\n';}
-				fplot.width(16);
-				fplot<<flat6[index].real(); 
-				k++;
-			}
-		}
+		int n=plot_plan.add_array(flat6);
+		for(int i=0;i<flat6_plot_count;i++) plot_plan.add(n,flat6_plot_ind[i]);
+		n=plot_plan.add_array(plane);
+		for(int i=0;i<plane_plot_count;i++) plot_plan.add(n,plane_plot_ind[i]);
 	}
-	//writing to 'ploti.asc' the variables from the 'Plane' class
-	for(i=0;i<plane_plot_count;i++)
-	{
-		index=plane_plot_ind[i];
-		//checking for integers
-		integer=plane[index].get_type();
-		vector=plane[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			//casting integer to real variable
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<(double) plane[index].integer();			
-			k++;
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=plane[index].vec();
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
-			k++;
-		}
-		else
-		{
-			//real variables
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<plane[index].real();
-			k++;
-		}
-	}
-	fplot<<"\n";
+	//writing to 'ploti.asc' the variables of the plan
+	plot_plan.gather();
+	plot_plan.write(fplot,merge);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Watching for and executing events
@@ -932,17 +842,15 @@ void Plane::plot_data(ofstream &fplot,bool merge)
 //
 //010125 Created by Peter Zipfel
 //030627 Adapted to PLANE6 simulation, PZi
+//261017 Pending 'WHEN' events, compiled criteria
 ///////////////////////////////////////////////////////////////////////////////
 
 void Plane::event(char *options)
 {
 	Variable *watch_variable_ptr;
-	double current_value=0;
-	int current_value_int=0;
 	double crit_value=0;
-	int crit_value_int=0;
 	char oper;
-	char *intest=NULL;
+	int e(0);
 	int i(0);
 
 	//initializing event flag ('Plane' member)
@@ -952,59 +860,26 @@ void Plane::event(char *options)
 	//or if all events have already occurred
 	if(!event_total)return;
 	
-	//getting watch variable's current value and critical value
-	watch_variable_ptr=event_ptr_list[nevent]->get_variable();
-	crit_value=event_ptr_list[nevent]->get_value();
-
-	//testing for integer
-	intest=watch_variable_ptr->get_type();
-	if(!strcmp(intest,"int"))
-	{
-		current_value_int=watch_variable_ptr->integer();
-		crit_value_int=(int)crit_value;
-	}
-	else
-		current_value=watch_variable_ptr->real();
-	//getting relational operator
-	oper=event_ptr_list[nevent]->get_operator();
-
-	//checking if event occurred
-	if(oper=='<')
-	{
-		if(!strcmp(intest,"int"))
-		{
-			if(current_value_int<crit_value_int)
-				event_epoch=true;
-		}
-		else
-		{
-			if(current_value<crit_value)
-				event_epoch=true;
-		}
-	}
-	else if(oper=='=')
-	{
-		if(!strcmp(intest,"int"))
-		{
-			if(current_value_int==crit_value_int)
-				event_epoch=true;
-		}
-		else
-		{
-			if(current_value==crit_value)event_epoch=true;
-		}
-	}
-	else if(oper=='>')
+	//testing the next 'IF' event in sequence and all pending 'WHEN' events
+	//the first criterion satisfied fires; the others are tested nevertheless
+	// to keep their previous values current for locating crossings
+	bool sequence=true;
+	for(int n=0;n<event_total;n++)
 	{
-		if(!strcmp(intest,"int"))
+		if(event_ptr_list[n]->get_occurred()) continue;
+		if(!event_ptr_list[n]->get_pending())
 		{
-			if(current_value_int>crit_value_int)
-				event_epoch=true;
+			if(!sequence) continue;
+			sequence=false;
 		}
-		else
+		double lag(0);
+		if(event_ptr_list[n]->test(false,lag)&&!event_epoch)
 		{
-			if(current_value>crit_value)
-				event_epoch=true;
+			event_epoch=true;
+			e=n;
+			watch_variable_ptr=event_ptr_list[e]->get_variable();
+			crit_value=event_ptr_list[e]->get_value();
+			oper=event_ptr_list[e]->get_operator();
 		}
 	}
 
@@ -1022,13 +897,13 @@ void Plane::event(char *options)
 		double value;
 		int value_int;
 
-		flat6_index_list=event_ptr_list[nevent]->get_flat6_indices();
-		flat6_value_list=event_ptr_list[nevent]->get_flat6_values();
-		flat6_size=event_ptr_list[nevent]->get_flat6_size();
+		flat6_index_list=event_ptr_list[e]->get_flat6_indices();
+		flat6_value_list=event_ptr_list[e]->get_flat6_values();
+		flat6_size=event_ptr_list[e]->get_flat6_size();
 
-		plane_index_list=event_ptr_list[nevent]->get_plane_indices();
-		plane_value_list=event_ptr_list[nevent]->get_plane_values();
-		plane_size=event_ptr_list[nevent]->get_plane_size();
+		plane_index_list=event_ptr_list[e]->get_plane_indices();
+		plane_value_list=event_ptr_list[e]->get_plane_values();
+		plane_size=event_ptr_list[e]->get_plane_size();
 
 		for(i=0;i<flat6_size;i++)
 		{
@@ -1062,10 +937,11 @@ void Plane::event(char *options)
 		char *name=watch_variable_ptr->get_name();
 		if(strstr(options,"y_events"))
 		{
-			cout<<" *** Event #"<<nevent+1<<'\t'<<plane6_name<<'\t'<<"time = "<<time
+			cout<<" *** Event #"<<e+1<<'\t'<<plane6_name<<'\t'<<"time = "<<time
 				<<"\tsec;  criteria:  "<<name<<" "<<oper<<" "<<crit_value<<"\t***\n";
 		}
-		//increment event number
+		//marking the event, counting the events occurred
+		event_ptr_list[e]->set_occurred();
 		nevent++;
 		//reset 'event_total' to zero after last event has occured
 		if(nevent==event_total)event_total=0;	
@@ -1315,6 +1191,7 @@ Packet Plane::loading_packet(int num_plane)
 // For debugging puposes un-comment the print out provision of the tables below
 //
 //030721 Created by Peter H Zipfel
+//261017 Tables shared with vehicles reading the same file
 ///////////////////////////////////////////////////////////////////////////////
 void Plane::read_tables(char *file_name,Datadeck &datatable)
 {
@@ -1329,6 +1206,9 @@ void Plane::read_tables(char *file_name,Datadeck &datatable)
 	int var_dim[3]={1,1,1,};
 	int tt(0);
 
+	//taking the tables of another vehicle that has read the file already
+	if(datatable.share(file_name)) return;
+
 	//opening data-deck file stream
 	ifstream tbl_stream(file_name);
 
@@ -1448,6 +1328,9 @@ void Plane::read_tables(char *file_name,Datadeck &datatable)
 		
 	}//end of 'for' loop, finished loading all tables
 
+	//offering the tables to vehicles reading the same file
+	datatable.keep(file_name);
+
 	/*/////////////////////// DIAGNOSTICS //////////////////////////////////////
 	//Diagnostic display of tables on console
 	int num_tables=datatable.get_capacity();
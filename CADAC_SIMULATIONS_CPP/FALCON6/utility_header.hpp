@@ -28,6 +28,10 @@
 
 using namespace std;
 
+//Matrices of up to 'MATRIX_INLINE' elements are stored inside the object,
+//larger ones on the heap
+int const MATRIX_INLINE=64;
+
 ///////////////////////////////////////////////////////////////////////////////
 /////////////////////// 'Matrix' member functions /////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -38,6 +42,7 @@ using namespace std;
 // pointer arithmetic
 //
 //020826 Created by Peter H Zipfel
+//261017 Matrices of up to 8x8 stored inside the object, no heap allocation
 ///////////////////////////////////////////////////////////////////////////////
  
 class Matrix
@@ -49,8 +54,12 @@ private:
 	int num_col;
 	//total number of elements
 	int num_elem;
-	//pointer to array
+	//pointer to array, 'body' or heap memory
 	double *pbody;
+	//storage of matrices with up to MATRIX_INLINE elements
+	double body[MATRIX_INLINE];
+	//points 'pbody' at storage for 'num_elem' elements
+	void allocate();
 
 public:
 	//default constructors
@@ -382,8 +382,8 @@ void Cruise::vehicle_data(fstream &input)
 				read_tables(file_name,proptable);
 			}
 
-			//reading events into 'Event' pointer array 'event_ptr_list' of size NEVENT
-			if(!strcmp(read,"IF"))
+			//reading events ('IF' in sequence, 'WHEN' pending) into 'Event' pointer array 'event_ptr_list' of size NEVENT
+			if(!strcmp(read,"IF")||!strcmp(read,"WHEN"))
 			{
 				event_total++;
 				//reading name of watch variable
@@ -409,6 +409,8 @@ void Cruise::vehicle_data(fstream &input)
 				event_ptr_list[e]->set_variable(variable);
 				event_ptr_list[e]->set_value(value);
 				event_ptr_list[e]->set_operator(oper);
+				event_ptr_list[e]->set_pending(!strcmp(read,"WHEN"));
+				event_ptr_list[e]->compile();
 				input.getline(line_clear,CHARL,'\n');
 
 				//acquiring indices and values of event variables
@@ -819,114 +821,22 @@ void Cruise::plot_index_arrays()
 //
 //010116 Created by Peter Zipfel
 //030627 Adapted to CRUISE simulation, PZi
+//261017 Written from the compiled output plan
 ///////////////////////////////////////////////////////////////////////////////
 
 void Cruise::plot_data(ofstream &fplot,bool merge)
 {
-
-	int index;
-	char *integer;
-	char *vector;
-	Matrix VEC(3,1);
-	int k(0);
-	int i(0);
-	
-	fplot.setf(ios::left);
-
-	//writing to 'ploti.asc' the variables from the 'Round3' class
-	for(i=0;i<round3_plot_count;i++)
+	//compiling the output plan of the 'Round3' and 'Cruise' variables at the first output
+	if(!plot_plan.get_compiled())
 	{
-		index=round3_plot_ind[i];
-		//checking for integers
-		integer=round3[index].get_type();
-		vector=round3[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			//casting integer to real variable
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<(double) round3[index].integer();			
-			k++;
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=round3[index].vec();
-
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++; 
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
-			k++;
-		}
-		else
-		{
-			//real variables
-			if(merge&&(!index))
-				//for merging files, time at last entry must be '-1'
-			{
-				fplot.width(16);
-				fplot<<"-1.0";
-				k++;
-			}
-			else
-			{
-				if(k>4){k=0;fplot<<'\n';}
-				fplot.width(16);
-				fplot<<round3[index].real(); 
-				k++;
-			}
-		}
+		int n=plot_plan.add_array(round3);
+		for(int i=0;i<round3_plot_count;i++) plot_plan.add(n,round3_plot_ind[i]);
+		n=plot_plan.add_array(cruise);
+		for(int i=0;i<cruise_plot_count;i++) plot_plan.add(n,cruise_plot_ind[i]);
 	}
-	//writing to 'ploti.asc' the variables from the 'Cruise' class
-	for(i=0;i<cruise_plot_count;i++)
-	{
-		index=cruise_plot_ind[i];
-		//checking for integers
-		integer=cruise[index].get_type();
-		vector=cruise[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			//casting integer to real variable
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<(double) cruise[index].integer();			
-			k++;
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=cruise[index].vec();
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
-			k++;
-		}
-		else
-		{
-			//real variables
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<cruise[index].real();
-			k++;
-		}
-	}
-	fplot<<"\n";
+	//writing to 'ploti.asc' the variables of the plan
+	plot_plan.gather();
+	plot_plan.write(fplot,merge);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Watching for and executing events
@@ -939,17 +849,15 @@ void Cruise::plot_data(ofstream &fplot,bool merge)
 //
 //010125 Created by Peter Zipfel
 //030627 Adapted to CRUISE simulation, PZi
+//261017 Pending 'WHEN' events, compiled criteria, located crossings
 ///////////////////////////////////////////////////////////////////////////////
 
 void Cruise::event(char *options)
 {
 	Variable *watch_variable_ptr;
-	double current_value=0;
-	int current_value_int=0;
 	double crit_value=0;
-	int crit_value_int=0;
 	char oper;
-	char *intest=NULL;
+	int e(0);
 
 	//initializing event flag ('Cruise' member)
 	event_epoch=false;
@@ -958,59 +866,28 @@ void Cruise::event(char *options)
 	//or if all events have already occurred
 	if(!event_total)return;
 	
-	//getting watch variable's current value and critical value
-	watch_variable_ptr=event_ptr_list[nevent]->get_variable();
-	crit_value=event_ptr_list[nevent]->get_value();
-
-	//testing for integer
-	intest=watch_variable_ptr->get_type();
-	if(!strcmp(intest,"int"))
-	{
-		current_value_int=watch_variable_ptr->integer();
-		crit_value_int=(int)crit_value;
-	}
-	else
-		current_value=watch_variable_ptr->real();
-	//getting relational operator
-	oper=event_ptr_list[nevent]->get_operator();
-
-	//checking if event occurred
-	if(oper=='<')
-	{
-		if(!strcmp(intest,"int"))
-		{
-			if(current_value_int<crit_value_int)
-				event_epoch=true;
-		}
-		else
-		{
-			if(current_value<crit_value)
-				event_epoch=true;
-		}
-	}
-	else if(oper=='=')
-	{
-		if(!strcmp(intest,"int"))
-		{
-			if(current_value_int==crit_value_int)
-				event_epoch=true;
-		}
-		else
-		{
-			if(current_value==crit_value)event_epoch=true;
-		}
-	}
-	else if(oper=='>')
+	//testing the next 'IF' event in sequence and all pending 'WHEN' events
+	//the first criterion satisfied fires; the others are tested nevertheless
+	// to keep their previous values current for locating crossings
+	bool locate=strstr(options,"y_crossing")!=NULL;
+	bool sequence=true;
+	for(int n=0;n<event_total;n++)
 	{
-		if(!strcmp(intest,"int"))
+		if(event_ptr_list[n]->get_occurred()) continue;
+		if(!event_ptr_list[n]->get_pending())
 		{
-			if(current_value_int>crit_value_int)
-				event_epoch=true;
+			if(!sequence) continue;
+			sequence=false;
 		}
-		else
+		double lag(0);
+		if(event_ptr_list[n]->test(locate,lag)&&!event_epoch)
 		{
-			if(current_value>crit_value)
-				event_epoch=true;
+			event_epoch=true;
+			e=n;
+			event_lag=lag;
+			watch_variable_ptr=event_ptr_list[e]->get_variable();
+			crit_value=event_ptr_list[e]->get_value();
+			oper=event_ptr_list[e]->get_operator();
 		}
 	}
 
@@ -1029,13 +906,13 @@ void Cruise::event(char *options)
 		int value_int(0);
 		int i(0);
 
-		round3_index_list=event_ptr_list[nevent]->get_round3_indices();
-		round3_value_list=event_ptr_list[nevent]->get_round3_values();
-		round3_size=event_ptr_list[nevent]->get_round3_size();
+		round3_index_list=event_ptr_list[e]->get_round3_indices();
+		round3_value_list=event_ptr_list[e]->get_round3_values();
+		round3_size=event_ptr_list[e]->get_round3_size();
 
-		cruise_index_list=event_ptr_list[nevent]->get_cruise_indices();
-		cruise_value_list=event_ptr_list[nevent]->get_cruise_values();
-		cruise_size=event_ptr_list[nevent]->get_cruise_size();
+		cruise_index_list=event_ptr_list[e]->get_cruise_indices();
+		cruise_value_list=event_ptr_list[e]->get_cruise_values();
+		cruise_size=event_ptr_list[e]->get_cruise_size();
 
 		for(i=0;i<round3_size;i++)
 		{
@@ -1069,10 +946,11 @@ void Cruise::event(char *options)
 		char *name=watch_variable_ptr->get_name();
 		if(strstr(options,"y_events"))
 		{
-			cout<<" *** Event #"<<nevent+1<<'\t'<<cruise3_name<<'\t'<<"time = "<<time
+			cout<<" *** Event #"<<e+1<<'\t'<<cruise3_name<<'\t'<<"time = "<<time
 				<<"\tsec;  criteria:  "<<name<<" "<<oper<<" "<<crit_value<<"\t***\n";
 		}
-		//increment event number
+		//marking the event, counting the events occurred
+		event_ptr_list[e]->set_occurred();
 		nevent++;
 		//reset 'event_total' to zero after last event has occured
 		if(nevent==event_total)event_total=0;	
@@ -1348,6 +1226,7 @@ Packet Cruise::loading_packet(int num_cruise)
 //
 //030721 Created by Peter H Zipfel
 //060426 Corrected line 1401 (replaced 'if else' by 'if'), PZi
+//261017 Tables shared with vehicles reading the same file
 ///////////////////////////////////////////////////////////////////////////////
 void Cruise::read_tables(char *file_name,Datadeck &datatable)
 {
@@ -1362,6 +1241,9 @@ void Cruise::read_tables(char *file_name,Datadeck &datatable)
 	int var_dim[3]={1,1,1,};
 	int tt(0);
 
+	//taking the tables of another vehicle that has read the file already
+	if(datatable.share(file_name)) return;
+
 	//opening data-deck file stream
 	ifstream tbl_stream(file_name);
 
@@ -1482,6 +1364,9 @@ void Cruise::read_tables(char *file_name,Datadeck &datatable)
 		
 	}//end of 'for' loop, finished loading all tables
 
+	//offering the tables to vehicles reading the same file
+	datatable.keep(file_name);
+
 	/*/////////////////////// DIAGNOSTICS //////////////////////////////////////
 	//Diagnostic display of tables on console
 	int num_tables=datatable.get_capacity();
@@ -52,9 +52,6 @@ void combus_status(Packet *combus,int *status,int num_vehicles);
 void acquire_timing(fstream &input,double &plot_step,double &scn_step,double &com_step,
 					double &traj_step,double &int_step);
 
-//merging the 'ploti.asc' files onto 'plot.asc' 
-void merge_plot_files(string *plot_file_list,int num_cruise,char *title);
-
 //writing 'combus' data on screen
 void comscrn_data(Packet *combus,int num_vehicles);
 
@@ -102,6 +99,8 @@ int main(void)
 					//in same sequence as 'vehicle_list'
 	int *status; //array containing status of each vehicle object
 	bool one_traj_banner=true; //write just one banner on file 'traj.asc'
+	Output_writer writer; //binary output of the plot, stat and traj files, option 'y_binary'
+	Result_store plot_store; //plot data of all objects on 'plot.asc', option 'y_merge'
 	Document *doc_cruise3=NULL;  //array for documenting CRUISE3 module-variables of 'input.asc'
 	bool document_cruise3=false; //true if array doc_cruise3 was created
 
@@ -138,6 +137,20 @@ int main(void)
 	//aqcuiring title statement and option selections
 	acquire_title_options(input,title,options);
 
+	//binary output of the plot and traj files, 'y_binary' on the OPTIONS line
+	if(strstr(options,"y_binary"))
+	{
+		writer.start();
+		if(strstr(options,"y_traj"))
+		{
+			ftraj.close();
+			remove("traj.asc");
+			ftraj.open("traj.bin",ios::binary);
+			if(!ftraj){cout<<" *** Error: cannot open 'traj.bin' file *** \n";exit(1);}
+			writer.attach(ftraj);
+		}
+	}
+
 	//acquiring number of module 
 	number_modules(input,num_modules);
 
@@ -162,6 +175,13 @@ int main(void)
 	try {plot_ostream_list=new ofstream[num_vehicles];}		
 	catch(bad_alloc xa){cout<< "*** Allocation failure of 'plot_ostream_list' ***\n";return 1;}
 
+	//collecting the rows of all objects on 'plot.asc', option 'y_merge'
+	if(strstr(options,"y_merge")&&strstr(options,"y_plot")&&!strstr(options,"y_binary"))
+	{
+		plot_store.open("plot.asc","plot.idx");
+		plot_store.attach(plot_ostream_list,num_vehicles);
+	}
+
 	//allocating memory for 'ploti.asc' files, but do it only once
 	try{plot_file_list=new string[num_vehicles];}		
 	catch(bad_alloc xa){cout<< "*** Allocation failure of 'plot_file_list' ***\n";return 1;}
@@ -204,12 +224,15 @@ int main(void)
 		//executing initialization computations -MOD		
 		for (int j=0;j<num_modules;j++)
 		{
-			if((module_list[j].name=="environment")&&(module_list[j].initialization=="init"))
-				vehicle_list[i]->init_environment(sim_time,int_step);
-			else if((module_list[j].name=="propulsion")&&(module_list[j].initialization=="init"))
-				vehicle_list[i]->init_propulsion();
-			else if((module_list[j].name=="newton")&&(module_list[j].initialization=="init"))
-				vehicle_list[i]->init_newton();
+			if(module_list[j].init)
+				switch(module_list[j].id){
+				case MOD_ENVIRONMENT:
+					vehicle_list[i]->init_environment(sim_time,int_step);break;
+				case MOD_PROPULSION:
+					vehicle_list[i]->init_propulsion();break;
+				case MOD_NEWTON:
+					vehicle_list[i]->init_newton();break;
+				}
 		}
 		//writing banner to screen and file 'tabout.asc'
 		if(!strcmp(vehicle_name,"CRUISE3")&&one_screen_banner)
@@ -245,15 +268,24 @@ int main(void)
 
 				//building names for plot files
 				sprintf(index,"%i",i+1);
-				plotiasc="plot"+string(index)+".asc"; //using Standard Library string constructor
+				plotiasc="plot"+string(index)+(strstr(options,"y_binary")?".bin":".asc"); //using Standard Library string constructor
 				plot_file_list[i]=plotiasc;
 				name=plotiasc.c_str(); //using string member function to convert to char array 
 
 				//creating output stream list 'plot_ostream_list[i]', each will write on file 'ploti.asc'
-				plot_ostream_list[i].open(name); //'name' must be 'char' type
+				if(strstr(options,"y_binary"))
+				{
+					plot_ostream_list[i].open(name,ios::binary);
+					writer.attach(plot_ostream_list[i]);
+				}
+				else if(!plot_store.get_open())
+					plot_ostream_list[i].open(name); //'name' must be 'char' type
 
 				//writing banner on 'ploti.asc'
 				vehicle_list[i]->plot_banner(plot_ostream_list[i],title);
+
+				//with option 'y_merge', the banner of the first object heads 'plot.asc'
+				plot_store.write_banner(plot_ostream_list[i],title);
 			}
 		}
 		//composing documentation of 'round3','cruise'  module-variables
@@ -309,6 +341,9 @@ int main(void)
 			 plot_ostream_list,combus,status,num_cruise,ftraj,title,
 			 traj_merge);
 
+	//appending the rows to 'plot.asc', option 'y_merge'
+	plot_store.end_run(0);
+
 	//Deallocate dynamic memory
 	delete [] module_list;
 	delete [] combus;
@@ -322,16 +357,17 @@ int main(void)
 	input.close();
 	fcopy.close();
 
+	//writing the pending binary rows of the plot and traj files
+	writer.sync();
+
+	//closing 'plot.asc', restoring the streams of the objects
+	plot_store.close();
+
 	//Close file streams
 	ftabout.close();
 	for(int f=0;f<num_vehicles;f++) plot_ostream_list[f].close();
 	fdoc.close();
 
-	//merging 'ploti.asc' files into 'plot.asc'
-	if(strstr(options,"y_merge")&&strstr(options,"y_plot"))
-	{
-		merge_plot_files(plot_file_list,num_cruise,title);
-	}
 	//De-allocate dynamic memory
 	delete [] plot_ostream_list;
 	delete [] plot_file_list;
@@ -380,6 +416,7 @@ int main(void)
 //				  				
 //011128 Created by Peter H Zipfel
 //060511 Updated to latest CADAC++ standards, PZi
+//261017 Module dispatch on 'Module_id' instead of name comparisons
 ///////////////////////////////////////////////////////////////////////////////
 void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			 double end_time,int num_vehicles,int num_modules,double plot_step,
@@ -409,9 +446,10 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			//watching for the next event			
 			vehicle_list[i]->event(options);
 
-			//fixing 'event_epoch' and initializing 'event_time'
+			//fixing 'event_epoch' and initializing 'event_time' at the (located) event
+			//the event's new values took effect at the end of this step, not at the crossing
 			if(vehicle_list[i]->event_epoch)
-				vehicle_list[i]->event_time=0;
+				vehicle_list[i]->event_time=vehicle_list[i]->event_lag*int_step;
 
 			//continue only if vehicle is alive (health=1:alive; =-1:hit('target' only); =0:dead)
 			int health=combus[i].get_status();
@@ -420,16 +458,18 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 				//module loop -MOD
 				for(int j=0;j<num_modules;j++)
 				{
-					if(module_list[j].name=="environment")
-						vehicle_list[i]->environment(sim_time,vehicle_list[i]->event_time,int_step,out_fact);
-					else if(module_list[j].name=="newton")
-						vehicle_list[i]->newton(int_step);
-					else if(module_list[j].name=="aerodynamics")
-						vehicle_list[i]->aerodynamics();
-					else if(module_list[j].name=="propulsion")
-						vehicle_list[i]->propulsion(int_step);
-					else if(module_list[j].name=="forces")
-						vehicle_list[i]->forces();
+					switch(module_list[j].id){
+					case MOD_ENVIRONMENT:
+						vehicle_list[i]->environment(sim_time,vehicle_list[i]->event_time,int_step,out_fact);break;
+					case MOD_NEWTON:
+						vehicle_list[i]->newton(int_step);break;
+					case MOD_AERODYNAMICS:
+						vehicle_list[i]->aerodynamics();break;
+					case MOD_PROPULSION:
+						vehicle_list[i]->propulsion(int_step);break;
+					case MOD_FORCES:
+						vehicle_list[i]->forces();break;
+					}
 				} //end of module loop
 
 				//preserving 'health' status of vehicle objects
@@ -29,6 +29,7 @@ double const BIG=1e10;					//big number
 //sizing of arrays
 int const CHARN=40;						//character numbers in variable names
 int const CHARL=150;					//character numbers in a line
+int const NOUTPUT_CHUNK=8192;			//values per chunk of binary output, option 'y_binary'
 //verify the following array sizes. If too small, dynamic memory allocations may fail!
 int const NROUND3=40;					//size of 'round3' module-variable array
 int const NCRUISE=40;					//size of 'cruise' module-variable array 
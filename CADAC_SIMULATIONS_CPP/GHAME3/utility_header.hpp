@@ -33,10 +33,16 @@
 
 #include <iostream>
 #include <cmath>
+#include <vector>
+#include <map>
 #include "global_constants.hpp"
 
 using namespace std;
 
+//Matrices of up to 'MATRIX_INLINE' elements are stored inside the object,
+//larger ones on the heap
+int const MATRIX_INLINE=64;
+
 ///////////////////////////////////////////////////////////////////////////////
 /////////////////////// 'Matrix' member functions /////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -47,6 +53,7 @@ using namespace std;
 // pointer arithmetic
 //
 //020826 Created by Peter H Zipfel
+//261017 Matrices of up to 8x8 stored inside the object, no heap allocation
 ///////////////////////////////////////////////////////////////////////////////
  
 class Matrix
@@ -58,8 +65,12 @@ private:
 	int num_col;
 	//total number of elements
 	int num_elem;
-	//pointer to array
+	//pointer to array, 'body' or heap memory
 	double *pbody;
+	//storage of matrices with up to MATRIX_INLINE elements
+	double body[MATRIX_INLINE];
+	//points 'pbody' at storage for 'num_elem' elements
+	void allocate();
 
 public:
 	//default constructors
@@ -330,6 +341,7 @@ double angle(Matrix VEC1,Matrix VEC2);
 //Stores table data
 //
 //030710 Created by Peter Zipfel
+//261017 Arrays deleted with 'delete []'
 ///////////////////////////////////////////////////////////////////////////////
 class Table 
 {
@@ -348,10 +360,10 @@ public:
 	Table(){}
 	virtual ~Table()
 	{
-		delete var1_values;
-		delete var2_values;
-		delete var3_values;
-		delete data;
+		delete [] var1_values;
+		delete [] var2_values;
+		delete [] var3_values;
+		delete [] data;
 	}
 
 	///////////////////////////////////////////////////////////////////////////
@@ -458,11 +470,67 @@ public:
 	}
 };
 
+///////////////////////////////////////////////////////////////////////////////
+//Structure 'Lookup_site'
+//Table look-up site of a 'Datadeck', one per table slot
+//Holds the brackets found by the last look-up of the table as starting points
+// of the next search
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+struct Lookup_site
+{
+	int slot;         //table slot in 'Datadeck'
+	int loc1;         //last bracket of 1. independent variable
+	int loc2;         //last bracket of 2. independent variable
+	int loc3;         //last bracket of 3. independent variable
+};
+///////////////////////////////////////////////////////////////////////////////
+//Structure 'Lookup_group'
+//Tables of a 'Datadeck' that share their independent variables and breakpoints,
+// identified by the table name array of the call site
+//Table values are interleaved, the 'num' values of a grid point are adjacent,
+// so that one set of brackets and weights serves all tables
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+struct Lookup_group
+{
+	const char **names;   //table name array of the call site
+	int num;              //number of tables
+	int var1_dim;         //variable 1 dimension
+	int var2_dim;         //variable 2 dimension
+	int var3_dim;         //variable 3 dimension
+	double *var1_values;  //values of variable 1, those of the first table
+	double *var2_values;  //values of variable 2, those of the first table
+	double *var3_values;  //values of variable 3, those of the first table
+	vector<double> data;  //table values, grid point by grid point
+	int loc1;             //last bracket of 1. independent variable
+	int loc2;             //last bracket of 2. independent variable
+	int loc3;             //last bracket of 3. independent variable
+};
+///////////////////////////////////////////////////////////////////////////////
+//Structure 'Deck_file'
+//Tables loaded from one deck file, shared by all 'Datadeck' objects that read
+// the same file; the tables are read-only once loaded
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+struct Deck_file
+{
+	string title;      //title of data deck
+	int capacity;      //total number of tables
+	Table **table_ptr; //tables of the file
+	int users;         //number of 'Datadeck' objects using the tables
+};
 ///////////////////////////////////////////////////////////////////////////////
 //Class 'Datadeck'
 //Provides the 'Datadeck' class declaration for table look-ups
 //
 //030710 Created by Peter Zipfel
+//261017 Look-ups of table name literals with cached slots and brackets
+//261017 Batched look-ups of tables sharing their breakpoints
+//261017 Tables shared by all data decks reading the same file
 ///////////////////////////////////////////////////////////////////////////////
 class Datadeck
 {
@@ -471,11 +539,15 @@ private:
 	int capacity; //total number of tables
 	int tbl_counter; //table counter
 	Table **table_ptr; //table_ptr is pointer to a pointer array of type 'Table'
+	vector<Lookup_site> sites; //look-up sites of table name literals, by table slot
+	map<const char *,int> site_slots; //table slots of the name literals seen, by address
+	vector<Lookup_group> groups; //call sites of look-ups of table groups
+	string file; //deck file of shared tables, see 'Deck_file'
 
 public:
 
-	Datadeck(){}
-	virtual ~Datadeck(){ delete [] table_ptr;}
+	Datadeck():table_ptr(0){}
+	virtual ~Datadeck(){release();}
 
 	///////////////////////////////////////////////////////////////////////////////
 	//Allocating memory  for table_ptr array
@@ -559,6 +631,18 @@ public:
 	///////////////////////////////////////////////////////////////////////////////
 	Table * get_tbl(int slot){return table_ptr[slot];}
 
+	///////////////////////////////////////////////////////////////////////////////
+	//Sharing the tables of a deck file, see 'Deck_file'
+	//'share()' takes over the tables if the file was loaded before, returns false otherwise
+	//'keep()' offers the tables just read from the file to later 'Datadeck' objects
+	//'release()' gives up the tables, the last user of a file deletes them
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	bool share(const char *file_name);
+	void keep(const char *file_name);
+	void release();
+
 	///////////////////////////////////////////////////////////////////////////////
 	//Single independent variable look-up
 	//constant extrapolation at the upper end, slope extrapolation at the lower end
@@ -583,6 +667,48 @@ public:
 	///////////////////////////////////////////////////////////////////////////////
 	double look_up(string name,double value1,double value2,double value3);
 
+	///////////////////////////////////////////////////////////////////////////////
+	//Look-ups with the table name as string literal, one, two and three
+	// independent variables
+	//Brackets are kept per table, see 'Lookup_site'
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	double look_up(const char *name,double value1);
+	double look_up(const char *name,double value1,double value2);
+	double look_up(const char *name,double value1,double value2,double value3);
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Finding the look-up site of a table name literal
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	Lookup_site *find_site(const char *name);
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Look-ups of several tables with identical independent variables and
+	// breakpoints, one, two and three independent variables
+	//Brackets and weights are found once, 'values[k]' returns table 'names[k]'
+	//'names' must be a static array, it identifies the call site like a literal
+	//Example:
+	//	static const char *tables[]={"cl_vs_beta_alpha","cn_vs_beta_alpha"};
+	//	double coef[2];
+	//	aerotable.look_up(tables,2,betax,alphax,coef);
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	void look_up(const char **names,int num,double value1,double *values);
+	void look_up(const char **names,int num,double value1,double value2,double *values);
+	void look_up(const char **names,int num,double value1,double value2,double value3,
+				double *values);
+
+	///////////////////////////////////////////////////////////////////////////////
+	//Finding the table group of a name array, created on first call
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	Lookup_group *find_group(const char **names,int num,int dim);
+
 	///////////////////////////////////////////////////////////////////////////////
 	//Table index finder
 	//This is a binary search method it is O(lgN)
@@ -593,6 +719,14 @@ public:
 	///////////////////////////////////////////////////////////////////////////////
 	int find_index(int max,double value,double *list);
 
+	///////////////////////////////////////////////////////////////////////////////
+	//Table index finder starting from the bracket 'loc' of the last call
+	//Returns the same locater as 'find_index()' and updates 'loc'
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////////
+	int hunt_index(int max,double value,double *list,int &loc);
+
 	///////////////////////////////////////////////////////////////////////////////
 	//Linear one-dimensional interpolation
 	// Constant extrapolation beyond max values of X1
@@ -9,6 +9,7 @@
 //030415 Migrated to HYPER simulation, PZi
 //130619 Made compatible with MS C++ 10, PZi
 //131025 Made compatible with MS C++ V12, PZi
+//261017 Monte Carlo runs executed by worker processes
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "class_hierarchy.hpp"
@@ -19,7 +20,7 @@
 
 //acquiring the simmulation title
 void acquire_title_options(fstream &input,char *title,char *options,int &nmonte
-						   ,int &iseed,int &nmc);
+						   ,int &iseed,int &nmc,int &nworker);
 
 //acquiring the simulation run time
 double acquire_endtime(fstream &input);
@@ -52,12 +53,6 @@ void combus_status(Packet *combus,int *status,int num_vehicles);
 void acquire_timing(fstream &input,double &plot_step,double &scn_step,double &com_step,
 					double &traj_step,double &int_step);
 
-//merging the 'ploti.asc' files onto 'plot.asc' 
-void merge_plot_files(string *plot_file_list,int num_hyper,char *title);
-
-//merging the 'stati.asc' files onto 'stat.asc' 
-void merge_stat_files(string *stat_file_list,int num_hyper,char *title);
-
 //writing 'combus' data on screen
 void comscrn_data(Packet *combus,int num_vehicles);
 
@@ -112,7 +107,12 @@ int main()
 	int nmonte=0; //number of MC runs to be executed
 	int nmc=0; //MC counter
 	int iseed; //seeding srand()
+	int nworker=0; //number of worker processes executing the MC runs
+	Monte_carlo mc; //executes the MC runs in worker processes
 	bool one_traj_banner=true; //write just one banner on file 'traj.asc'
+	Output_writer writer; //binary output of the plot, stat and traj files, option 'y_binary'
+	Result_store plot_store; //plot data of all objects and runs on 'plot.asc', option 'y_merge'
+	Result_store stat_store; //stat data of all objects and runs on 'stat.asc', option 'y_merge'
 	bool *stati_write_term=NULL; //flag for writing impact data on 'stati.asc' once
 	Document *doc_hyper6=NULL;  //array for documenting HYPER6 module-variables of 'input.asc'
 	Document *doc_satellite3=NULL;  //array for documenting SAT3 module-variables of 'input.asc'
@@ -159,8 +159,21 @@ int main()
 		bool document_radar=true; //write  to 'doc.asc' radar module-variables only once
 		bool traj_merge=false; //flag used in writing 'time=-1' endblock on 'traj.asc'
 		
+		//seeding the run and collecting its output, if executed by a worker
+		mc.begin_run(nmc);
+
 		//aqcuiring title statement and option selections
-		acquire_title_options(input,title,options,nmonte,iseed,nmc);
+		acquire_title_options(input,title,options,nmonte,iseed,nmc,nworker);
+
+		//binary output of the 'traj' file, 'y_binary' on the OPTIONS line
+		if(!nmc&&strstr(options,"y_binary")&&strstr(options,"y_traj"))
+		{
+			ftraj.close();
+			remove("traj.asc");
+			ftraj.open("traj.bin",ios::binary);
+			if(!ftraj){cout<<" *** Error: cannot open 'traj.bin' file *** \n";exit(1);}
+			writer.attach(ftraj);
+		}
 
 		//initializing random number generator
 		if(!nmc) srand(iseed); 
@@ -219,6 +232,31 @@ int main()
 		//initialize 'stati_write_term' to true
 		for( int jj=0;jj<num_vehicles;jj++) stati_write_term[jj]=true;
 
+		//collecting the rows of all objects and runs on 'plot.asc' and 'stat.asc', option 'y_merge'
+		if(!nmc&&strstr(options,"y_merge")&&!strstr(options,"y_binary"))
+		{
+			if(strstr(options,"y_plot"))
+			{
+				plot_store.open("plot.asc","plot.idx");
+				plot_store.attach(plot_ostream_list,num_vehicles);
+				mc.add_stream(plot_store.get_file());
+				mc.add_stream(plot_store.get_index());
+			}
+			if(strstr(options,"y_stat"))
+			{
+				stat_store.open("stat.asc","stat.idx");
+				stat_store.attach(stat_ostream_list,num_vehicles);
+				mc.add_stream(stat_store.get_file());
+				mc.add_stream(stat_store.get_index());
+			}
+		}
+
+		//starting the workers with the first run, if 'MONTE' gives their number
+		if(!nmc) mc.start(nmonte,nworker,iseed,ftabout,ftraj,plot_ostream_list,stat_ostream_list,num_vehicles);
+
+		//binary chunks written in the background, unless the runs are forked to workers
+		if(!nmc&&strstr(options,"y_binary")&&!mc.get_forking()) writer.start();
+
 		///////////////////////////////////////////////////////////////////////
 		////////////////// Initializing of each vehicle object  ///////////////
 		///////////////////////////////////////////////////////////////////////
@@ -240,26 +278,34 @@ int main()
 			//getting the name of the type of vehicle
 			strcpy(vehicle_name,vehicle_list[i]->get_vname());
 
+			//seeding the noise streams of the vehicle, if the runs are seeded by run number
+			if(mc.get_seeded()) vehicle_list[i]->seed_random(iseed,nmc,i);
+
 			//vehicle data and tables read from 'input.asc' 
+			vehicle_list[i]->set_random_source(RANDOM_INPUT);
 			vehicle_list[i]->vehicle_data(input,nmonte);
 
 			//executing initialization computations -MOD: insert here new module initialization function		
 			for (int j=0;j<num_modules;j++)
 			{
-				if((module_list[j].name=="newton")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_newton();
-				else if((module_list[j].name=="kinematics")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_kinematics(sim_time,int_step);
-				else if((module_list[j].name=="euler")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_euler();
-				else if((module_list[j].name=="environment")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_environment();
-				else if((module_list[j].name=="aerodynamics")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_aerodynamics();
-				else if((module_list[j].name=="propulsion")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_propulsion();
-				else if((module_list[j].name=="ins")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_ins();
+				vehicle_list[i]->set_random_source(module_list[j].id);
+				if(module_list[j].init)
+					switch(module_list[j].id){
+					case MOD_NEWTON:
+						vehicle_list[i]->init_newton();break;
+					case MOD_KINEMATICS:
+						vehicle_list[i]->init_kinematics(sim_time,int_step);break;
+					case MOD_EULER:
+						vehicle_list[i]->init_euler();break;
+					case MOD_ENVIRONMENT:
+						vehicle_list[i]->init_environment();break;
+					case MOD_AERODYNAMICS:
+						vehicle_list[i]->init_aerodynamics();break;
+					case MOD_PROPULSION:
+						vehicle_list[i]->init_propulsion();break;
+					case MOD_INS:
+						vehicle_list[i]->init_ins();break;
+					}
 			}
 			//writing banner to screen and file 'tabout.asc'
 			if(!strcmp(vehicle_name,"HYPER6")&&one_screen_banner)
@@ -299,15 +345,24 @@ int main()
 
 						//building names for plot files
 						sprintf(index,"%i",i+1);
-						plotiasc="plot"+string(index)+".asc"; //using Standard Library string constructor
+						plotiasc="plot"+string(index)+(strstr(options,"y_binary")?".bin":".asc"); //using Standard Library string constructor
 						plot_file_list[i]=plotiasc;
 						name=plotiasc.c_str(); //using string member function to convert to char array 
 
 						//creating output stream list 'plot_ostream_list[i]', each will write on file 'ploti.asc'
-						plot_ostream_list[i].open(name); //'name' must be 'char' type
+						if(strstr(options,"y_binary"))
+						{
+							plot_ostream_list[i].open(name,ios::binary);
+							writer.attach(plot_ostream_list[i]);
+						}
+						else if(!plot_store.get_open())
+							plot_ostream_list[i].open(name); //'name' must be 'char' type
 
 						//writing banner on 'ploti.asc'
-						vehicle_list[i]->plot_banner(plot_ostream_list[i],title);				}
+						vehicle_list[i]->plot_banner(plot_ostream_list[i],title);
+
+						//with option 'y_merge', the banner of the first object heads 'plot.asc'
+						plot_store.write_banner(plot_ostream_list[i],title);				}
 				}
 
 				//creating output stream objects in 'stat_ostream_list[i]' for every file "stati.asc"
@@ -322,15 +377,24 @@ int main()
 
 						//building names for stat files
 						sprintf(index,"%i",i+1);
-						statiasc="stat"+string(index)+".asc"; //using Standard Library string constructor
+						statiasc="stat"+string(index)+(strstr(options,"y_binary")?".bin":".asc"); //using Standard Library string constructor
 						stat_file_list[i]=statiasc;
 						name=statiasc.c_str(); //using string member function to convert to char array 
 
 						//creating output stream list 'stat_ostream_list[i]', each will write on file 'stati.asc'
-						stat_ostream_list[i].open(name); //'name' must be 'char' type
+						if(strstr(options,"y_binary"))
+						{
+							stat_ostream_list[i].open(name,ios::binary);
+							writer.attach(stat_ostream_list[i]);
+						}
+						else if(!stat_store.get_open())
+							stat_ostream_list[i].open(name); //'name' must be 'char' type
 
 						//writing banner on 'stati.asc'
-						vehicle_list[i]->plot_banner(stat_ostream_list[i],title);				}
+						vehicle_list[i]->plot_banner(stat_ostream_list[i],title);
+
+						//with option 'y_merge', the banner of the first object heads 'stat.asc'
+						stat_store.write_banner(stat_ostream_list[i],title);				}
 				}
 
 				//composing documentation of 'round6', 'hyper', 'satellite' and 'radar' module-variables
@@ -403,11 +467,26 @@ int main()
 		/////////////////////// Simulation Execution //////////////////////////
 		///////////////////////////////////////////////////////////////////////	
 
-		execute(vehicle_list,module_list,sim_time,
-				 end_time,num_vehicles,num_modules,plot_step,
-				 int_step,scrn_step,com_step,traj_step,options,ftabout,
-				 plot_ostream_list,combus,status,num_hyper,num_satellite,num_radar,ftraj,title,
-				 traj_merge,nmonte,nmc,stat_ostream_list,stati_write_term);
+		//writing the pending binary rows, so a worker does not inherit them
+		writer.sync();
+
+		//the main process hands the run to a worker and initializes the next run
+		if(!mc.fork_run(nmc))
+		{
+			execute(vehicle_list,module_list,sim_time,
+					 end_time,num_vehicles,num_modules,plot_step,
+					 int_step,scrn_step,com_step,traj_step,options,ftabout,
+					 plot_ostream_list,combus,status,num_hyper,num_satellite,num_radar,ftraj,title,
+					 traj_merge,nmonte,nmc,stat_ostream_list,stati_write_term);
+
+			//appending the rows of the run to 'plot.asc' and 'stat.asc', option 'y_merge'
+			plot_store.end_run(nmc);
+			stat_store.end_run(nmc);
+
+			//a worker hands its output to the main process and exits
+			writer.sync();
+			mc.end_run();
+		}
 
 		//Deallocate dynamic memory
 		delete [] module_list;
@@ -420,6 +499,9 @@ int main()
 	}	// at this point the destructor of the object 'Vehicle vehicle_list' is called 
 	while(nmc<nmonte); 
 
+	//appending the output of the remaining runs in run order
+	mc.finish();
+
 	///////////////////////////////////////////////////////////////////////////	
 	///////////////////////// End of Monte Carlo Loop /////////////////////////
 	///////////////////////////////////////////////////////////////////////////	
@@ -431,6 +513,13 @@ int main()
 	fcopy.close();
 	int f(0);
 
+	//writing the pending binary rows of the plot, stat and traj files
+	writer.sync();
+
+	//closing 'plot.asc' and 'stat.asc', restoring the streams of the objects
+	plot_store.close();
+	stat_store.close();
+
 	//Close file streams
 	ftabout.close();
 	for(f=0;f<num_vehicles;f++) plot_ostream_list[f].close();
@@ -438,17 +527,6 @@ int main()
 	for(f=0;f<num_vehicles;f++) stat_ostream_list[f].close();
 	ftraj.close();
 
-	//merging 'ploti.asc' files into 'plot.asc'
-	if(strstr(options,"y_merge")&&strstr(options,"y_plot"))
-	{
-		merge_plot_files(plot_file_list,num_hyper,title);
-	}
-	//merging 'stati.asc' files into 'stat.asc'm using 'merge_plot_data' function
-	//adding at the end: time=-1 and dummy block of data
-	if(strstr(options,"y_merge")&&strstr(options,"y_stat"))
-	{
-		merge_stat_files(stat_file_list,num_hyper,title);
-	}
 	//Deallocate dynamic memory
 	delete [] plot_ostream_list;
 	delete [] plot_file_list;
@@ -506,6 +584,8 @@ int main()
 //011128 Created by Peter H Zipfel
 //030415 Adopted for HYPER simulation, PZi
 //040315 Calculating event_time, PZi
+//261017 Module dispatch on 'Module_id' instead of name comparisons
+//261017 Modules executed 'every n' integration steps
 ///////////////////////////////////////////////////////////////////////////////
 void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			 double end_time,int num_vehicles,int num_modules,double plot_step,
@@ -536,9 +616,10 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			//watching for the next event			
 			vehicle_list[i]->event(options);
 
-			//fixing 'event_epoch' and initializing 'event_time'
+			//fixing 'event_epoch' and initializing 'event_time' at the (located) event
+			//the event's new values took effect at the end of this step, not at the crossing
 			if(vehicle_list[i]->event_epoch)
-				vehicle_list[i]->event_time=0;
+				vehicle_list[i]->event_time=vehicle_list[i]->event_lag*int_step;
 
 
 			//continue only if vehicle is alive (health=1:alive; =-1:hit('satellite' only); =0:dead)
@@ -546,46 +627,57 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			if(health==1)
 			{
 				//refreshing Markov variables
+				vehicle_list[i]->set_random_source(RANDOM_MARKOV);
 				vehicle_list[i]->markov_noise(sim_time,int_step,nmonte);
 
 				//module loop -MOD: insert here new module function
+				//modules executed 'every n' steps are skipped in between, holding their outputs,
+				// and step over 'n*int_step'
 				for(int j=0;j<num_modules;j++)
 				{
-					if(module_list[j].name=="newton")
-						vehicle_list[i]->newton(int_step);
-					else if(module_list[j].name=="euler")
-						vehicle_list[i]->euler(int_step);
-					else if(module_list[j].name=="kinematics")
-						vehicle_list[i]->kinematics(sim_time,vehicle_list[i]->event_time,int_step,out_fact);
-					else if(module_list[j].name=="environment")
-						vehicle_list[i]->environment(int_step);
-					else if(module_list[j].name=="aerodynamics")
-						vehicle_list[i]->aerodynamics();
-					else if(module_list[j].name=="forces")
-						vehicle_list[i]->forces();
-					else if(module_list[j].name=="propulsion")
-						vehicle_list[i]->propulsion(int_step);
-					else if(module_list[j].name=="actuator")
-						vehicle_list[i]->actuator(int_step);
-					else if(module_list[j].name=="control") 
-						vehicle_list[i]->control(int_step);
-					else if(module_list[j].name=="ins")
-						vehicle_list[i]->ins(int_step);
-					else if(module_list[j].name=="guidance")
-						vehicle_list[i]->guidance(int_step);
-					else if(module_list[j].name=="gps")
-						vehicle_list[i]->gps(int_step);
-					else if(module_list[j].name=="startrack")
-						vehicle_list[i]->startrack();
-					else if(module_list[j].name=="rcs")
-						vehicle_list[i]->rcs();
-					else if(module_list[j].name=="intercept")
-						vehicle_list[i]->intercept(combus,vehicle_slot,int_step,title);
-					else if(module_list[j].name=="seeker")
-						vehicle_list[i]->seeker(combus,num_vehicles,sim_time,int_step);
-					else if(module_list[j].name=="datalink")
-						vehicle_list[i]->datalink(combus,num_vehicles);
+					if(vehicle_list[i]->nstep%module_list[j].divisor) continue;
+					double module_step=int_step*module_list[j].divisor;
+
+					vehicle_list[i]->set_random_source(module_list[j].id);
+					switch(module_list[j].id){
+					case MOD_NEWTON:
+						vehicle_list[i]->newton(module_step);break;
+					case MOD_EULER:
+						vehicle_list[i]->euler(module_step);break;
+					case MOD_KINEMATICS:
+						vehicle_list[i]->kinematics(sim_time,vehicle_list[i]->event_time,int_step,out_fact);break;
+					case MOD_ENVIRONMENT:
+						vehicle_list[i]->environment(module_step);break;
+					case MOD_AERODYNAMICS:
+						vehicle_list[i]->aerodynamics();break;
+					case MOD_FORCES:
+						vehicle_list[i]->forces();break;
+					case MOD_PROPULSION:
+						vehicle_list[i]->propulsion(module_step);break;
+					case MOD_ACTUATOR:
+						vehicle_list[i]->actuator(module_step);break;
+					case MOD_CONTROL:
+						vehicle_list[i]->control(module_step);break;
+					case MOD_INS:
+						vehicle_list[i]->ins(module_step);break;
+					case MOD_GUIDANCE:
+						vehicle_list[i]->guidance(module_step);break;
+					case MOD_GPS:
+						vehicle_list[i]->gps(module_step);break;
+					case MOD_STARTRACK:
+						vehicle_list[i]->startrack();break;
+					case MOD_RCS:
+						vehicle_list[i]->rcs();break;
+					case MOD_INTERCEPT:
+						vehicle_list[i]->intercept(combus,vehicle_slot,module_step,title);break;
+					case MOD_SEEKER:
+						vehicle_list[i]->seeker(combus,num_vehicles,sim_time,module_step);break;
+					case MOD_DATALINK:
+						vehicle_list[i]->datalink(combus,num_vehicles);break;
+					}
 				} //end of module loop
+				//counting the integration steps of the vehicle
+				vehicle_list[i]->nstep++;
 
 				//preserving 'health' status of vehicle objects
 				combus_status(combus,status,num_vehicles);
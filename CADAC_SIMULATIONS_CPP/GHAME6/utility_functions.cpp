@@ -53,6 +53,7 @@
 #define _CRT_SECURE_NO_DEPRECATE
 #include <fstream>
 #include <cmath>
+#include <map>
 #include "utility_header.hpp"
 #include "global_header.hpp"
 
@@ -65,7 +66,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 //Constructors
 ///////////////////////////////////////////////////////////////////////////////
-Matrix::Matrix(){}
+Matrix::Matrix(){num_row=0;num_col=0;num_elem=0;pbody=body;}
 
 Matrix::Matrix(int row_size,int col_size)
 {
@@ -78,8 +79,7 @@ Matrix::Matrix(int row_size,int col_size)
 
           //allocating memory
           num_elem=row_size*col_size;
-          pbody=new double[num_elem];
-          if(pbody==0){cerr<<" *** Error: matrix memory allocation failed ***\n";system("pause");exit(1);}
+          allocate();
 
           //initializing array to zero
           for(int i=0;i<num_elem;i++)
@@ -93,8 +93,7 @@ Matrix::Matrix(const Matrix &MAT)
           num_row=MAT.num_row;
           num_col=MAT.num_col;
           num_elem=MAT.num_elem;
-          pbody=new double[num_elem];
-          if(pbody==0){cerr<<" *** Error: matrix memory allocation failed ***\n";system("pause");exit(1);}
+          allocate();
 
           //copying
           for(int i=0;i<num_elem;i++)
@@ -107,8 +106,25 @@ Matrix::Matrix(const Matrix &MAT)
 Matrix::~Matrix()
 {
 //	cout<<" <<< destructing <<<\n";
-          delete [] pbody;
+          if(pbody!=body) delete [] pbody;
 }	
+///////////////////////////////////////////////////////////////////////////////
+//Points 'pbody' at storage for 'num_elem' elements
+//Matrices of up to MATRIX_INLINE elements use the array 'body' inside the object,
+//only larger ones are allocated on the heap
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Matrix::allocate()
+{
+	if(num_elem<=MATRIX_INLINE)
+		pbody=body;
+	else
+	{
+		pbody=new double[num_elem];
+		if(pbody==0){cerr<<" *** Error: matrix memory allocation failed ***\n";system("pause");exit(1);}
+	}
+}
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -342,12 +358,11 @@ void Matrix::dimension(int row,int col)
           num_row=row;
           num_col=col;
 
-          pbody=NULL;
+          if(pbody!=body) delete [] pbody;
 
           //allocating memory
           num_elem=row*col;
-          pbody=new double[num_elem];
-          if(pbody==0){cerr<<" *** Error: memory allocation failed 'Matrix::dimension()' ***\n";system("pause");exit(1);}
+          allocate();
 
           //initializing array to zero
           for(int i=0;i<num_elem;i++)
@@ -792,11 +807,9 @@ Matrix & Matrix::operator=(const Matrix &B)
           if((num_row != B.num_row)||(num_col != B.num_col))
           {cerr<<" *** Error: incompatible dimensions in 'Matrix::operator=()' *** \n";system("pause");exit(1);}
 
-          delete [] pbody;
           num_elem=B.num_elem;
           num_row=B.num_row;
           num_col=B.num_col;
-          pbody=new double[num_elem];
 
           for (int i=0;i<num_elem;i++)
                     *(pbody+i)=(*(B.pbody+i));
@@ -2190,6 +2203,175 @@ double gauss(double mean,double sig)
           return value*sig+mean;
 }
 ///////////////////////////////////////////////////////////////////////////////
+///////////////// Definitions of 'Random_stream' member functions /////////////
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+//Seeding the stream of noise 'source' of 'vehicle' in run 'nmc'
+//The key mixes 'iseed' and 'nmc' (splitmix64), the counter holds 'vehicle' and
+// 'source', so all streams of a study are distinct
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Random_stream::seed(int iseed,int nmc,int vehicle,int source)
+{
+	unsigned long long z=((unsigned long long)(unsigned)iseed<<32)+(unsigned)nmc+0x9e3779b97f4a7c15ULL;
+	z=(z^(z>>30))*0xbf58476d1ce4e5b9ULL;
+	z=(z^(z>>27))*0x94d049bb133111ebULL;
+	z^=z>>31;
+
+	key[0]=(unsigned)z;
+	key[1]=(unsigned)(z>>32);
+	ctr[0]=0;
+	ctr[1]=0;
+	ctr[2]=(unsigned)vehicle;
+	ctr[3]=(unsigned)source;
+	used=4;
+	iset=0;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Drawing the next random word
+//Every fourth draw computes a new block of four words from the counter
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+unsigned Random_stream::next()
+{
+	if(used==4){
+		unsigned c0=ctr[0],c1=ctr[1],c2=ctr[2],c3=ctr[3];
+		unsigned k0=key[0],k1=key[1];
+		for(int round=0;round<10;round++){
+			unsigned long long p0=0xD2511F53ULL*c0;
+			unsigned long long p1=0xCD9E8D57ULL*c2;
+			c0=(unsigned)(p1>>32)^c1^k0;
+			c2=(unsigned)(p0>>32)^c3^k1;
+			c1=(unsigned)p1;
+			c3=(unsigned)p0;
+			k0+=0x9E3779B9;
+			k1+=0xBB67AE85;
+		}
+		block[0]=c0;block[1]=c1;block[2]=c2;block[3]=c3;
+		if(++ctr[0]==0) ctr[1]++;
+		used=0;
+	}
+	return block[used++];
+}
+///////////////////////////////////////////////////////////////////////////////
+//Uniform distribution in the open interval (0,1), 53-bit resolution
+//Zero is excluded, so 'log(unituni())' is finite
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+double Random_stream::unituni()
+{
+	unsigned high=next()>>5;
+	unsigned low=next()>>6;
+	return (high*67108864.+low+0.5)/9007199254740992.;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Uniform distribution between 'min' and 'max'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+double Random_stream::uniform(double min,double max)
+{
+	return min+(max-min)*unituni();
+}
+///////////////////////////////////////////////////////////////////////////////
+//Gaussian distribution with 'mean' and 'sig' std deviation
+//Polar method as in 'gauss()', second deviate kept by the stream
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+double Random_stream::gauss(double mean,double sig)
+{
+	double fac,rsq,v1,v2,value;
+
+	if(iset==0){
+		do{
+			v1=2.*unituni()-1.;
+			v2=2.*unituni()-1.;
+			rsq=v1*v1+v2*v2;
+		}while(rsq>=1.0||rsq==0);
+
+		fac=sqrt(-2.*log(rsq)/rsq);
+		gset=v1*fac;
+		iset=1;
+		value=v2*fac;
+	}
+	else{
+		iset=0;
+		value=gset;
+	}
+	return value*sig+mean;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Batch of 'num' Gaussian values with 'mean' and 'sig' std deviation
+//The uniforms are drawn into 'values' first, then transformed pairwise
+// (Box-Muller) in a loop without branches or rejections
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Random_stream::gauss(double *values,int num,double mean,double sig)
+{
+	int i(0);
+	int even=num-num%2;
+	double last(0);
+
+	for(i=0;i<num;i++) values[i]=unituni();
+	if(even<num) last=unituni();
+
+	for(i=0;i<even;i+=2){
+		double radius=sig*sqrt(-2.*log(values[i]));
+		double angle=6.283185307179586*values[i+1];
+		values[i]=mean+radius*cos(angle);
+		values[i+1]=mean+radius*sin(angle);
+	}
+	if(even<num)
+		values[even]=mean+sig*sqrt(-2.*log(values[even]))*cos(6.283185307179586*last);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Time-correlated Gaussian variable with zero mean, see 'markov()'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+double Random_stream::markov(double sigma,double bcor,double time,double intstep,double &value_saved)
+{
+	double value=gauss(0,sigma);
+	if(time==0) value_saved=value;
+	else{
+		if(bcor!=0)
+		{
+			double dum=exp(-bcor*intstep);
+			double dumsqrd=dum*dum;
+			value=value*sqrt(1.-dumsqrd)+value_saved*dum;
+			value_saved=value;
+		}
+	}
+	return value;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Rayleigh distribution with peak value of pdf = 'mode', see 'rayleigh()'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+double Random_stream::rayleigh(double mode)
+{
+	return sqrt(2.*(-log(unituni())))*mode;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Exponential distribution with a given mean density, see 'exponential()'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+double Random_stream::exponential(double density)
+{
+	double value=-log(unituni());
+	if(!density)
+	{cout<<" *** Error: density not given a non-zero value in 'exponential()' *** \n";exit(1);}
+	return value/density;
+}
+///////////////////////////////////////////////////////////////////////////////
 //Generating a time-correlated Gaussian variable with zero mean
 //Ref: CADAC Subroutine CNT_GAUSS
 //Function gauss() is CADAC++ utility
@@ -2353,6 +2535,355 @@ double Datadeck::look_up(string name,double value1,double value2,double value3)
           return interpolate(loc1,loc1+1,loc2,loc2+1,loc3,loc3+1,slot,value1,value2,value3);
 }
 ///////////////////////////////////////////////////////////////////////////////
+//Single independent variable look-up of a table name literal
+//Constant extrapolation at the upper end, slope extrapolation at the lower end
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+double Datadeck::look_up(const char *name,double value1)
+{
+	Lookup_site *site=find_site(name);
+	Table *table=get_tbl(site->slot);
+
+	int var1_dim=table->get_var1_dim();
+	int loc1=hunt_index(var1_dim-1,value1,table->var1_values,site->loc1);
+
+	//using max discrete value if value is outside table
+	if (loc1==(var1_dim-1)) return table->data[loc1];
+
+	return interpolate(loc1,loc1+1,site->slot,value1);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Two independent variables look-up of a table name literal
+//Constant extrapolation at the upper end, slope extrapolation at the lower end
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+double Datadeck::look_up(const char *name,double value1,double value2)
+{
+	Lookup_site *site=find_site(name);
+	Table *table=get_tbl(site->slot);
+
+	int loc1=hunt_index(table->get_var1_dim()-1,value1,table->var1_values,site->loc1);
+	int loc2=hunt_index(table->get_var2_dim()-1,value2,table->var2_values,site->loc2);
+
+	return interpolate(loc1,loc1+1,loc2,loc2+1,site->slot,value1,value2);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Three independent variables look-up of a table name literal
+//Constant extrapolation at the upper end, slope extrapolation at the lower end
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+double Datadeck::look_up(const char *name,double value1,double value2,double value3)
+{
+	Lookup_site *site=find_site(name);
+	Table *table=get_tbl(site->slot);
+
+	int loc1=hunt_index(table->get_var1_dim()-1,value1,table->var1_values,site->loc1);
+	int loc2=hunt_index(table->get_var2_dim()-1,value2,table->var2_values,site->loc2);
+	int loc3=hunt_index(table->get_var3_dim()-1,value3,table->var3_values,site->loc3);
+
+	return interpolate(loc1,loc1+1,loc2,loc2+1,loc3,loc3+1,site->slot,value1,value2,value3);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Finding the look-up site of a table name literal
+//A name address seen before gives its table slot, confirmed by the table name,
+// so that a reused name buffer cannot read another table; any other name is
+// resolved by searching the deck
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+Lookup_site *Datadeck::find_site(const char *name)
+{
+	map<const char *,int>::iterator known=site_slots.find(name);
+	if(known!=site_slots.end()&&get_tbl(known->second)->get_name()==name)
+		return &sites[known->second];
+
+	//finding slot of table in table pointer array (Table **table_ptr) 
+	int slot(-1);
+	do{
+		slot++;
+		if(slot==capacity)
+		{cerr<<" *** Error: table '"<<name<<"' not found in deck '"<<title<<"' *** \n";exit(1);}
+	}while(get_tbl(slot)->get_name()!=name);
+
+	//one site per table slot, allocated once the deck is complete
+	if((int)sites.size()!=capacity)
+		sites.assign(capacity,Lookup_site());
+	sites[slot].slot=slot;
+	site_slots[name]=slot;
+	return &sites[slot];
+}
+///////////////////////////////////////////////////////////////////////////////
+//Single independent variable look-up of a table group
+//Constant extrapolation at the upper end, slope extrapolation at the lower end
+//Same arithmetic as 'interpolate()', table by table
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Datadeck::look_up(const char **names,int num,double value1,double *values)
+{
+	Lookup_group *group=find_group(names,num,1);
+
+	int var1_dim=group->var1_dim;
+	int ind1=hunt_index(var1_dim-1,value1,group->var1_values,group->loc1);
+	double *y1=&group->data[ind1*num];
+
+	//using max discrete value if value is outside table
+	if(ind1==(var1_dim-1)){
+		for(int k=0;k<num;k++) values[k]=y1[k];
+		return;
+	}
+	double *y2=y1+num;
+
+	double dumx(0);
+	double diff=value1-group->var1_values[ind1];
+	double dx=group->var1_values[ind1+1]-group->var1_values[ind1];
+	if(dx>EPS) dumx=diff/dx;
+
+	for(int k=0;k<num;k++)
+		values[k]=y1[k]+dumx*(y2[k]-y1[k]);
+}
+///////////////////////////////////////////////////////////////////////////////
+//Two independent variables look-up of a table group
+//Constant extrapolation at the upper end, slope extrapolation at the lower end
+//Same arithmetic as 'interpolate()', table by table
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Datadeck::look_up(const char **names,int num,double value1,double value2,double *values)
+{
+	Lookup_group *group=find_group(names,num,2);
+
+	int var1_dim=group->var1_dim;
+	int var2_dim=group->var2_dim;
+	int ind10=hunt_index(var1_dim-1,value1,group->var1_values,group->loc1);
+	int ind20=hunt_index(var2_dim-1,value2,group->var2_values,group->loc2);
+	int ind11=ind10+1;
+	int ind21=ind20+1;
+
+	double dx1(0),dx2(0);
+	double dumx1(0),dumx2(0);
+
+	double diff1=value1-group->var1_values[ind10];
+	double diff2=value2-group->var2_values[ind20];
+
+	if(ind10==(var1_dim-1)) //Assures constant upper extrapolation of first variable
+		ind11=ind10;
+	else
+		dx1=group->var1_values[ind11]-group->var1_values[ind10];
+
+	if(ind20==(var2_dim-1)) //Assures constant upper extrapolation of second variable
+		ind21=ind20;
+	else
+		dx2=group->var2_values[ind21]-group->var2_values[ind20];
+
+	if(dx1>EPS) dumx1=diff1/dx1;
+	if(dx2>EPS) dumx2=diff2/dx2;
+
+	double *y11=&group->data[(ind10*var2_dim+ind20)*num];
+	double *y12=&group->data[(ind10*var2_dim+ind21)*num];
+	double *y21=&group->data[(ind11*var2_dim+ind20)*num];
+	double *y22=&group->data[(ind11*var2_dim+ind21)*num];
+
+	for(int k=0;k<num;k++){
+		double y1=dumx1*(y21[k]-y11[k])+y11[k];
+		double y2=dumx1*(y22[k]-y12[k])+y12[k];
+		values[k]=dumx2*(y2-y1)+y1;
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Three independent variables look-up of a table group
+//Constant extrapolation at the upper end, slope extrapolation at the lower end
+//Same arithmetic as 'interpolate()', table by table
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Datadeck::look_up(const char **names,int num,double value1,double value2,double value3,
+					   double *values)
+{
+	Lookup_group *group=find_group(names,num,3);
+
+	int var1_dim=group->var1_dim;
+	int var2_dim=group->var2_dim;
+	int var3_dim=group->var3_dim;
+	int ind10=hunt_index(var1_dim-1,value1,group->var1_values,group->loc1);
+	int ind20=hunt_index(var2_dim-1,value2,group->var2_values,group->loc2);
+	int ind30=hunt_index(var3_dim-1,value3,group->var3_values,group->loc3);
+	int ind11=ind10+1;
+	int ind21=ind20+1;
+	int ind31=ind30+1;
+
+	double dx1(0),dx2(0),dx3(0);
+	double dumx1(0),dumx2(0),dumx3(0);
+
+	double diff1=value1-group->var1_values[ind10];
+	double diff2=value2-group->var2_values[ind20];
+	double diff3=value3-group->var3_values[ind30];
+
+	if(ind10==(var1_dim-1)) //Assures constant upper extrapolation of first variable
+		ind11=ind10;
+	else
+		dx1=group->var1_values[ind11]-group->var1_values[ind10];
+
+	if(ind20==(var2_dim-1)) //Assures constant upper extrapolation of second variable
+		ind21=ind20;
+	else
+		dx2=group->var2_values[ind21]-group->var2_values[ind20];
+
+	if(ind30==(var3_dim-1)) //Assures constant upper extrapolation of third variable
+		ind31=ind30;
+	else
+		dx3=group->var3_values[ind31]-group->var3_values[ind30];
+
+	if(dx1>EPS) dumx1=diff1/dx1;
+	if(dx2>EPS) dumx2=diff2/dx2;
+	if(dx3>EPS) dumx3=diff3/dx3;
+
+	//grid points of parameter ind20 and ind21 of the middle variable
+	int block=var2_dim*var3_dim;
+	double *y110=&group->data[(ind10*block+ind20*var3_dim+ind30)*num];
+	double *y120=&group->data[(ind11*block+ind20*var3_dim+ind30)*num];
+	double *y310=&group->data[(ind10*block+ind20*var3_dim+ind31)*num];
+	double *y320=&group->data[(ind11*block+ind20*var3_dim+ind31)*num];
+	double *y111=&group->data[(ind10*block+ind21*var3_dim+ind30)*num];
+	double *y121=&group->data[(ind11*block+ind21*var3_dim+ind30)*num];
+	double *y311=&group->data[(ind10*block+ind21*var3_dim+ind31)*num];
+	double *y321=&group->data[(ind11*block+ind21*var3_dim+ind31)*num];
+
+	for(int k=0;k<num;k++){
+		//2DIM interpolation for parameter ind20
+		double y1=dumx1*(y120[k]-y110[k])+y110[k];
+		double y3=dumx1*(y320[k]-y310[k])+y310[k];
+		double y21=dumx3*(y3-y1)+y1;
+		//2DIM interpolation for parameter ind21
+		y1=dumx1*(y121[k]-y111[k])+y111[k];
+		y3=dumx1*(y321[k]-y311[k])+y311[k];
+		double y22=dumx3*(y3-y1)+y1;
+		//1DIM interpolation between the middle variable
+		values[k]=dumx2*(y22-y21)+y21;
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+//Finding the table group of a name array
+//A new group checks that all tables have the dimension 'dim' and the
+// breakpoints of the first table, then interleaves their values
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+Lookup_group *Datadeck::find_group(const char **names,int num,int dim)
+{
+	for(int i=0;i<(int)groups.size();i++)
+		if(groups[i].names==names) return &groups[i];
+
+	Table *first=get_tbl(find_site(names[0])->slot);
+	int var_dim[3]={first->get_var1_dim(),1,1};
+	double *var_values[3]={first->var1_values,first->var2_values,first->var3_values};
+	if(dim>1) var_dim[1]=first->get_var2_dim();
+	if(dim>2) var_dim[2]=first->get_var3_dim();
+	int size=var_dim[0]*var_dim[1]*var_dim[2];
+
+	Lookup_group group;
+	group.names=names;
+	group.num=num;
+	group.var1_dim=var_dim[0];
+	group.var2_dim=var_dim[1];
+	group.var3_dim=var_dim[2];
+	group.var1_values=var_values[0];
+	group.var2_values=var_values[1];
+	group.var3_values=var_values[2];
+	group.data.resize(size*num);
+	group.loc1=0;
+	group.loc2=0;
+	group.loc3=0;
+
+	for(int k=0;k<num;k++)
+	{
+		Table *table=get_tbl(find_site(names[k])->slot);
+		int table_dim[3]={table->get_var1_dim(),1,1};
+		double *table_values[3]={table->var1_values,table->var2_values,table->var3_values};
+		if(dim>1) table_dim[1]=table->get_var2_dim();
+		if(dim>2) table_dim[2]=table->get_var3_dim();
+
+		bool same=(table->get_dim()==dim);
+		for(int n=0;n<dim&&same;n++){
+			same=(table_dim[n]==var_dim[n]);
+			for(int m=0;m<var_dim[n]&&same;m++)
+				same=(table_values[n][m]==var_values[n][m]);
+		}
+		if(!same)
+		{cerr<<" *** Error: table '"<<names[k]<<"' does not share the breakpoints of '"
+			<<names[0]<<"' in deck '"<<title<<"' *** \n";exit(1);}
+
+		for(int i=0;i<size;i++)
+			group.data[i*num+k]=table->data[i];
+	}
+	groups.push_back(group);
+	return &groups.back();
+}
+///////////////////////////////////////////////////////////////////////////////
+//Deck files loaded in this process, keyed by file name
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+static map<string,Deck_file> deck_files;
+
+///////////////////////////////////////////////////////////////////////////////
+//Taking over the tables of a deck file loaded before
+//Returns false if the file has not been loaded yet
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+bool Datadeck::share(const char *file_name)
+{
+	map<string,Deck_file>::iterator deck=deck_files.find(file_name);
+	if(deck==deck_files.end()) return false;
+
+	title=deck->second.title;
+	capacity=deck->second.capacity;
+	tbl_counter=capacity-1;
+	table_ptr=deck->second.table_ptr;
+	file=file_name;
+	deck->second.users++;
+	return true;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Offering the tables just read from a deck file to later 'Datadeck' objects
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Datadeck::keep(const char *file_name)
+{
+	Deck_file deck;
+	deck.title=title;
+	deck.capacity=capacity;
+	deck.table_ptr=table_ptr;
+	deck.users=1;
+	deck_files[file_name]=deck;
+	file=file_name;
+}
+///////////////////////////////////////////////////////////////////////////////
+//Giving up the tables, the last user of a deck file deletes them
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void Datadeck::release()
+{
+	if(file.empty()){
+		delete [] table_ptr;
+		return;
+	}
+	map<string,Deck_file>::iterator deck=deck_files.find(file);
+	if(--deck->second.users==0){
+		for(int i=0;i<capacity;i++) delete table_ptr[i];
+		delete [] table_ptr;
+		deck_files.erase(deck);
+	}
+	file.clear();
+	table_ptr=0;
+}
+///////////////////////////////////////////////////////////////////////////////
 //Table index finder
 //This is a binary search method it is O(lgN)
 // * Returns array locater (offset index) of the discrete_variable just below variable
@@ -2383,6 +2914,31 @@ int Datadeck::find_index(int max,double value,double *list)
           }
 }
 ///////////////////////////////////////////////////////////////////////////////
+//Table index finder starting from the bracket 'loc' of the last call
+//Tries the last bracket and its neighbors, falls back on 'find_index()'
+// * Only accepts a bracket with the value strictly inside; the binary search
+//   then returns the same locater, also with repeated breakpoints
+// * Updates 'loc' for the next call
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+int Datadeck::hunt_index(int max,double value,double *list,int &loc)
+{
+	int offset[3]={0,1,-1};
+
+	for(int k=0;k<3;k++)
+	{
+		int i=loc+offset[k];
+		if(i>=0&&i<max&&list[i]<value&&value<list[i+1])
+		{
+			loc=i;
+			return i;
+		}
+	}
+	loc=find_index(max,value,list);
+	return loc;
+}
+///////////////////////////////////////////////////////////////////////////////
 //Linear one-dimensional interpolation
 //Data deck must contain table in the following format:
 //
@@ -135,6 +135,9 @@ protected:
 	//be written to the 'ploti.asc' files
 	int *rotor_plot_ind; int rotor_plot_count;
 
+	//compiled output plan of the 'ploti.asc' files
+	Output_plan plot_plan;
+
 	//indicator array pointing to the module-variable which are to 
 	//be written to 'combus' 'packets'
 	int *rotor_com_ind; int rotor_com_count;
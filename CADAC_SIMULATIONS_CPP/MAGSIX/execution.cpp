@@ -48,9 +48,6 @@ void combus_status(Packet *combus,int *status,int num_vehicles);
 void acquire_timing(fstream &input,double &plot_step,double &scn_step,double &com_step,
 					double &traj_step,double &int_step);
 
-//merging the 'ploti.asc' files onto 'plot.asc' 
-void merge_plot_files(string *plot_file_list,int num_rotor,char *title);
-
 //writing 'combus' data on screen
 void comscrn_data(Packet *combus,int num_vehicles);
 
@@ -99,6 +96,8 @@ int main()
 					//in same sequence as 'vehicle_list'
 	int *status=NULL; //array containing status of each vehicle object
 	bool one_traj_banner=true; //write just one banner on file 'traj.asc'
+	Output_writer writer; //binary output of the plot, stat and traj files, option 'y_binary'
+	Result_store plot_store; //plot data of all objects on 'plot.asc', option 'y_merge'
 	Document *doc_rotor6=NULL;  //array for documenting ROTOR module-variables of 'input.asc'
 	bool document_rotor6=false; //true if array doc_rotor6 was created
 
@@ -135,6 +134,20 @@ int main()
 	//aqcuiring title statement and option selections
 	acquire_title_options(input,title,options);
 
+	//binary output of the plot and traj files, 'y_binary' on the OPTIONS line
+	if(strstr(options,"y_binary"))
+	{
+		writer.start();
+		if(strstr(options,"y_traj"))
+		{
+			ftraj.close();
+			remove("traj.asc");
+			ftraj.open("traj.bin",ios::binary);
+			if(!ftraj){cout<<" *** Error: cannot open 'traj.bin' file *** \n";exit(1);}
+			writer.attach(ftraj);
+		}
+	}
+
 	//acquiring number of module 
 	number_modules(input,num_modules);
 
@@ -157,6 +170,13 @@ int main()
 	
 	//allocating memory for 'ploti.asc' file streams, but do it only once
 	plot_ostream_list=new ofstream[num_vehicles];
+
+	//collecting the rows of all objects on 'plot.asc', option 'y_merge'
+	if(strstr(options,"y_merge")&&strstr(options,"y_plot")&&!strstr(options,"y_binary"))
+	{
+		plot_store.open("plot.asc","plot.idx");
+		plot_store.attach(plot_ostream_list,num_vehicles);
+	}
 	if(plot_ostream_list==0){cerr<<"*** Error: plot_ostream_list[] alloc. failed *** \n";system("pause");exit(1);}
 
 	//allocating memory for 'ploti.asc' files, but do it only once
@@ -201,10 +221,13 @@ int main()
 		//executing initialization computations -MOD		
 		for (int j=0;j<num_modules;j++)
 		{
-			if((module_list[j].name=="trajectory")&&(module_list[j].initialization=="init"))
-				vehicle_list[i]->init_trajectory();
-			else if((module_list[j].name=="attitude")&&(module_list[j].initialization=="init"))
-				vehicle_list[i]->init_attitude();
+			if(module_list[j].init)
+				switch(module_list[j].id){
+				case MOD_TRAJECTORY:
+					vehicle_list[i]->init_trajectory();break;
+				case MOD_ATTITUDE:
+					vehicle_list[i]->init_attitude();break;
+				}
 		}
 		//writing banner to screen and file 'tabout.asc'
 		if(!strcmp(vehicle_name,"ROTOR")&&one_screen_banner)
@@ -241,15 +264,24 @@ int main()
 
 				//building names for plot files
 				sprintf(index,"%i",i+1);
-				plotiasc="plot"+string(index)+".asc"; //using Standard Library string constructor
+				plotiasc="plot"+string(index)+(strstr(options,"y_binary")?".bin":".asc"); //using Standard Library string constructor
 				plot_file_list[i]=plotiasc;
 				name=plotiasc.c_str(); //using string member function to convert to char array 
 
 				//creating output stream list 'plot_ostream_list[i]', each will write on file 'ploti.asc'
-				plot_ostream_list[i].open(name); //'name' must be 'char' type
+				if(strstr(options,"y_binary"))
+				{
+					plot_ostream_list[i].open(name,ios::binary);
+					writer.attach(plot_ostream_list[i]);
+				}
+				else if(!plot_store.get_open())
+					plot_ostream_list[i].open(name); //'name' must be 'char' type
 
 				//writing banner on 'ploti.asc'
 				vehicle_list[i]->plot_banner(plot_ostream_list[i],title);
+
+				//with option 'y_merge', the banner of the first object heads 'plot.asc'
+				plot_store.write_banner(plot_ostream_list[i],title);
 			}
 		}
 
@@ -304,6 +336,9 @@ int main()
 			 int_step,scrn_step,com_step,traj_step,options,ftabout,
 			 plot_ostream_list,combus,status,num_rotor,ftraj,title,
 			 traj_merge);
+
+	//appending the rows to 'plot.asc', option 'y_merge'
+	plot_store.end_run(0);
 	///////////////////////////////////////////////////////////////////////////////	
 	/////////////////////// Final Calculations ////////////////////////////////////
 	///////////////////////////////////////////////////////////////////////////////	
@@ -312,8 +347,11 @@ int main()
 			int health=combus[i].get_status();
 			if(health){
 				for (int j=0;j<num_modules;j++){						
-						if((module_list[j].name=="trajectory")&&(module_list[j].termination=="term"))
-						vehicle_list[i]->term_trajectory();
+						if(module_list[j].term)
+							switch(module_list[j].id){
+							case MOD_TRAJECTORY:
+								vehicle_list[i]->term_trajectory();break;
+							}
 				}
 			}
 		}
@@ -330,16 +368,17 @@ int main()
 	input.close();
 	fcopy.close();
 
+	//writing the pending binary rows of the plot and traj files
+	writer.sync();
+
+	//closing 'plot.asc', restoring the streams of the objects
+	plot_store.close();
+
 	//Close file streams
 	ftabout.close();
 	for(int f=0;f<num_vehicles;f++) plot_ostream_list[f].close();
 	fdoc.close();
 
-	//merging 'ploti.asc' files into 'plot.asc'
-	if(strstr(options,"y_merge")&&strstr(options,"y_plot"))
-	{
-		merge_plot_files(plot_file_list,num_rotor,title);
-	}
 	//Deallocate dynamic memory
 	delete [] plot_ostream_list;
 	delete [] plot_file_list;
@@ -387,6 +426,7 @@ int main()
 //				  				
 //011128 Created from Cruise3 simulation by Peter H Zipfel
 //
+//261017 Module dispatch on 'Module_id' instead of name comparisons
 ///////////////////////////////////////////////////////////////////////////////
 void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			 double end_time,int num_vehicles,int num_modules,double plot_step,
@@ -424,12 +464,14 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 				//module loop -MOD
 				for(int j=0;j<num_modules;j++)
 				{
-					if(module_list[j].name=="environment")
-						vehicle_list[i]->environment(int_step);
-					else if(module_list[j].name=="trajectory")
-						vehicle_list[i]->trajectory(combus,vehicle_slot,sim_time,int_step);
-					else if(module_list[j].name=="attitude")
-						vehicle_list[i]->attitude(int_step);
+					switch(module_list[j].id){
+					case MOD_ENVIRONMENT:
+						vehicle_list[i]->environment(int_step);break;
+					case MOD_TRAJECTORY:
+						vehicle_list[i]->trajectory(combus,vehicle_slot,sim_time,int_step);break;
+					case MOD_ATTITUDE:
+						vehicle_list[i]->attitude(int_step);break;
+					}
 				} //end of module loop
 
 				//preserving 'health' status of vehicle objects
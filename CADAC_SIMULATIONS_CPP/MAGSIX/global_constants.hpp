@@ -31,6 +31,7 @@ int const ILARGE=9999;					//large integer number
 //sizing of arrays
 const int CHARN=31;						//character numbers in variable names
 const int CHARL=130;					//character numbers in a line
+const int NOUTPUT_CHUNK=8192;			//values per chunk of binary output, option 'y_binary'
 //verify the following array sizes. If too small, dynamic memory allocation will fail!
 const int NROTOR=300;					//size of 'missile' module-variable array
 const int NEVENT=10;					//max number of events
@@ -26,6 +26,12 @@ class Cadac
 private:
 	 //vehicle object name
 	char name[CHARN];
+	//noise streams by source, see 'Random_source'
+	Random_stream random[NRANDOM];
+	//source of the draws, set by the executive
+	int random_source;
+	//true if drawing from 'random', else from 'rand()'
+	bool random_seeded;
 		
 protected:
 	//module-variable array of class 'Round6'
@@ -42,14 +48,70 @@ public:
 	//time elapsed in event 
 	double event_time; //event_time
 
+	//fraction of the integration step elapsed since the located event
+	double event_lag;
+
+	//integration steps executed, gating the modules executed 'every n' steps
+	int nstep;
+
 	virtual~Cadac(){};
 
 	///////////////////////////////////////////////////////////////////////////
 	//Constructor of class 'Cadac'
 	//
 	//010703 Created by Peter H Zipfel
+	//261017 Event state zeroed, read before the first event
+	///////////////////////////////////////////////////////////////////////////
+	Cadac():event_epoch(false),event_time(0),event_lag(0),nstep(0),random_source(RANDOM_INPUT),random_seeded(false){}
+
 	///////////////////////////////////////////////////////////////////////////
-	Cadac(){}
+	//Noise streams of the vehicle object, one per source, see 'Random_source'
+	//Within the vehicle classes these functions hide the global stochastic
+	// functions, so each module draws from the stream of its own source.
+	//Unless 'seed_random()' is called the draws come from 'rand()' as before.
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void seed_random(int iseed,int nmc,int vehicle)
+	{
+		for(int i=0;i<NRANDOM;i++) random[i].seed(iseed,nmc,vehicle,i);
+		random_seeded=true;
+	}
+	void set_random_source(int source){random_source=source;}
+
+	///////////////////////////////////////////////////////////////////////////
+	//Noise streams of a vehicle object resumed from 'Checkpoint' in run 'nmc'
+	//Unseeded streams are seeded; seeded streams keep their position and, if
+	// 'branch', take the key of run 'nmc', so each run draws its own continuation
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	void resume_random(int iseed,int nmc,int vehicle,bool branch)
+	{
+		if(!random_seeded) seed_random(iseed,nmc,vehicle);
+		else if(branch) for(int i=0;i<NRANDOM;i++) random[i].rekey(iseed,nmc);
+	}
+
+	double unituni()
+	{return random_seeded?random[random_source].unituni(): ::unituni();}
+	double uniform(double min,double max)
+	{return random_seeded?random[random_source].uniform(min,max): ::uniform(min,max);}
+	double gauss(double mean,double sig)
+	{return random_seeded?random[random_source].gauss(mean,sig): ::gauss(mean,sig);}
+	void gauss(double *values,int num,double mean,double sig)
+	{
+		if(random_seeded) random[random_source].gauss(values,num,mean,sig);
+		else for(int i=0;i<num;i++) values[i]=::gauss(mean,sig);
+	}
+	double markov(double sigma,double bcor,double time,double intstep,double &value_saved)
+	{
+		if(random_seeded) return random[random_source].markov(sigma,bcor,time,intstep,value_saved);
+		return ::markov(sigma,bcor,time,intstep,value_saved);
+	}
+	double rayleigh(double mode)
+	{return random_seeded?random[random_source].rayleigh(mode): ::rayleigh(mode);}
+	double exponential(double density)
+	{return random_seeded?random[random_source].exponential(density): ::exponential(density);}
 
 	///////////////////////////////////////////////////////////////////////////
 	//Setting vehicle object name
@@ -65,6 +127,17 @@ public:
 	///////////////////////////////////////////////////////////////////////////
 	char *get_vname() {return name;}
 
+	///////////////////////////////////////////////////////////////////////////
+	//Writing and reading module-variable arrays and the state held by 'Cadac',
+	// used by 'save_state()' and 'load_state()' of the vehicle objects
+	//
+	//261017 Created
+	///////////////////////////////////////////////////////////////////////////
+	static void save_array(ostream &fsave,Variable *array,int size);
+	static void load_array(istream &fload,Variable *array,int size);
+	void save_cadac(ostream &fsave);
+	void load_cadac(istream &fload);
+
 	//////////////////////////executive functions /////////////////////////////
 	virtual void sizing_arrays()=0;
 	virtual void vehicle_array()=0;
@@ -87,6 +160,8 @@ public:
 	virtual Packet loading_packet_init(int num_hyper)=0;
 	virtual Packet loading_packet(int num_hyper)=0;
 	virtual void markov_noise(double sim_time,double int_step,int nmonte)=0;
+	virtual void save_state(ostream &fsave)=0;
+	virtual void load_state(istream &fload)=0;
 
 	//module functions -MOD
 	virtual void def_kinematics()=0;
@@ -280,6 +355,10 @@ protected:
 	//be written to the 'ploti.asc' files
 	int *hyper_plot_ind; int hyper_plot_count;
 
+	//compiled output plans of the 'ploti.asc' and 'stati.asc' files
+	Output_plan plot_plan;
+	Output_plan stat_plan;
+
 	//Indicator array pointing to the module-variable which are to 
 	//be written to 'combus' 'packets'
 	int *hyper_com_ind; int hyper_com_count;
@@ -319,6 +398,8 @@ public:
 	virtual Packet loading_packet_init(int num_hyper);
 	virtual Packet loading_packet(int num_hyper);
 	virtual void markov_noise(double sim_time,double int_step,int nmonte);
+	virtual void save_state(ostream &fsave);
+	virtual void load_state(istream &fload);
 
 	//module functions -MOD
 	virtual void def_aerodynamics();
@@ -13,6 +13,7 @@
 //130805 Compatible with MS Visual C++ V10, PZi
 //131025 Compatible with MS Visual C++ V12, PZi
 //151006 Modified for Book: GPS/INS/Star-Tracker, PZi
+//261017 Monte Carlo runs executed by worker processes
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "class_hierarchy.hpp"
@@ -23,7 +24,7 @@
 
 //acquiring the simmulation title
 void acquire_title_options(fstream &input,char *title,char *options,int &nmonte
-						   ,int &iseed,int &nmc);
+						   ,int &iseed,int &nmc,int &nworker);
 
 //acquiring the simulation run time
 double acquire_endtime(fstream &input);
@@ -46,20 +47,36 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			 double int_step,double scrn_step,double com_step,double traj_step,char *options,
 			 ofstream &ftabout,ofstream *plot_ostream_list,Packet *combus,int *status,
 			 int num_hyper,ofstream &ftraj,char *title,bool traj_merge,
-			 int nmonte,int nmc,ofstream *stat_ostream_list,bool *stati_write_term);
+			 int nmonte,int nmc,ofstream *stat_ostream_list,bool *stati_write_term,
+			 Checkpoint &checkpoint);
 
 // saving status of 'combus' vehicle objects
 void combus_status(Packet *combus,int *status,int num_vehicles);
 
+//executive state of a run, written to the checkpoint with the vehicle objects
+struct Run_state
+{
+	double sim_time;
+	double int_step;
+	double out_fact;
+	double scrn_time;
+	double plot_time;
+	double traj_time;
+	double com_time;
+	int nevents;		//events of all vehicle objects
+};
+
+//writing the scenario to the checkpoint file
+void save_checkpoint(Checkpoint &checkpoint,Run_state &run,int nmc,Vehicle &vehicle_list,int num_vehicles,
+					 Packet *combus,int *status,bool *stati_write_term);
+
+//resuming the scenario from the checkpoint file
+void load_checkpoint(Checkpoint &checkpoint,Run_state &run,int nmc,Vehicle &vehicle_list,int num_vehicles,
+					 Packet *combus,int *status,bool *stati_write_term);
+
 //getting timimg cycles for plotting, screen output and integration
 void acquire_timing(fstream &input,double &plot_step,double &scn_step,double &com_step,
-					double &traj_step,double &int_step);
-
-//merging the 'ploti.asc' files onto 'plot.asc' 
-void merge_plot_files(string *plot_file_list,int num_hyper,char *title);
-
-//merging the 'stati.asc' files onto 'stat.asc' 
-void merge_stat_files(string *stat_file_list,int num_hyper,char *title);
+					double &traj_step,double &int_step,Checkpoint &checkpoint);
 
 //writing 'combus' data on screen
 void comscrn_data(Packet *combus,int num_vehicles);
@@ -114,7 +131,13 @@ int main(void)
 	int nmonte=0; //number of MC runs to be executed
 	int nmc=0; //MC counter
 	int iseed; //seeding srand()
+	int nworker=0; //number of worker processes executing the MC runs
+	Monte_carlo mc; //executes the MC runs in worker processes
+	Checkpoint checkpoint; //snapshot of the scenario, 'save_time', 'save_event' and option 'y_restart'
 	bool one_traj_banner=true; //write just one banner on file 'traj.asc'
+	Output_writer writer; //binary output of the plot, stat and traj files, option 'y_binary'
+	Result_store plot_store; //plot data of all objects and runs on 'plot.asc', option 'y_merge'
+	Result_store stat_store; //stat data of all objects and runs on 'stat.asc', option 'y_merge'
 	bool *stati_write_term=NULL; //flag for writing impact data on 'stati.asc' once
 	Document *doc_hyper6=NULL;  //array for documenting HYPER6 module-variables of 'input.asc'
 	bool document_hyper6=false; //true if array doc_hyper6 was created
@@ -145,6 +168,9 @@ int main(void)
 	if(!fcopy){cout<<" *** Error: cannot open 'input_copy.asc' file *** \n";system("pause");exit(1);} 
 
 
+	//file of the snapshot of the scenario
+	checkpoint.file="checkpoint.bin";
+
 	///////////////////////////////////////////////////////////////////////////
 	////////////////////////// Monte Carlo Loop ///////////////////////////////
 	///////////////////////////////////////////////////////////////////////////
@@ -157,8 +183,21 @@ int main(void)
 		bool document_hyper=true; //write  to 'doc.asc' hyper module-variables only once
 		bool traj_merge=false; //flag used in writing 'time=-1' endblock on 'traj.asc'
 		
+		//seeding the run and collecting its output, if executed by a worker
+		mc.begin_run(nmc);
+
 		//aqcuiring title statement and option selections
-		acquire_title_options(input,title,options,nmonte,iseed,nmc);
+		acquire_title_options(input,title,options,nmonte,iseed,nmc,nworker);
+
+		//binary output of the 'traj' file, 'y_binary' on the OPTIONS line
+		if(!nmc&&strstr(options,"y_binary")&&strstr(options,"y_traj"))
+		{
+			ftraj.close();
+			remove("traj.asc");
+			ftraj.open("traj.bin",ios::binary);
+			if(!ftraj){cout<<" *** Error: cannot open 'traj.bin' file *** \n";exit(1);}
+			writer.attach(ftraj);
+		}
 
 		//initializing random number generator
 		if(!nmc) srand(iseed); 
@@ -174,7 +213,7 @@ int main(void)
 		order_modules(input,num_modules,module_list);
 		
 		//acquiring the time stepping
-		acquire_timing(input,plot_step,scrn_step,int_step,com_step,traj_step);
+		acquire_timing(input,plot_step,scrn_step,int_step,com_step,traj_step,checkpoint);
 
 		//acquiring number of vehicle objects from 'input.asc'
 		number_objects(input,num_vehicles,num_hyper);
@@ -217,6 +256,31 @@ int main(void)
 		//initialize 'stati_write_term' to true
 		for( ii=0;ii<num_vehicles;ii++) stati_write_term[ii]=true;
 
+		//collecting the rows of all objects and runs on 'plot.asc' and 'stat.asc', option 'y_merge'
+		if(!nmc&&strstr(options,"y_merge")&&!strstr(options,"y_binary"))
+		{
+			if(strstr(options,"y_plot"))
+			{
+				plot_store.open("plot.asc","plot.idx");
+				plot_store.attach(plot_ostream_list,num_vehicles);
+				mc.add_stream(plot_store.get_file());
+				mc.add_stream(plot_store.get_index());
+			}
+			if(strstr(options,"y_stat"))
+			{
+				stat_store.open("stat.asc","stat.idx");
+				stat_store.attach(stat_ostream_list,num_vehicles);
+				mc.add_stream(stat_store.get_file());
+				mc.add_stream(stat_store.get_index());
+			}
+		}
+
+		//starting the workers with the first run, if 'MONTE' gives their number
+		if(!nmc) mc.start(nmonte,nworker,iseed,ftabout,ftraj,plot_ostream_list,stat_ostream_list,num_vehicles);
+
+		//binary chunks written in the background, unless the runs are forked to workers
+		if(!nmc&&strstr(options,"y_binary")&&!mc.get_forking()) writer.start();
+
 		///////////////////////////////////////////////////////////////////////
 		////////////////// Initializing of each vehicle object  ///////////////
 		///////////////////////////////////////////////////////////////////////
@@ -237,26 +301,34 @@ int main(void)
 			//getting the name of the type of vehicle
 			strcpy(vehicle_name,vehicle_list[i]->get_vname());
 
+			//seeding the noise streams of the vehicle, if the runs are seeded by run number
+			if(mc.get_seeded()) vehicle_list[i]->seed_random(iseed,nmc,i);
+
 			//vehicle data and tables read from 'input.asc' 
+			vehicle_list[i]->set_random_source(RANDOM_INPUT);
 			vehicle_list[i]->vehicle_data(input,nmonte);
 
 			//executing initialization computations -MOD: insert here new module initialization function		
 			for (int j=0;j<num_modules;j++)
 			{
-				if((module_list[j].name=="kinematics")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_kinematics(sim_time,int_step);
-				else if((module_list[j].name=="environment")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_environment();
-				else if((module_list[j].name=="aerodynamics")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_aerodynamics();
-				else if((module_list[j].name=="propulsion")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_propulsion();
-				else if((module_list[j].name=="ins")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_ins();
-				else if((module_list[j].name=="newton")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_newton();
-				else if((module_list[j].name=="euler")&&(module_list[j].initialization=="init"))
-					vehicle_list[i]->init_euler();
+				vehicle_list[i]->set_random_source(module_list[j].id);
+				if(module_list[j].init)
+					switch(module_list[j].id){
+					case MOD_KINEMATICS:
+						vehicle_list[i]->init_kinematics(sim_time,int_step);break;
+					case MOD_ENVIRONMENT:
+						vehicle_list[i]->init_environment();break;
+					case MOD_AERODYNAMICS:
+						vehicle_list[i]->init_aerodynamics();break;
+					case MOD_PROPULSION:
+						vehicle_list[i]->init_propulsion();break;
+					case MOD_INS:
+						vehicle_list[i]->init_ins();break;
+					case MOD_NEWTON:
+						vehicle_list[i]->init_newton();break;
+					case MOD_EULER:
+						vehicle_list[i]->init_euler();break;
+					}
 			}
 			//writing banner to screen and file 'tabout.asc'
 			if(!strcmp(vehicle_name,"HYPER6")&&one_screen_banner)
@@ -296,15 +368,24 @@ int main(void)
 
 						//building names for plot files
 						sprintf(index,"%i",i+1);
-						plotiasc="plot"+string(index)+".asc"; //using Standard Library string constructor
+						plotiasc="plot"+string(index)+(strstr(options,"y_binary")?".bin":".asc"); //using Standard Library string constructor
 						plot_file_list[i]=plotiasc;
 						name=plotiasc.c_str(); //using string member function to convert to char array 
 
 						//creating output stream list 'plot_ostream_list[i]', each will write on file 'ploti.asc'
-						plot_ostream_list[i].open(name); //'name' must be 'char' type
+						if(strstr(options,"y_binary"))
+						{
+							plot_ostream_list[i].open(name,ios::binary);
+							writer.attach(plot_ostream_list[i]);
+						}
+						else if(!plot_store.get_open())
+							plot_ostream_list[i].open(name); //'name' must be 'char' type
 
 						//writing banner on 'ploti.asc'
-						vehicle_list[i]->plot_banner(plot_ostream_list[i],title);				}
+						vehicle_list[i]->plot_banner(plot_ostream_list[i],title);
+
+						//with option 'y_merge', the banner of the first object heads 'plot.asc'
+						plot_store.write_banner(plot_ostream_list[i],title);				}
 				}
 
 				//creating output stream objects in 'stat_ostream_list[i]' for every file "stati.asc"
@@ -319,15 +400,24 @@ int main(void)
 
 						//building names for stat files
 						sprintf(index,"%i",i+1);
-						statiasc="stat"+string(index)+".asc"; //using Standard Library string constructor
+						statiasc="stat"+string(index)+(strstr(options,"y_binary")?".bin":".asc"); //using Standard Library string constructor
 						stat_file_list[i]=statiasc;
 						name=statiasc.c_str(); //using string member function to convert to char array 
 
 						//creating output stream list 'stat_ostream_list[i]', each will write on file 'stati.asc'
-						stat_ostream_list[i].open(name); //'name' must be 'char' type
+						if(strstr(options,"y_binary"))
+						{
+							stat_ostream_list[i].open(name,ios::binary);
+							writer.attach(stat_ostream_list[i]);
+						}
+						else if(!stat_store.get_open())
+							stat_ostream_list[i].open(name); //'name' must be 'char' type
 
 						//writing banner on 'stati.asc'
-						vehicle_list[i]->plot_banner(stat_ostream_list[i],title);				}
+						vehicle_list[i]->plot_banner(stat_ostream_list[i],title);
+
+						//with option 'y_merge', the banner of the first object heads 'stat.asc'
+						stat_store.write_banner(stat_ostream_list[i],title);				}
 				}
 
 				//composing documentation of 'round6','hyper' module-variables
@@ -379,11 +469,30 @@ int main(void)
 		/////////////////////// Simulation Execution //////////////////////////
 		///////////////////////////////////////////////////////////////////////	
 
-		execute(vehicle_list,module_list,sim_time,
-				 end_time,num_vehicles,num_modules,plot_step,
-				 int_step,scrn_step,com_step,traj_step,options,ftabout,
-				 plot_ostream_list,combus,status,num_hyper,ftraj,title,
-				 traj_merge,nmonte,nmc,stat_ostream_list,stati_write_term);
+		//writing the pending binary rows, so a worker does not inherit them
+		writer.sync();
+
+		//the main process hands the run to a worker and initializes the next run
+		if(!mc.fork_run(nmc))
+		{
+			//seed of the run, for runs resuming from the checkpoint
+			checkpoint.iseed=iseed;
+			checkpoint.seeded=mc.get_seeded();
+
+			execute(vehicle_list,module_list,sim_time,
+					 end_time,num_vehicles,num_modules,plot_step,
+					 int_step,scrn_step,com_step,traj_step,options,ftabout,
+					 plot_ostream_list,combus,status,num_hyper,ftraj,title,
+					 traj_merge,nmonte,nmc,stat_ostream_list,stati_write_term,checkpoint);
+
+			//appending the rows of the run to 'plot.asc' and 'stat.asc', option 'y_merge'
+			plot_store.end_run(nmc);
+			stat_store.end_run(nmc);
+
+			//a worker hands its output to the main process and exits
+			writer.sync();
+			mc.end_run();
+		}
 
 		//Deallocate dynamic memory
 		delete [] module_list;
@@ -396,6 +505,9 @@ int main(void)
 	}	// at this point the destructor of the object 'Vehicle vehicle_list' is called 
 	while(nmc<nmonte); 
 
+	//appending the output of the remaining runs in run order
+	mc.finish();
+
 	///////////////////////////////////////////////////////////////////////////	
 	///////////////////////// End of Monte Carlo Loop /////////////////////////
 	///////////////////////////////////////////////////////////////////////////	
@@ -406,6 +518,13 @@ int main(void)
 	input.close();
 	fcopy.close();
 
+	//writing the pending binary rows of the plot, stat and traj files
+	writer.sync();
+
+	//closing 'plot.asc' and 'stat.asc', restoring the streams of the objects
+	plot_store.close();
+	stat_store.close();
+
 	//Close file streams
 	int f(0);
 	ftabout.close();
@@ -414,17 +533,6 @@ int main(void)
 	for(f=0;f<num_vehicles;f++) stat_ostream_list[f].close();
 	ftraj.close();
 
-	//merging 'ploti.asc' files into 'plot.asc'
-	if(strstr(options,"y_merge")&&strstr(options,"y_plot"))
-	{
-		merge_plot_files(plot_file_list,num_hyper,title);
-	}
-	//merging 'stati.asc' files into 'stat.asc'm using 'merge_plot_data' function
-	//adding at the end: time=-1 and dummy block of data
-	if(strstr(options,"y_merge")&&strstr(options,"y_stat"))
-	{
-		merge_stat_files(stat_file_list,num_hyper,title);
-	}
 	//Deallocate dynamic memory
 	delete [] plot_ostream_list;
 	delete [] plot_file_list;
@@ -476,17 +584,22 @@ int main(void)
 //				*stat_ostream_list = output file-steam list of 'stati.asc' for each individual hyper 
 //								hyper object
 //				*stati_write_term = flag for writing impact data on 'stati.asc' once
+//				&checkpoint = snapshot of the scenario, see 'Checkpoint'
 //				  				
 //011128 Created by Peter H Zipfel
 //030415 Adopted for HYPER simulation, PZi
 //040315 Calculating event_time, PZi
+//261017 Module dispatch on 'Module_id' instead of name comparisons
+//261017 Modules executed 'every n' integration steps
+//261017 Snapshot of the scenario and restart from it, see 'Checkpoint'
 ///////////////////////////////////////////////////////////////////////////////
 void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			 double end_time,int num_vehicles,int num_modules,double plot_step,
 			 double int_step,double scrn_step,double com_step,double traj_step,char *options,
 			 ofstream &ftabout,ofstream *plot_ostream_list,Packet *combus,int *status,
 			 int num_hyper,ofstream &ftraj,char *title,bool traj_merge,
-			 int nmonte,int nmc,ofstream *stat_ostream_list,bool *stati_write_term)
+			 int nmonte,int nmc,ofstream *stat_ostream_list,bool *stati_write_term,
+			 Checkpoint &checkpoint)
 {
 	double scrn_time(0);
 	double plot_time(0);
@@ -497,10 +610,46 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 	bool increment_plot_time(false);
 	bool plot_merge(false);
 	double out_fact(0);
+	Run_state run; //executive state written to and read from the checkpoint
+	int nevents(0); //events of all vehicle objects, see 'Checkpoint'
+
+	//snapshot taken once by the first run, unless the runs resume from one
+	bool restart=strstr(options,"y_restart")!=NULL;
+	bool snapshot=!restart&&!nmc&&(checkpoint.save_time>0||checkpoint.save_event>0);
+
+	//resuming the scenario from the checkpoint, option 'y_restart'
+	if(restart)
+	{
+		load_checkpoint(checkpoint,run,nmc,vehicle_list,num_vehicles,combus,status,stati_write_term);
+		sim_time=run.sim_time;
+		int_step=run.int_step;
+		out_fact=run.out_fact;
+		scrn_time=run.scrn_time;
+		plot_time=run.plot_time;
+		traj_time=run.traj_time;
+		com_time=run.com_time;
+		nevents=run.nevents;
+	}
 
 	//integration loop
 	while (sim_time<=(end_time+int_step))
 	{
+		//taking the snapshot at 'save_time' or after 'save_event' events of the scenario
+		if(snapshot&&((checkpoint.save_time>0&&sim_time>checkpoint.save_time-EPS)
+			||(checkpoint.save_event>0&&nevents>=checkpoint.save_event)))
+		{
+			snapshot=false;
+			run.sim_time=sim_time;
+			run.int_step=int_step;
+			run.out_fact=out_fact;
+			run.scrn_time=scrn_time;
+			run.plot_time=plot_time;
+			run.traj_time=traj_time;
+			run.com_time=com_time;
+			run.nevents=nevents;
+			save_checkpoint(checkpoint,run,nmc,vehicle_list,num_vehicles,combus,status,stati_write_term);
+		}
+
 		//vehicle loop
 		for (int i=0;i<num_vehicles;i++)
 		{
@@ -510,53 +659,65 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			//watching for the next event			
 			vehicle_list[i]->event(options);
 
-			//fixing 'event_epoch' and initializing 'event_time'
+			//fixing 'event_epoch' and initializing 'event_time' at the (located) event
+			//the event's new values took effect at the end of this step, not at the crossing
 			if(vehicle_list[i]->event_epoch)
-				vehicle_list[i]->event_time=0;
+				vehicle_list[i]->event_time=vehicle_list[i]->event_lag*int_step;
 
 			//continue only if vehicle is alive 
 			int health=combus[i].get_status();
 			if(health==1)
 			{
 				//refreshing Markov variables
+				vehicle_list[i]->set_random_source(RANDOM_MARKOV);
 				vehicle_list[i]->markov_noise(sim_time,int_step,nmonte);
 
 				//module loop -MOD: insert here new module function
+				//modules executed 'every n' steps are skipped in between, holding their outputs,
+				// and step over 'n*int_step'
 				for(int j=0;j<num_modules;j++)
 				{
-					if(module_list[j].name=="kinematics")
-						vehicle_list[i]->kinematics(sim_time,vehicle_list[i]->event_time,int_step,out_fact);
-					else if(module_list[j].name=="newton")
-						vehicle_list[i]->newton(int_step);
-					else if(module_list[j].name=="euler")
-						vehicle_list[i]->euler(int_step);
-					else if(module_list[j].name=="environment")
-						vehicle_list[i]->environment(int_step);
-					else if(module_list[j].name=="aerodynamics")
-						vehicle_list[i]->aerodynamics(int_step);
-					else if(module_list[j].name=="forces")
-						vehicle_list[i]->forces();
-					else if(module_list[j].name=="propulsion")
-						vehicle_list[i]->propulsion(int_step);
-					else if(module_list[j].name=="actuator")
-						vehicle_list[i]->actuator(int_step);
-					else if(module_list[j].name=="tvc")
-						vehicle_list[i]->tvc(int_step);
-					else if(module_list[j].name=="control") 
-						vehicle_list[i]->control(int_step);
-					else if(module_list[j].name=="ins")
-						vehicle_list[i]->ins(int_step);
-					else if(module_list[j].name=="guidance")
-						vehicle_list[i]->guidance(int_step);
-					else if(module_list[j].name=="gps")
-						vehicle_list[i]->gps(int_step);
-					else if(module_list[j].name=="startrack")
-						vehicle_list[i]->startrack();
-					else if(module_list[j].name=="rcs")
-						vehicle_list[i]->rcs();
-					else if(module_list[j].name=="intercept")
-						vehicle_list[i]->intercept(combus,num_vehicles,vehicle_slot,int_step,title);
+					if(vehicle_list[i]->nstep%module_list[j].divisor) continue;
+					double module_step=int_step*module_list[j].divisor;
+
+					vehicle_list[i]->set_random_source(module_list[j].id);
+					switch(module_list[j].id){
+					case MOD_KINEMATICS:
+						vehicle_list[i]->kinematics(sim_time,vehicle_list[i]->event_time,int_step,out_fact);break;
+					case MOD_NEWTON:
+						vehicle_list[i]->newton(module_step);break;
+					case MOD_EULER:
+						vehicle_list[i]->euler(module_step);break;
+					case MOD_ENVIRONMENT:
+						vehicle_list[i]->environment(module_step);break;
+					case MOD_AERODYNAMICS:
+						vehicle_list[i]->aerodynamics(module_step);break;
+					case MOD_FORCES:
+						vehicle_list[i]->forces();break;
+					case MOD_PROPULSION:
+						vehicle_list[i]->propulsion(module_step);break;
+					case MOD_ACTUATOR:
+						vehicle_list[i]->actuator(module_step);break;
+					case MOD_TVC:
+						vehicle_list[i]->tvc(module_step);break;
+					case MOD_CONTROL:
+						vehicle_list[i]->control(module_step);break;
+					case MOD_INS:
+						vehicle_list[i]->ins(module_step);break;
+					case MOD_GUIDANCE:
+						vehicle_list[i]->guidance(module_step);break;
+					case MOD_GPS:
+						vehicle_list[i]->gps(module_step);break;
+					case MOD_STARTRACK:
+						vehicle_list[i]->startrack();break;
+					case MOD_RCS:
+						vehicle_list[i]->rcs();break;
+					case MOD_INTERCEPT:
+						vehicle_list[i]->intercept(combus,num_vehicles,vehicle_slot,module_step,title);break;
+					}
 				} //end of module loop
+				//counting the integration steps of the vehicle
+				vehicle_list[i]->nstep++;
 
 				//preserving 'health' status of vehicle objects
 				combus_status(combus,status,num_vehicles);
@@ -569,6 +730,9 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 
 			} //end of active vehicle loop
 
+			//counting the events of the scenario, see 'Checkpoint'
+			if(vehicle_list[i]->event_epoch) nevents++;
+
 			//tracking time elapsed during event
 			vehicle_list[i]->event_time+=int_step;
 
@@ -654,5 +818,78 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 		traj_data(ftraj,combus,num_vehicles,traj_merge);
 	}
 } 
+///////////////////////////////////////////////////////////////////////////////
+//Writing the scenario to the checkpoint file, see 'Checkpoint'
+//Number of vehicle objects, seed and run number of the run, executive state 'run',
+// then for each vehicle object: status, write-flag to 'stati.asc', 'combus'
+// data and the state written by 'save_state()'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void save_checkpoint(Checkpoint &checkpoint,Run_state &run,int nmc,Vehicle &vehicle_list,int num_vehicles,
+					 Packet *combus,int *status,bool *stati_write_term)
+{
+	ofstream fsave(checkpoint.file,ios::binary);
+	if(!fsave){cerr<<" *** Error: cannot open '"<<checkpoint.file<<"' file *** \n";system("pause");exit(1);}
+
+	fsave.write((char *)&num_vehicles,sizeof(num_vehicles));
+	fsave.write((char *)&checkpoint.iseed,sizeof(checkpoint.iseed));
+	fsave.write((char *)&nmc,sizeof(nmc));
+	fsave.write((char *)&run,sizeof(run));
+	for(int i=0;i<num_vehicles;i++)
+	{
+		int health=combus[i].get_status();
+		fsave.write((char *)&health,sizeof(health));
+		fsave.write((char *)&status[i],sizeof(int));
+		fsave.write((char *)&stati_write_term[i],sizeof(bool));
+		Cadac::save_array(fsave,combus[i].get_data(),combus[i].get_ndata());
+		vehicle_list[i]->save_state(fsave);
+	}
+	if(!fsave){cerr<<" *** Error: cannot write '"<<checkpoint.file<<"' file *** \n";system("pause");exit(1);}
 
+	cout<<" *** Checkpoint at time = "<<run.sim_time<<" sec written to '"<<checkpoint.file<<"' *** \n";
+}
+///////////////////////////////////////////////////////////////////////////////
+//Resuming the scenario from the checkpoint file, option 'y_restart'
+//The vehicle objects and 'combus' are set up from 'input.asc' as for a new run,
+// the checkpoint then overwrites their state
+//Runs other than the saved one branch off: their seeded noise streams continue
+// with the key of the run, see 'Cadac::resume_random()'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+void load_checkpoint(Checkpoint &checkpoint,Run_state &run,int nmc,Vehicle &vehicle_list,int num_vehicles,
+					 Packet *combus,int *status,bool *stati_write_term)
+{
+	int num(0);
+	int iseed(0);
+	int nmc_saved(0);
+
+	ifstream fload(checkpoint.file,ios::binary);
+	if(!fload){cerr<<" *** Error: cannot open '"<<checkpoint.file<<"' file *** \n";system("pause");exit(1);}
+
+	fload.read((char *)&num,sizeof(num));
+	fload.read((char *)&iseed,sizeof(iseed));
+	fload.read((char *)&nmc_saved,sizeof(nmc_saved));
+	if(num!=num_vehicles)
+		{cerr<<"*** Error: checkpoint does not match 'input.asc' *** \n";system("pause");exit(1);}
+	fload.read((char *)&run,sizeof(run));
+	for(int i=0;i<num_vehicles;i++)
+	{
+		int health(0);
+		fload.read((char *)&health,sizeof(health));
+		combus[i].set_status(health);
+		fload.read((char *)&status[i],sizeof(int));
+		fload.read((char *)&stati_write_term[i],sizeof(bool));
+		Cadac::load_array(fload,combus[i].get_data(),combus[i].get_ndata());
+		vehicle_list[i]->load_state(fload);
+	}
+	if(!fload){cerr<<" *** Error: '"<<checkpoint.file<<"' file is incomplete *** \n";system("pause");exit(1);}
 
+	if(checkpoint.seeded)
+	{
+		bool branch=(iseed!=checkpoint.iseed)||(nmc!=nmc_saved);
+		for(int i=0;i<num_vehicles;i++)
+			vehicle_list[i]->resume_random(checkpoint.iseed,nmc,i,branch);
+	}
+}
@@ -37,6 +37,7 @@ double const NMILES=5.399568e-4;		//conversion factor	m->nm
 //sizing of arrays
 int const CHARN=50;						//character numbers in variable names
 int const CHARL=220;					//character numbers in a line
+int const NOUTPUT_CHUNK=8192;			//values per chunk of binary output, option 'y_binary'
 //*** verify the following array sizes. If too small, dynamic memory allocation will fail! ***
 int const NROUND6=300;					//size of 'round6' module-variable array
 int const NHYPER=950;					//size of 'hyper' module-variable array
@@ -127,6 +127,7 @@ void Hyper::def_gps()
 //
 //040105 Created by Peter H Zipfel
 //141125 Constellation update to: Yuma Almanac Week 787 (21 Sep 2014), PZi
+//261017 Constants also set once when resumed from 'Checkpoint' past 'mgps=1'
 ///////////////////////////////////////////////////////////////////////////////
 	
 void Hyper::gps(double int_step)
@@ -150,6 +151,7 @@ void Hyper::gps(double int_step)
 	//filter
 	static Matrix FF(8,8); //constant, same for all objects, -> static ok
 	static Matrix PHI(8,8);//constant, same for all objects, -> static ok
+	static bool constants(false); //'sv_init_data', 'FF' and 'PHI' are set
 	Matrix XH(8,1); //local
 	Matrix RR(8,8); //local
 	Matrix QQ(8,8); //local
@@ -285,21 +287,12 @@ void Hyper::gps(double int_step)
 		return;
 	}
 
-	//GPS initializations
-	if(mgps==1)
+	//GPS constants, set at initialization, or once by a run resumed from 'Checkpoint'
+	if(mgps==1||!constants)
 	{
 		//24 SVs initialization
 		gps_sv_init(sv_init_data,rsi,wsi,incl);
 
-		//filter initialization
-		//covariance matrix
-		for(i=0;i<3;i++){
-			PP.assign_loc(i,i,pow(ppos*(1+factp),2));
-			PP.assign_loc(i+3,i+3,pow(pvel*(1+factp),2));
-		}
-		PP.assign_loc(6,6,pow(pclockb*(1+factp),2));
-		PP.assign_loc(7,7,pow(pclockf*(1+factp),2));
-
 		//fundamental dynamic matrix of filter - constant throughout
 		FF.assign_loc(0,3,1);
 		FF.assign_loc(1,4,1);
@@ -311,6 +304,20 @@ void Hyper::gps(double int_step)
 		Matrix EYE(8,8);
 		PHI=EYE.identity()+FF*int_step+FF*FF*(int_step*int_step/2);
 
+		constants=true;
+	}
+	//GPS initializations
+	if(mgps==1)
+	{
+		//filter initialization
+		//covariance matrix
+		for(i=0;i<3;i++){
+			PP.assign_loc(i,i,pow(ppos*(1+factp),2));
+			PP.assign_loc(i+3,i+3,pow(pvel*(1+factp),2));
+		}
+		PP.assign_loc(6,6,pow(pclockb*(1+factp),2));
+		PP.assign_loc(7,7,pow(pclockf*(1+factp),2));
+
 		/*/diagnostic - start
 		cout<<"PP = \n";
 		PP.print();
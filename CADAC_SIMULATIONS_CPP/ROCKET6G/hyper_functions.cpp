@@ -574,8 +574,8 @@ void Hyper::vehicle_data(fstream &input,int nmonte)
 				nmarkov++;						
 			}
 
-			//reading events into 'Event' pointer array 'event_ptr_list' of size NEVENT
-			if(!strcmp(read,"IF"))
+			//reading events ('IF' in sequence, 'WHEN' pending) into 'Event' pointer array 'event_ptr_list' of size NEVENT
+			if(!strcmp(read,"IF")||!strcmp(read,"WHEN"))
 			{
 				event_total++;
 				//reading name of watch variable
@@ -600,6 +600,8 @@ void Hyper::vehicle_data(fstream &input,int nmonte)
 				event_ptr_list[e]->set_variable(variable);
 				event_ptr_list[e]->set_value(value);
 				event_ptr_list[e]->set_operator(oper);
+				event_ptr_list[e]->set_pending(!strcmp(read,"WHEN"));
+				event_ptr_list[e]->compile();
 				input.getline(line_clear,CHARL,'\n');
 
 				//acquiring indices and values of event variables
@@ -1007,114 +1009,21 @@ void Hyper::plot_index_arrays()
 //
 //010116 Created by Peter Zipfel
 //030404 Adapted to HYPER6 simulation, PZi
+//261017 Written from the compiled output plan
 ///////////////////////////////////////////////////////////////////////////////
 void Hyper::plot_data(ofstream &fplot,bool merge)
 {
-
-	int index(0);
-	char *integer=NULL;
-	char *vector=NULL;
-	Matrix VEC(3,1);
-	int k(0);
-	int i(0);
-	
-	fplot.setf(ios::left);
-
-	//writing to 'ploti.asc' the variables from the 'Round6' class
-	for(i=0;i<round6_plot_count;i++)
-	{
-		index=round6_plot_ind[i];
-		//checking for integers
-		integer=round6[index].get_type();
-		vector=round6[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			//casting integer to real variable
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<(double) round6[index].integer();			
-			k++;
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=round6[index].vec();
-
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++; 
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
-			k++;
-		}
-		else
-		{
-			//real variables
-			if(merge&&(index==0))
-				//for merging files, time at last entry must be '-1'
-			{
-				fplot.width(16);
-				fplot<<"-1.0";
-				k++;
-			}
-			else
-			{
-				if(k>4){k=0;fplot<<'\n';}
-				fplot.width(16);
-				fplot<<round6[index].real(); 
-				k++;
-			}
-		}
-	}
-	//writing to 'ploti.asc' the variables from the 'Hyper' class
-	for(i=0;i<hyper_plot_count;i++)
+	//compiling the output plan of the 'Round6' and 'Hyper' variables at the first output
+	if(!plot_plan.get_compiled())
 	{
-		index=hyper_plot_ind[i];
-		//checking for integers
-		integer=hyper[index].get_type();
-		vector=hyper[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			//casting integer to real variable
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<(double) hyper[index].integer();			
-			k++;
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=hyper[index].vec();
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(0,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<VEC.get_loc(2,0);
-			k++;
-		}
-		else
-		{
-			//real variables
-			if(k>4){k=0;fplot<<'\n';}
-			fplot.width(16);
-			fplot<<hyper[index].real();
-			k++;
-		}
+		int n=plot_plan.add_array(round6);
+		for(int i=0;i<round6_plot_count;i++) plot_plan.add(n,round6_plot_ind[i]);
+		n=plot_plan.add_array(hyper);
+		for(int i=0;i<hyper_plot_count;i++) plot_plan.add(n,hyper_plot_ind[i]);
 	}
-	fplot<<"\n";
+	//writing to 'ploti.asc' the variables of the plan
+	plot_plan.gather();
+	plot_plan.write(fplot,merge);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Watching for and executing events
@@ -1128,16 +1037,14 @@ void Hyper::plot_data(ofstream &fplot,bool merge)
 //010125 Created by Peter Zipfel
 //011026 Making event_epoch a 'Hyper' member for 'stat.asc' file usage, PZi
 //030404 Adapted to HYPER6 simulation, PZi
+//261017 Pending 'WHEN' events, compiled criteria, located crossings
 ///////////////////////////////////////////////////////////////////////////////
 void Hyper::event(char *options)
 {
 	Variable *watch_variable_ptr=NULL;
-	double current_value=0;
-	int current_value_int=0;
 	double crit_value=0;
-	int crit_value_int=0;
 	char oper;
-	char *intest=NULL;
+	int e(0);
 
 	//initializing event flag ('Hyper' member)
 	event_epoch=false;
@@ -1146,59 +1053,28 @@ void Hyper::event(char *options)
 	//or if all events have already occurred
 	if(!event_total)return;
 	
-	//getting watch variable's current value and critical value
-	watch_variable_ptr=event_ptr_list[nevent]->get_variable();
-	crit_value=event_ptr_list[nevent]->get_value();
-
-	//testing for integer
-	intest=watch_variable_ptr->get_type();
-	if(!strcmp(intest,"int"))
-	{
-		current_value_int=watch_variable_ptr->integer();
-		crit_value_int=(int)crit_value;
-	}
-	else
-		current_value=watch_variable_ptr->real();
-	//getting relational operator
-	oper=event_ptr_list[nevent]->get_operator();
-
-	//checking if event occurred
-	if(oper=='<')
+	//testing the next 'IF' event in sequence and all pending 'WHEN' events
+	//the first criterion satisfied fires; the others are tested nevertheless
+	// to keep their previous values current for locating crossings
+	bool locate=strstr(options,"y_crossing")!=NULL;
+	bool sequence=true;
+	for(int n=0;n<event_total;n++)
 	{
-		if(!strcmp(intest,"int"))
+		if(event_ptr_list[n]->get_occurred()) continue;
+		if(!event_ptr_list[n]->get_pending())
 		{
-			if(current_value_int<crit_value_int)
-				event_epoch=true;
+			if(!sequence) continue;
+			sequence=false;
 		}
-		else
+		double lag(0);
+		if(event_ptr_list[n]->test(locate,lag)&&!event_epoch)
 		{
-			if(current_value<crit_value)
-				event_epoch=true;
-		}
-	}
-	else if(oper=='=')
-	{
-		if(!strcmp(intest,"int"))
-		{
-			if(current_value_int==crit_value_int)
-				event_epoch=true;
-		}
-		else
-		{
-			if(current_value==crit_value)event_epoch=true;
-		}
-	}
-	else if(oper=='>')
-	{
-		if(!strcmp(intest,"int"))
-		{
-			if(current_value_int>crit_value_int)
-				event_epoch=true;
-		}
-		else
-		{
-			if(current_value>crit_value)
-				event_epoch=true;
+			event_epoch=true;
+			e=n;
+			event_lag=lag;
+			watch_variable_ptr=event_ptr_list[e]->get_variable();
+			crit_value=event_ptr_list[e]->get_value();
+			oper=event_ptr_list[e]->get_operator();
 		}
 	}
 
@@ -1217,13 +1093,13 @@ void Hyper::event(char *options)
 		int value_int(0);
 		int i(0);
 
-		round6_index_list=event_ptr_list[nevent]->get_round6_indices();
-		round6_value_list=event_ptr_list[nevent]->get_round6_values();
-		round6_size=event_ptr_list[nevent]->get_round6_size();
+		round6_index_list=event_ptr_list[e]->get_round6_indices();
+		round6_value_list=event_ptr_list[e]->get_round6_values();
+		round6_size=event_ptr_list[e]->get_round6_size();
 
-		hyper_index_list=event_ptr_list[nevent]->get_hyper_indices();
-		hyper_value_list=event_ptr_list[nevent]->get_hyper_values();
-		hyper_size=event_ptr_list[nevent]->get_hyper_size();
+		hyper_index_list=event_ptr_list[e]->get_hyper_indices();
+		hyper_value_list=event_ptr_list[e]->get_hyper_values();
+		hyper_size=event_ptr_list[e]->get_hyper_size();
 
 		for(i=0;i<round6_size;i++)
 		{
@@ -1257,10 +1133,11 @@ void Hyper::event(char *options)
 		char *name=watch_variable_ptr->get_name();
 		if(strstr(options,"y_events"))
 		{
-			cout<<" *** Event #"<<nevent+1<<'\t'<<hyper6_name<<'\t'<<"time = "<<time
+			cout<<" *** Event #"<<e+1<<'\t'<<hyper6_name<<'\t'<<"time = "<<time
 				<<"\tsec;  criteria:  "<<name<<" "<<oper<<" "<<crit_value<<"\t***\n";
 		}
-		//increment event number
+		//marking the event, counting the events occurred
+		event_ptr_list[e]->set_occurred();
 		nevent++;
 		//reset 'event_total' to zero after last event has occured
 		if(nevent==event_total)event_total=0;	
@@ -1537,105 +1414,26 @@ void Hyper::markov_noise(double time,double int_step,int nmonte)
 //
 //011029 Created by Peter Zipfel
 //030404 Adapted to HYPER6 simulation, PZi
+//261017 Written from the compiled output plan
 ///////////////////////////////////////////////////////////////////////////////
 void Hyper::stat_data(ofstream &fstat,int nmc,int vehicle_slot)
 {
-	int index(0);
-	char *integer=NULL;
-	char *vector=NULL;
-	Matrix VEC(3,1);
-	int k(0);
-	int i(0);
-	
-	fstat.setf(ios::left);
-
-	//writing to 'stati.asc' the variables from the 'Round6' class
-	for(i=0;i<round6_plot_count;i++)
-	{
-		index=round6_plot_ind[i];
-		//checking for integers
-		integer=round6[index].get_type();
-		vector=round6[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			//casting integer to real variable
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<(double) round6[index].integer();			
-			k++;
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=round6[index].vec();
-
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(0,0);
-			k++; 
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(2,0);
-			k++;
-		}
-		else
-		{
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<round6[index].real(); 
-			k++;
-		}
-	}
-	//writing to 'stati.asc' the variables from the 'Hyper' class
-	for(i=0;i<hyper_plot_count;i++)
+	//compiling the output plan of the 'Round6' and 'Hyper' variables at the first output
+	if(!stat_plan.get_compiled())
 	{
-		index=hyper_plot_ind[i];
-		//checking for integers
-		integer=hyper[index].get_type();
-		vector=hyper[index].get_name();
-		if(!strcmp(integer,"int"))
-		{
-			//casting integer to real variable
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<(double) hyper[index].integer();			
-			k++;
-
-		}
-		//checking vor vectors
-		else if(isupper(vector[0]))
-		{
-			VEC=hyper[index].vec();
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(0,0);
-			k++;
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(1,0);
-			k++;
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<VEC.get_loc(2,0);
-			k++;
-		}
-		else
-		{
-			//real variables
-			if(k>4){k=0;fstat<<'\n';}
-			fstat.width(16);
-			fstat<<hyper[index].real();
-			k++;
-		}
+		int n=stat_plan.add_array(round6);
+		for(int i=0;i<round6_plot_count;i++) stat_plan.add(n,round6_plot_ind[i]);
+		n=stat_plan.add_array(hyper);
+		for(int i=0;i<hyper_plot_count;i++) stat_plan.add(n,hyper_plot_ind[i]);
+		stat_plan.add_tag();
+		stat_plan.add_tag();
 	}
-	fstat.width(16);fstat<<nmc+1;
-	fstat.width(16);fstat<<vehicle_slot+1;
-
-	fstat<<"\n";
+	//writing to 'stati.asc' the variables of the plan and the identification integers |MC#||object#|
+	double *row=stat_plan.gather();
+	int ncolumn=stat_plan.get_ncolumn();
+	row[ncolumn-2]=nmc+1;
+	row[ncolumn-1]=vehicle_slot+1;
+	stat_plan.write(fstat,false);
 }
 ///////////////////////////////////////////////////////////////////////////////
 //Reading tables from table decks
@@ -1654,6 +1452,7 @@ void Hyper::stat_data(ofstream &fstat,int nmc,int vehicle_slot)
 //030721 Created by Peter H Zipfel
 //031104 Corrected table diagnostic, PZi
 //060426 Corrected line 1722 (replaced 'if else' by 'if'), PZi
+//261017 Tables shared with vehicles reading the same file
 ///////////////////////////////////////////////////////////////////////////////
 void Hyper::read_tables(char *file_name,Datadeck &datatable)
 {
@@ -1668,6 +1467,9 @@ void Hyper::read_tables(char *file_name,Datadeck &datatable)
 	int var_dim[3]={1,1,1,};
 	int tt(0);
 
+	//taking the tables of another vehicle that has read the file already
+	if(datatable.share(file_name)) return;
+
 	//opening aero-deck file stream
 	ifstream tbl_stream(file_name);
 
@@ -1787,6 +1589,9 @@ void Hyper::read_tables(char *file_name,Datadeck &datatable)
 		
 	}//end of 'for' loop, finished loading all tables
 
+	//offering the tables to vehicles reading the same file
+	datatable.keep(file_name);
+
 	/*/////////////////////// DIAGNOSTICS //////////////////////////////////////
 	//Diagnostic display of tables on console
 	int num_tables=datatable.get_capacity();
@@ -61,6 +61,7 @@ void Hyper::def_startrack()
 //* Calculates the INS tilt updates and sends them to the INS    
 //
 //040212 Created by Peter H Zipfel
+//261017 Star catalog also loaded once when resumed from 'Checkpoint' past 'mstar=1'
 ///////////////////////////////////////////////////////////////////////////////
 	
 void Hyper::startrack()
@@ -68,6 +69,7 @@ void Hyper::startrack()
 	//local variables
 	static double star_data[75];
 	static string star_names[25];
+	static bool catalog(false); //'star_data' and 'star_names' are loaded
 	double usii_triad[12]; //star triad inertial coord and star slot#
 	double dtime_star(0);
 	double time_star(0);
@@ -126,12 +128,15 @@ void Hyper::startrack()
 	Matrix SBII=round6[235].vec();
 	Matrix TBIC=hyper[315].mat();
 	//-----------------------------------------------------------------------------
+	//Loading star catalog at initialization, or once by a run resumed from 'Checkpoint'
+	if(mstar==1||(mstar&&!catalog))
+	{
+		star_init(star_data,star_names);
+		catalog=true;
+	}
 	//star tracker initialization
 	if(mstar==1)
 	{
-		//Loading star catalog
-		star_init(star_data,star_names);
-		
 		//setting inital acquisition flag
 		star_acq=1;
 
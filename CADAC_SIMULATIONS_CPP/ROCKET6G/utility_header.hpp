@@ -61,6 +61,10 @@
 
 using namespace std;
 
+//Matrices of up to 'MATRIX_INLINE' elements are stored inside the object,
+//larger ones on the heap
+int const MATRIX_INLINE=64;
+
 ///////////////////////////////////////////////////////////////////////////////
 /////////////////////// 'Matrix' member functions /////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -71,6 +75,7 @@ using namespace std;
 // pointer arithmetic
 //
 //020826 Created by Peter H Zipfel
+//261017 Matrices of up to 8x8 stored inside the object, no heap allocation
 ///////////////////////////////////////////////////////////////////////////////
  
 class Matrix
@@ -82,8 +87,12 @@ private:
 	int num_col;
 	//total number of elements
 	int num_elem;
-	//pointer to array
+	//pointer to array, 'body' or heap memory
 	double *pbody;
+	//storage of matrices with up to MATRIX_INLINE elements
+	double body[MATRIX_INLINE];
+	//points 'pbody' at storage for 'num_elem' elements
+	void allocate();
 
 public:
 	//default constructors
@@ -418,6 +427,61 @@ Matrix cad_tip(const double &incl,const double &lon_anode,const double &arg_peri
 //The variance is density^2
 double exponential(double density);
 
+///////////////////////////////////////////////////////////////////////////////
+//Class 'Random_stream'
+//Counter-based random number stream (Philox4x32-10, Salmon et al., SC'11)
+//The n-th draw of a stream depends only on its seed and on n, so each noise
+// source of each vehicle draws its own sequence, independent of the module
+// order, of other vehicles and of the process executing the run.
+//Same distributions as the stochastic functions above, which use 'rand()'
+//
+//261017 Created
+///////////////////////////////////////////////////////////////////////////////
+class Random_stream
+{
+private:
+	unsigned key[2];   //key from 'iseed' and run number
+	unsigned ctr[4];   //counter: block number (2 words), vehicle, source
+	unsigned block[4]; //random words of the current block
+	int used;          //words of 'block' drawn
+	int iset;          //'gset' holds the second deviate of 'gauss()'
+	double gset;
+
+	//drawing the next random word
+	unsigned next();
+
+public:
+	Random_stream(){key[0]=key[1]=0;ctr[0]=ctr[1]=ctr[2]=ctr[3]=0;used=4;iset=0;gset=0;}
+
+	//seeding the stream of noise 'source' of 'vehicle' in run 'nmc'
+	void seed(int iseed,int nmc,int vehicle,int source);
+
+	//keying the stream for run 'nmc', the position of the stream is kept
+	void rekey(int iseed,int nmc);
+
+	//uniform distribution in the open interval (0,1), 53-bit resolution
+	double unituni();
+
+	//uniform distribution between 'min' and 'max'
+	double uniform(double min,double max);
+
+	//Gaussian distribution with 'mean' and 'sig' std deviation (polar method)
+	double gauss(double mean,double sig);
+
+	//batch of 'num' Gaussian values with 'mean' and 'sig' std deviation
+	//uniforms are drawn first, then transformed together (Box-Muller)
+	void gauss(double *values,int num,double mean,double sig);
+
+	//time-correlated Gaussian variable with zero mean, see 'markov()'
+	double markov(double sigma,double bcor,double time,double intstep,double &value_saved);
+
+	//Rayleigh distribution with peak value of pdf = 'mode'
+	double rayleigh(double mode);
+
+	//exponential distribution with a given mean density
+	double exponential(double density);
+};
+
 //Generating a standard distribution with 'mean' and 'sig' std deviation
 //Ref Numerical Recipies, p 289, 1992 Cambridge University Press
 //Function unituni() is a CADAC++ utility
@@ -254,6 +254,9 @@ protected:
 	//be written to the 'ploti.asc' files
 	int *missile_plot_ind; int missile_plot_count;
 
+	//compiled output plan of the 'ploti.asc' files
+	Output_plan plot_plan;
+
 	//Indicator array pointing to the module-variable which are to 
 	//be written to 'combus' 'packets'
 	int *missile_com_ind; int missile_com_count;
@@ -50,9 +50,6 @@ void combus_status(Packet *combus,int *status,int num_vehicles);
 void acquire_timing(fstream &input,double &plot_step,double &scn_step,double &com_step,
 					double &traj_step,double &int_step);
 
-//merging the 'ploti.asc' files onto 'plot.asc' 
-void merge_plot_files(string *plot_file_list,int num_missile,char *title);
-
 //writing 'combus' data on screen
 void comscrn_data(Packet *combus,int num_vehicles);
 
@@ -100,6 +97,8 @@ int main()
 					//in same sequence as 'vehicle_list'
 	int *status=NULL; //array containing status of each vehicle object
 	bool one_traj_banner=true; //write just one banner on file 'traj.asc'
+	Output_writer writer; //binary output of the plot, stat and traj files, option 'y_binary'
+	Result_store plot_store; //plot data of all objects on 'plot.asc', option 'y_merge'
 	Document *doc_missile6=NULL;  //array for documenting MISSILE6 module-variables of 'input.asc'
 	Document *doc_target3=NULL;  //array for documenting TARGET3 module-variables of 'input.asc'
 	bool document_missile6=false; //true if array doc_missile6 was created
@@ -139,6 +138,20 @@ int main()
 	//aqcuiring title statement and option selections
 	acquire_title_options(input,title,options);
 
+	//binary output of the plot and traj files, 'y_binary' on the OPTIONS line
+	if(strstr(options,"y_binary"))
+	{
+		writer.start();
+		if(strstr(options,"y_traj"))
+		{
+			ftraj.close();
+			remove("traj.asc");
+			ftraj.open("traj.bin",ios::binary);
+			if(!ftraj){cout<<" *** Error: cannot open 'traj.bin' file *** \n";exit(1);}
+			writer.attach(ftraj);
+		}
+	}
+
 	//acquiring number of module 
 	number_modules(input,num_modules);
 
@@ -161,6 +174,13 @@ int main()
 	
 	//allocating memory for 'ploti.asc' file streams, but do it only once
 	plot_ostream_list=new ofstream[num_vehicles];
+
+	//collecting the rows of all objects on 'plot.asc', option 'y_merge'
+	if(strstr(options,"y_merge")&&strstr(options,"y_plot")&&!strstr(options,"y_binary"))
+	{
+		plot_store.open("plot.asc","plot.idx");
+		plot_store.attach(plot_ostream_list,num_vehicles);
+	}
 	if(plot_ostream_list==0){cerr<<"*** Error: plot_ostream_list[] alloc. failed *** \n";system("pause");exit(1);}
 
 	//allocating memory for 'ploti.asc' files, but do it only once
@@ -205,12 +225,15 @@ int main()
 		//executing initialization computations -MOD		
 		for (int j=0;j<num_modules;j++)
 		{
-			if((module_list[j].name=="aerodynamics")&&(module_list[j].initialization=="init"))
-				vehicle_list[i]->init_aerodynamics();
-			else if((module_list[j].name=="newton")&&(module_list[j].initialization=="init"))
-				vehicle_list[i]->init_newton();
-			else if((module_list[j].name=="kinematics")&&(module_list[j].initialization=="init"))
-				vehicle_list[i]->init_kinematics();
+			if(module_list[j].init)
+				switch(module_list[j].id){
+				case MOD_AERODYNAMICS:
+					vehicle_list[i]->init_aerodynamics();break;
+				case MOD_NEWTON:
+					vehicle_list[i]->init_newton();break;
+				case MOD_KINEMATICS:
+					vehicle_list[i]->init_kinematics();break;
+				}
 		}
 		//writing banner to screen and file 'tabout.asc'
 		if(!strcmp(vehicle_name,"MISSILE6")&&one_screen_banner)
@@ -247,15 +270,24 @@ int main()
 
 				//building names for plot files
 				sprintf(index,"%i",i+1);
-				plotiasc="plot"+string(index)+".asc"; //using Standard Library string constructor
+				plotiasc="plot"+string(index)+(strstr(options,"y_binary")?".bin":".asc"); //using Standard Library string constructor
 				plot_file_list[i]=plotiasc;
 				name=plotiasc.c_str(); //using string member function to convert to char array 
 
 				//creating output stream list 'plot_ostream_list[i]', each will write on file 'ploti.asc'
-				plot_ostream_list[i].open(name); //'name' must be 'char' type
+				if(strstr(options,"y_binary"))
+				{
+					plot_ostream_list[i].open(name,ios::binary);
+					writer.attach(plot_ostream_list[i]);
+				}
+				else if(!plot_store.get_open())
+					plot_ostream_list[i].open(name); //'name' must be 'char' type
 
 				//writing banner on 'ploti.asc'
 				vehicle_list[i]->plot_banner(plot_ostream_list[i],title);
+
+				//with option 'y_merge', the banner of the first object heads 'plot.asc'
+				plot_store.write_banner(plot_ostream_list[i],title);
 			}
 		}
 
@@ -324,6 +356,9 @@ int main()
 			 plot_ostream_list,combus,status,num_missile,num_target,ftraj,title,
 			 traj_merge);
 
+	//appending the rows to 'plot.asc', option 'y_merge'
+	plot_store.end_run(0);
+
 	//Deallocate dynamic memory
 	delete [] module_list;
 	delete [] combus;
@@ -337,16 +372,17 @@ int main()
 	input.close();
 	fcopy.close();
 
+	//writing the pending binary rows of the plot and traj files
+	writer.sync();
+
+	//closing 'plot.asc', restoring the streams of the objects
+	plot_store.close();
+
 	//Close file streams
 	ftabout.close();
 	for(int f=0;f<num_vehicles;f++) plot_ostream_list[f].close();
 	fdoc.close();
 
-	//merging 'ploti.asc' files into 'plot.asc'
-	if(strstr(options,"y_merge")&&strstr(options,"y_plot"))
-	{
-		merge_plot_files(plot_file_list,num_missile,title);
-	}
 	//Deallocate dynamic memory
 	delete [] plot_ostream_list;
 	delete [] plot_file_list;
@@ -394,6 +430,7 @@ int main()
 //				traj_merge = flag for merging MC runs in 'traj.asc'
 //				  				
 //030717 Created by Peter H Zipfel
+//261017 Module dispatch on 'Module_id' instead of name comparisons
 ///////////////////////////////////////////////////////////////////////////////
 void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 			 double end_time,int num_vehicles,int num_modules,double plot_step,
@@ -430,32 +467,34 @@ void execute(Vehicle &vehicle_list,Module *module_list,double sim_time,
 				//module loop -MOD
 				for(int j=0;j<num_modules;j++)
 				{
-					if(module_list[j].name=="environment")
-						vehicle_list[i]->environment();
-					else if(module_list[j].name=="kinematics")
-						vehicle_list[i]->kinematics(int_step);
-					else if(module_list[j].name=="newton")
-						vehicle_list[i]->newton(sim_time,int_step);
-					else if(module_list[j].name=="euler")
-						vehicle_list[i]->euler(int_step);
-					else if(module_list[j].name=="aerodynamics")
-						vehicle_list[i]->aerodynamics();
-					else if(module_list[j].name=="propulsion")
-						vehicle_list[i]->propulsion();
-					else if(module_list[j].name=="forces")
-						vehicle_list[i]->forces();
-					else if(module_list[j].name=="actuator")
-						vehicle_list[i]->actuator(int_step);
-					else if(module_list[j].name=="tvc")
-						vehicle_list[i]->tvc(int_step);
-					else if(module_list[j].name=="control") 
-						vehicle_list[i]->control(int_step);
-					else if(module_list[j].name=="guidance")
-						vehicle_list[i]->guidance(combus,num_vehicles);
-					else if(module_list[j].name=="seeker")
-						vehicle_list[i]->seeker(combus,num_vehicles,int_step);
-					else if(module_list[j].name=="intercept")
-						vehicle_list[i]->intercept(combus,vehicle_slot,int_step,title);
+					switch(module_list[j].id){
+					case MOD_ENVIRONMENT:
+						vehicle_list[i]->environment();break;
+					case MOD_KINEMATICS:
+						vehicle_list[i]->kinematics(int_step);break;
+					case MOD_NEWTON:
+						vehicle_list[i]->newton(sim_time,int_step);break;
+					case MOD_EULER:
+						vehicle_list[i]->euler(int_step);break;
+					case MOD_AERODYNAMICS:
+						vehicle_list[i]->aerodynamics();break;
+					case MOD_PROPULSION:
+						vehicle_list[i]->propulsion();break;
+					case MOD_FORCES:
+						vehicle_list[i]->forces();break;
+					case MOD_ACTUATOR:
+						vehicle_list[i]->actuator(int_step);break;
+					case MOD_TVC:
+						vehicle_list[i]->tvc(int_step);break;
+					case MOD_CONTROL:
+						vehicle_list[i]->control(int_step);break;
+					case MOD_GUIDANCE:
+						vehicle_list[i]->guidance(combus,num_vehicles);break;
+					case MOD_SEEKER:
+						vehicle_list[i]->seeker(combus,num_vehicles,int_step);break;
+					case MOD_INTERCEPT:
+						vehicle_list[i]->intercept(combus,vehicle_slot,int_step,title);break;
+					}
 
 				} //end of module loop
 
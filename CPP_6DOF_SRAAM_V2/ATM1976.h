@@ -48,14 +48,14 @@ namespace atm1976_metric
 		const float rhosl = 1.225; // rho sea level, kg/m^3
 		const float pressl = 101325; // pressure sea level, pascals
 		const float tempksl = 288.15; // rho sea level, kg/m^3
-		const vector<float> htab =
+		static const float htab[8] =
 		{0.0, 11.0, 20.0, 32.0, 47.0, 51.0, 71.0, 84.852};
-		const vector<float> ttab =
+		static const float ttab[8] =
 		{288.15, 216.65, 216.65, 228.65, 270.65, 270.65, 214.65, 186.946};
-		const vector<float> ptab =
+		static const float ptab[8] =
 		{1.0, 2.233611e-1, 5.403295e-2, 8.5666784e-3,
 		1.0945601e-3, 6.6063531e-4, 3.9046834e-5, 3.68501e-6};
-		const vector<float> gtab =
+		static const float gtab[8] =
 		{-6.5, 0.0, 1.0, 2.8, 0.0, -2.8, -2.0, 0.0};
 
 		atm1976_output ret;
@@ -68,7 +68,7 @@ namespace atm1976_metric
 		int j = 7;
 		while (true)
 		{
-			int k = i + j / 2;
+			int k = (i + j) / 2;
 			if (hgt < htab[k])
 			{
 				j = k;
@@ -1,7 +1,7 @@
 import subprocess
 
 ballistic = 0 # Boolean.
-INTEGRATION_METHOD = 0 # 0 = Euler, 1 = RK2, 2 = RK4.
+INTEGRATION_METHOD = 0 # 0 = Euler, 1 = RK2, 2 = RK4, 3 = Dormand Prince 5(4), adaptive.
 phi = 0 # Degrees.
 theta = 55 # Degrees.
 psi = 20 # Degrees.
@@ -14,9 +14,13 @@ tgtU = 5000 # Meters.
 LogData = 1 # Boolean.
 ConsoleReport = 1 # Boolean.
 ID = "missileRk4"
+LogFormat = "TEXT" # TEXT or BINARY.
+LogDecimation = 1 # Log every nth integration step.
+LogFields = "ALL" # Binary log fields, comma separated, or ALL.
 
 InputString = f"{ballistic} {INTEGRATION_METHOD} {phi} {theta} \
-{psi} {posE} {posN} {posU} {tgtE} {tgtN} {tgtU} {LogData} {ConsoleReport} {ID}\n"
+{psi} {posE} {posN} {posU} {tgtE} {tgtN} {tgtU} {LogData} {ConsoleReport} {ID} \
+{LogFormat} {LogDecimation} {LogFields}\n"
 InputFile = r"CPP_6DOF_SRAAM_V2/input/input.txt"
 with open(InputFile, "w") as f:
 	f.writelines(InputString)
@@ -0,0 +1,35 @@
+import subprocess
+import numpy as np
+
+ballistic = 0 # Boolean.
+INTEGRATION_METHOD = 0 # 0 = Euler, 1 = RK2, 2 = RK4, 3 = Dormand Prince 5(4), adaptive.
+phi = 0 # Degrees.
+thetas = np.linspace(35, 75, 5) # Degrees.
+psis = np.linspace(0, 40, 5) # Degrees.
+posE = 0 # Meters.
+posN = 0 # Meters.
+posU = 0 # Meters.
+tgtE = 5000 # Meters.
+tgtN = 5000 # Meters.
+tgtU = 5000 # Meters.
+LogData = 0 # Boolean. Writes one 6DOF log per case.
+ConsoleReport = 0 # Boolean. Ignored in a sweep.
+THREADS = 0 # Zero uses every hardware thread.
+
+# One line per case, same layout as input.txt.
+InputStrings = []
+for theta in thetas:
+	for psi in psis:
+		ID = f"sweep_theta{theta:.0f}_psi{psi:.0f}"
+		InputStrings.append(f"{ballistic} {INTEGRATION_METHOD} {phi} {theta} \
+{psi} {posE} {posN} {posU} {tgtE} {tgtN} {tgtU} {LogData} {ConsoleReport} {ID}\n")
+InputFile = r"CPP_6DOF_SRAAM_V2/input/sweep.txt"
+with open(InputFile, "w") as f:
+	f.writelines(InputStrings)
+	f.close()
+
+command = ["./CPP_6DOF_SRAAM_V2/build/missileModel", "sweep", InputFile]
+if THREADS > 0:
+	command.append(str(THREADS))
+process = subprocess.Popen(command)
+process.wait()
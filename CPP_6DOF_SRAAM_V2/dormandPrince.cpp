@@ -0,0 +1,375 @@
+// Standard.
+#include <iostream>
+#include <string>
+#include <math.h>
+#include <algorithm>
+
+// Namespace.
+using namespace std;
+
+// Header.
+#include "dormandPrince.h"
+
+// Airframe states. Position, velocity, body rate, attitude.
+const int STATES = 12;
+
+// Dormand Prince 5(4) tableau.
+const double DP_C[7] = {0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0, 1.0};
+const double DP_A[7][6] = {
+	{0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+	{1.0 / 5.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+	{3.0 / 40.0, 9.0 / 40.0, 0.0, 0.0, 0.0, 0.0},
+	{44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0, 0.0, 0.0, 0.0},
+	{19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0, 0.0, 0.0},
+	{9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0, 0.0},
+	{35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0}
+};
+
+// Difference between the fifth and fourth order weights.
+const double DP_E[7] = {71.0 / 57600.0, 0.0, -71.0 / 16695.0, 71.0 / 1920.0, -17253.0 / 339200.0, 22.0 / 525.0, -1.0 / 40.0};
+
+// Step size controller.
+const double STEP_SAFETY = 0.9;
+const double STEP_MIN_FACTOR = 0.2;
+const double STEP_MAX_FACTOR = 5.0;
+
+// Longest frame the flight software filters and autopilot are stable at. Seconds.
+const double FLIGHT_SOFTWARE_FRAME = 1.0 / 600.0;
+
+// Termination events.
+const double INTERCEPT_RADIUS = 5.0; // Meters.
+const double EVENT_TIME_TOLERANCE = 1e-9; // Seconds.
+
+static void getStates(const Missile &missile, double y[STATES])
+{
+
+	for (int c = 0; c < 3; c++)
+	{
+		y[c] = missile.enuPos[c];
+		y[3 + c] = missile.enuVel[c];
+		y[6 + c] = missile.rate[c];
+		y[9 + c] = missile.enuAttitude[c];
+	}
+
+}
+
+static void setStates(Missile &missile, const double y[STATES])
+{
+
+	for (int c = 0; c < 3; c++)
+	{
+		missile.enuPos[c] = y[c];
+		missile.enuVel[c] = y[3 + c];
+		missile.rate[c] = y[6 + c];
+		missile.enuAttitude[c] = y[9 + c];
+	}
+
+}
+
+// Airframe derivatives with the fins held. Leaves the missile at the given states.
+static void airframeDerivatives(Missile &missile, double tof, const double y[STATES], double dy[STATES])
+{
+
+	setStates(missile, y);
+	missile.tof = tof;
+	missileOrientation(missile);
+	atmosphere(missile);
+	aerodynamicAnglesAndConversions(missile);
+	tableLookUps(missile);
+	propulsion(missile);
+	aerodynamics(missile);
+	missileDerivatives(missile);
+
+	for (int c = 0; c < 3; c++)
+	{
+		dy[c] = y[3 + c];
+		dy[3 + c] = missile.enuAcc[c];
+		dy[6 + c] = missile.rateDot[c];
+		dy[9 + c] = missile.enuAttitudeDot[c];
+	}
+
+}
+
+// Cubic hermite interpolation of the states at fraction s of the step.
+static void interpolateStates(double s, double h, const double y0[STATES], const double f0[STATES], const double y1[STATES], const double f1[STATES], double out[STATES])
+{
+
+	double s2 = s * s;
+	double s3 = s2 * s;
+	double h00 = 2 * s3 - 3 * s2 + 1;
+	double h10 = s3 - 2 * s2 + s;
+	double h01 = -2 * s3 + 3 * s2;
+	double h11 = s3 - s2;
+	for (int i = 0; i < STATES; i++)
+	{
+		out[i] = h00 * y0[i] + h10 * h * f0[i] + h01 * y1[i] + h11 * h * f1[i];
+	}
+
+}
+
+enum terminationEvent
+{
+	GROUND_EVENT,
+	INTERCEPT_EVENT,
+	CLOSEST_APPROACH_EVENT,
+	NUMBER_OF_EVENTS
+};
+
+const missileLethality EVENT_LETHALITY[NUMBER_OF_EVENTS] = {
+	GROUND_COLLISION,
+	SUCCESSFUL_INTERCEPT,
+	POINT_OF_CLOSEST_APPROACH_PASSED
+};
+
+// Event functions. Each event fires when its function goes from non negative to negative.
+static double eventFunction(const Missile &missile, terminationEvent event, const double y[STATES])
+{
+
+	double relPos[3] = {y[0] - missile.waypoint[0], y[1] - missile.waypoint[1], y[2] - missile.waypoint[2]};
+	if (event == GROUND_EVENT)
+	{
+		return y[2];
+	}
+	else if (event == INTERCEPT_EVENT)
+	{
+		return sqrt(relPos[0] * relPos[0] + relPos[1] * relPos[1] + relPos[2] * relPos[2]) - INTERCEPT_RADIUS;
+	}
+	else
+	{
+		// Closing speed. Zero at the point of closest approach.
+		return -(relPos[0] * y[3] + relPos[1] * y[4] + relPos[2] * y[5]);
+	}
+
+}
+
+// Finds the fraction of the step where the event function crosses zero. Illinois regula falsi.
+static double locateEvent(const Missile &missile, terminationEvent event, double h, const double y0[STATES], const double f0[STATES], const double y1[STATES], const double f1[STATES])
+{
+
+	double y[STATES];
+	double sLow = 0.0;
+	double sHigh = 1.0;
+	double gLow = eventFunction(missile, event, y0);
+	double gHigh = eventFunction(missile, event, y1);
+	int side = 0;
+
+	for (int iteration = 0; iteration < 100; iteration++)
+	{
+
+		if ((sHigh - sLow) * h < EVENT_TIME_TOLERANCE)
+		{
+			break;
+		}
+
+		double s = (sLow * gHigh - sHigh * gLow) / (gHigh - gLow);
+		interpolateStates(s, h, y0, f0, y1, f1, y);
+		double g = eventFunction(missile, event, y);
+
+		if (g < 0)
+		{
+			sHigh = s;
+			gHigh = g;
+			if (side == -1)
+			{
+				gLow *= 0.5;
+			}
+			side = -1;
+		}
+		else if (g > 0)
+		{
+			sLow = s;
+			gLow = g;
+			if (side == 1)
+			{
+				gHigh *= 0.5;
+			}
+			side = 1;
+		}
+		else
+		{
+			return s;
+		}
+
+	}
+
+	return sHigh;
+
+}
+
+void dormandPrinceStep(Missile &missile, double maxTime)
+{
+
+	// Flight software, over the step just taken in frames no longer than it was tuned for.
+	// The airframe is held across the frames.
+	double stepTaken = missile.timeStep;
+	int frames = static_cast<int>(ceil(stepTaken / FLIGHT_SOFTWARE_FRAME - 1e-9));
+	missile.sampleTime = stepTaken / frames;
+	atmosphere(missile);
+	for (int frame = 0; frame < frames; frame++)
+	{
+		seeker(missile);
+		guidance(missile);
+		control(missile);
+		actuators(missile);
+	}
+	aerodynamicAnglesAndConversions(missile);
+	tableLookUps(missile);
+	accelerationLimit(missile);
+	propulsion(missile);
+	aerodynamics(missile);
+	aerodynamicDerivatives(missile);
+
+	double t0 = missile.tof;
+	double clock = missile.isLaunched ? 1.0 : 0.0;
+	double h = (missile.nextTimeStep > 0.0) ? missile.nextTimeStep : missile.timeStep;
+	h = min(max(h, missile.minimumTimeStep), missile.maximumTimeStep);
+
+	// Thrust cuts off at burn out. Steps end there rather than straddle it,
+	// and their last stage sees the motor still burning.
+	bool endsAtBurnOut = false;
+	if (missile.isLaunched and t0 < ROCKET_BURN_OUT_TIME and t0 + h >= ROCKET_BURN_OUT_TIME)
+	{
+		h = ROCKET_BURN_OUT_TIME - t0;
+		endsAtBurnOut = true;
+	}
+
+	double y0[STATES], y1[STATES], yStage[STATES];
+	double k[7][STATES];
+	getStates(missile, y0);
+	airframeDerivatives(missile, t0, y0, k[0]);
+
+	double error = 0.0;
+	while (true)
+	{
+
+		for (int stage = 1; stage < 7; stage++)
+		{
+			for (int i = 0; i < STATES; i++)
+			{
+				double sum = 0.0;
+				for (int j = 0; j < stage; j++)
+				{
+					sum += DP_A[stage][j] * k[j][i];
+				}
+				yStage[i] = y0[i] + h * sum;
+			}
+			double stageTof = t0 + clock * DP_C[stage] * h;
+			if (endsAtBurnOut and DP_C[stage] == 1.0)
+			{
+				stageTof = nextafter(ROCKET_BURN_OUT_TIME, 0.0);
+			}
+			airframeDerivatives(missile, stageTof, yStage, k[stage]);
+		}
+
+		// The last stage is evaluated at the fifth order solution.
+		for (int i = 0; i < STATES; i++)
+		{
+			y1[i] = yStage[i];
+		}
+
+		// Root mean square of the scaled error estimate.
+		double sum = 0.0;
+		for (int i = 0; i < STATES; i++)
+		{
+			double e = 0.0;
+			for (int stage = 0; stage < 7; stage++)
+			{
+				e += DP_E[stage] * k[stage][i];
+			}
+			double scale = missile.absoluteTolerance + missile.relativeTolerance * max(abs(y0[i]), abs(y1[i]));
+			double scaled = h * e / scale;
+			sum += scaled * scaled;
+		}
+		error = sqrt(sum / STATES);
+
+		if (error <= 1.0 or h <= missile.minimumTimeStep)
+		{
+			break;
+		}
+
+		// Rejected. Retry with a smaller step.
+		missile.rejectedSteps += 1;
+		h = max(h * max(STEP_MIN_FACTOR, STEP_SAFETY * pow(error, -0.2)), missile.minimumTimeStep);
+		endsAtBurnOut = false;
+
+	}
+
+	missile.acceptedSteps += 1;
+	missile.integrationStep += 1;
+	double factor = (error == 0.0) ? STEP_MAX_FACTOR : min(STEP_MAX_FACTOR, max(STEP_MIN_FACTOR, STEP_SAFETY * pow(error, -0.2)));
+	missile.nextTimeStep = min(max(h * factor, missile.minimumTimeStep), missile.maximumTimeStep);
+
+	// Termination events inside the step. The earliest one ends the flight.
+	int firstEvent = -1;
+	double firstS = 2.0;
+	for (int event = 0; event < NUMBER_OF_EVENTS; event++)
+	{
+
+		if (missile.isBallistic and event != GROUND_EVENT)
+		{
+			continue;
+		}
+
+		terminationEvent e = static_cast<terminationEvent>(event);
+		if (eventFunction(missile, e, y0) >= 0 and eventFunction(missile, e, y1) < 0)
+		{
+			double s = locateEvent(missile, e, h, y0, k[0], y1, k[6]);
+			if (s < firstS)
+			{
+				firstS = s;
+				firstEvent = event;
+			}
+		}
+
+	}
+
+	double stepEnd = 1.0;
+	if (firstEvent >= 0)
+	{
+		stepEnd = firstS;
+		interpolateStates(stepEnd, h, y0, k[0], y1, k[6], yStage);
+		for (int i = 0; i < STATES; i++)
+		{
+			y1[i] = yStage[i];
+		}
+	}
+
+	// Leave the missile at the end of the step.
+	double scratch[STATES];
+	double tof1 = t0 + clock * stepEnd * h;
+	if (endsAtBurnOut and stepEnd == 1.0)
+	{
+		tof1 = ROCKET_BURN_OUT_TIME;
+	}
+	airframeDerivatives(missile, tof1, y1, scratch);
+	missile.timeStep = stepEnd * h;
+	missile.halfTimeStep = missile.timeStep * 0.5;
+
+	double deltaPos[3] = {y1[0] - y0[0], y1[1] - y0[1], y1[2] - y0[2]};
+	double distanceTravelled;
+	magnitude(deltaPos, distanceTravelled);
+	missile.rng += distanceTravelled;
+
+	double relPos[3] = {y1[0] - missile.waypoint[0], y1[1] - missile.waypoint[1], y1[2] - missile.waypoint[2]};
+	magnitude(relPos, missile.missDistance);
+
+	// A step can carry the missile through the intercept sphere, so the closest
+	// approach is also an intercept when it lies inside it.
+	if (firstEvent == CLOSEST_APPROACH_EVENT and missile.missDistance < INTERCEPT_RADIUS)
+	{
+		missile.lethality = SUCCESSFUL_INTERCEPT;
+	}
+	else if (firstEvent >= 0)
+	{
+		missile.lethality = EVENT_LETHALITY[firstEvent];
+	}
+	else if (isnan(missile.enuPos[0]))
+	{
+		missile.lethality = NOT_A_NUMBER;
+	}
+	else if (missile.tof > maxTime)
+	{
+		missile.lethality = MAX_TIME_EXCEEDED;
+	}
+
+}
@@ -0,0 +1,34 @@
+// Standard.
+#include <iostream>
+#include <string>
+
+// Namespace.
+using namespace std;
+
+// Missile model.
+#include "missileModel.h"
+
+#ifndef DORMANDPRINCE_H
+#define DORMANDPRINCE_H
+
+/* Adaptive Dormand Prince 5(4) integration. INTEGRATION_METHOD 3.
+
+The airframe states (position, velocity, body rate and attitude) are
+integrated with an embedded fifth order runge kutta pair. The step size
+follows the local error estimate against relativeTolerance and
+absoluteTolerance, inside minimumTimeStep and maximumTimeStep.
+
+The flight software (seeker, guidance, control and actuators) runs once
+per accepted step, cycled in frames no longer than 1/600 second against
+the held airframe, and the fin deflections are held across the stages.
+The fin hold is what bounds maximumTimeStep.
+
+Ground collision, intercept and point of closest approach are located
+inside the step on the cubic hermite interpolant of the states, using
+the true missile to waypoint geometry. */
+
+// Takes one accepted step, then runs the termination checks.
+// Every call is a full step, INTEGRATION_PASS stays zero.
+void dormandPrinceStep(Missile &missile, double maxTime);
+
+#endif
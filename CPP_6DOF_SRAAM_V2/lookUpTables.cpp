@@ -0,0 +1,289 @@
+// Standard.
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+// Namespace.
+using namespace std;
+
+// Header.
+#include "lookUpTables.h"
+
+// Table names as they appear in the tables file. Order matches tableId.
+static const char *TABLE_NAMES[NUMBER_OF_TABLES] =
+{
+	"CA0",
+	"CAA",
+	"CAD",
+	"CAOFF",
+	"CLMQ",
+	"CN0",
+	"CNP",
+	"CLM0",
+	"CLMP",
+	"CYP",
+	"CLNP",
+	"CNDQ",
+	"CYDR",
+	"CLMDQ",
+	"CLLAP",
+	"CLLDP",
+	"CLLP",
+	"MASS",
+	"THRUST",
+	"TMOI",
+	"AMOI",
+	"CG",
+	"RHO",
+	"GRAVITY",
+	"PRESSURE",
+	"SPEED_OF_SOUND",
+	"CN0_SLOPE",
+	"CLM0_SLOPE",
+	"CN0_MAX",
+	"CNP_MAX",
+	"CYP_MAX"
+};
+
+tableId tableIdFromName(const string &name)
+{
+
+	for (int i = 0; i < NUMBER_OF_TABLES; i++)
+	{
+		if (name == TABLE_NAMES[i])
+		{
+			return static_cast<tableId>(i);
+		}
+	}
+	return NUMBER_OF_TABLES;
+
+}
+
+lookUpTables buildLookUpTables(const vector<vector<vector<double>>> &tables, const map<string, int> &tableNameIndexPairs)
+{
+
+	lookUpTables ret;
+
+	for (auto const &pair : tableNameIndexPairs)
+	{
+
+		tableId id = tableIdFromName(pair.first);
+		if (id == NUMBER_OF_TABLES)
+		{
+			continue;
+		}
+
+		const vector<vector<double>> &nested = tables[pair.second];
+		lookUpTable &table = ret.table[id];
+
+		// One dimensional.
+		if (nested[0].size() == 2)
+		{
+			table.rows = nested.size();
+			table.columns = 0;
+			table.rowBreakpoints.resize(table.rows);
+			table.data.resize(table.rows);
+			for (int i = 0; i < table.rows; i++)
+			{
+				table.rowBreakpoints[i] = nested[i][0];
+				table.data[i] = nested[i][1];
+			}
+		}
+		// Two dimensional.
+		else
+		{
+			table.rows = nested.size() - 1;
+			table.columns = nested[0].size() - 1;
+			table.rowBreakpoints.resize(table.rows);
+			table.columnBreakpoints.resize(table.columns);
+			table.data.resize(table.rows * table.columns);
+			for (int j = 0; j < table.columns; j++)
+			{
+				table.columnBreakpoints[j] = nested[0][j + 1];
+			}
+			for (int i = 0; i < table.rows; i++)
+			{
+				table.rowBreakpoints[i] = nested[i + 1][0];
+				for (int j = 0; j < table.columns; j++)
+				{
+					table.data[i * table.columns + j] = nested[i + 1][j + 1];
+				}
+			}
+		}
+
+	}
+
+	return ret;
+
+}
+
+// Returns -1 below the first breakpoint, size - 1 above the last breakpoint,
+// else the lower index of the cell with breakpoints[i] < input <= breakpoints[i + 1].
+// Walks from the cached index, so a slowly varying input costs one or two compares.
+static int findCell(const vector<double> &breakpoints, double input, int &hint)
+{
+
+	int size = breakpoints.size();
+	if (input <= breakpoints[0])
+	{
+		return -1;
+	}
+	if (input >= breakpoints[size - 1])
+	{
+		return size - 1;
+	}
+
+	int i = hint;
+	if (i < 0)
+	{
+		i = 0;
+	}
+	else if (i > size - 2)
+	{
+		i = size - 2;
+	}
+	while (input > breakpoints[i + 1])
+	{
+		i++;
+	}
+	while (input <= breakpoints[i])
+	{
+		i--;
+	}
+	hint = i;
+	return i;
+
+}
+
+double lookUp(const lookUpTable &table, double rowInput, tableBracket &bracket)
+{
+
+	int cell = findCell(table.rowBreakpoints, rowInput, bracket.row);
+	if (cell < 0)
+	{
+		return table.data[0];
+	}
+	else if (cell == table.rows - 1)
+	{
+		return table.data[table.rows - 1];
+	}
+
+	double x1 = table.rowBreakpoints[cell];
+	double x2 = table.rowBreakpoints[cell + 1];
+	double y1 = table.data[cell];
+	double y2 = table.data[cell + 1];
+	return y1 + ((rowInput - x1) * ((y2 - y1) / (x2 - x1)));
+
+}
+
+double lookUp(const lookUpTable &table, double rowInput, double columnInput, tableBracket &bracket)
+{
+
+	int rowCell = findCell(table.rowBreakpoints, rowInput, bracket.row);
+	int columnCell = findCell(table.columnBreakpoints, columnInput, bracket.column);
+	bool rowBounded = (rowCell < 0 or rowCell == table.rows - 1);
+	bool columnBounded = (columnCell < 0 or columnCell == table.columns - 1);
+	int lowRow = (rowCell < 0) ? 0 : rowCell;
+	int lowColumn = (columnCell < 0) ? 0 : columnCell;
+	const double *lowRowData = &table.data[lowRow * table.columns];
+
+	if (rowBounded and columnBounded)
+	{
+		return lowRowData[lowColumn];
+	}
+	else if (rowBounded)
+	{
+		double x1 = table.columnBreakpoints[lowColumn];
+		double x2 = table.columnBreakpoints[lowColumn + 1];
+		double y1 = lowRowData[lowColumn];
+		double y2 = lowRowData[lowColumn + 1];
+		return y1 + (columnInput - x1) * ((y2 - y1) / (x2 - x1));
+	}
+	else if (columnBounded)
+	{
+		double x1 = table.rowBreakpoints[lowRow];
+		double x2 = table.rowBreakpoints[lowRow + 1];
+		double y1 = lowRowData[lowColumn];
+		double y2 = lowRowData[table.columns + lowColumn];
+		return y1 + (rowInput - x1) * ((y2 - y1) / (x2 - x1));
+	}
+
+	const double *highRowData = lowRowData + table.columns;
+	double x1 = table.rowBreakpoints[lowRow];
+	double x2 = table.rowBreakpoints[lowRow + 1];
+	double y1 = table.columnBreakpoints[lowColumn];
+	double y2 = table.columnBreakpoints[lowColumn + 1];
+	double corner11 = lowRowData[lowColumn];
+	double corner12 = lowRowData[lowColumn + 1];
+	double corner21 = highRowData[lowColumn];
+	double corner22 = highRowData[lowColumn + 1];
+	double t1 = corner11 * (x2 - rowInput) * (y2 - columnInput);
+	double t2 = corner21 * (rowInput - x1) * (y2 - columnInput);
+	double t3 = corner12 * (x2 - rowInput) * (columnInput - y1);
+	double t4 = corner22 * (rowInput - x1) * (columnInput - y1);
+	return (t1 + t2 + t3 + t4) / ((x2 - x1) * (y2 - y1));
+
+}
+
+lookUpTable columnSlopeTable(const lookUpTable &table, double halfWidth, double columnMin, double columnMax)
+{
+
+	// The difference is linear between the breakpoints shifted by plus and minus the half width.
+	vector<double> columns = {columnMin, columnMax};
+	for (double breakpoint : table.columnBreakpoints)
+	{
+		for (double shifted : {breakpoint - halfWidth, breakpoint + halfWidth})
+		{
+			if (shifted > columnMin and shifted < columnMax)
+			{
+				columns.push_back(shifted);
+			}
+		}
+	}
+	sort(columns.begin(), columns.end());
+	columns.erase(unique(columns.begin(), columns.end()), columns.end());
+
+	lookUpTable ret;
+	ret.rows = table.rows;
+	ret.columns = columns.size();
+	ret.rowBreakpoints = table.rowBreakpoints;
+	ret.columnBreakpoints = columns;
+	ret.data.resize(ret.rows * ret.columns);
+
+	tableBracket bracket;
+	for (int i = 0; i < ret.rows; i++)
+	{
+		for (int j = 0; j < ret.columns; j++)
+		{
+			double high = lookUp(table, ret.rowBreakpoints[i], columns[j] + halfWidth, bracket);
+			double low = lookUp(table, ret.rowBreakpoints[i], columns[j] - halfWidth, bracket);
+			ret.data[i * ret.columns + j] = (high - low) / (2 * halfWidth);
+		}
+	}
+
+	return ret;
+
+}
+
+lookUpTable columnSlice(const lookUpTable &table, double columnInput)
+{
+
+	lookUpTable ret;
+	ret.rows = table.rows;
+	ret.columns = 0;
+	ret.rowBreakpoints = table.rowBreakpoints;
+	ret.data.resize(ret.rows);
+
+	tableBracket bracket;
+	for (int i = 0; i < ret.rows; i++)
+	{
+		ret.data[i] = lookUp(table, ret.rowBreakpoints[i], columnInput, bracket);
+	}
+
+	return ret;
+
+}
@@ -0,0 +1,108 @@
+// Standard.
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+
+// Namespace.
+using namespace std;
+
+#ifndef LOOKUPTABLES_H
+#define LOOKUPTABLES_H
+
+/* Table identifiers. Order must match TABLE_NAMES in lookUpTables.cpp. */
+enum tableId
+{
+	CA0_TABLE,
+	CAA_TABLE,
+	CAD_TABLE,
+	CAOFF_TABLE,
+	CLMQ_TABLE,
+	CN0_TABLE,
+	CNP_TABLE,
+	CLM0_TABLE,
+	CLMP_TABLE,
+	CYP_TABLE,
+	CLNP_TABLE,
+	CNDQ_TABLE,
+	CYDR_TABLE,
+	CLMDQ_TABLE,
+	CLLAP_TABLE,
+	CLLDP_TABLE,
+	CLLP_TABLE,
+	MASS_TABLE,
+	THRUST_TABLE,
+	TMOI_TABLE,
+	AMOI_TABLE,
+	CG_TABLE,
+	RHO_TABLE,
+	GRAVITY_TABLE,
+	PRESSURE_TABLE,
+	SPEED_OF_SOUND_TABLE,
+
+	// Derived from the tables above when they are loaded.
+	CN0_SLOPE_TABLE, // CN0 slope against alpha prime. Per degree.
+	CLM0_SLOPE_TABLE, // CLM0 slope against alpha prime. Per degree.
+	CN0_MAX_TABLE, // CN0 at the maximum alpha prime against mach. Non dimensional.
+	CNP_MAX_TABLE, // CNP at the maximum alpha prime against mach. Non dimensional.
+	CYP_MAX_TABLE, // CYP at the maximum alpha prime against mach. Non dimensional.
+
+	NUMBER_OF_TABLES
+};
+
+/* One table with contiguous breakpoints and data. */
+struct lookUpTable
+{
+
+	int rows    = 0; // number of row breakpoints
+	int columns = 0; // number of column breakpoints, zero for one dimensional tables
+	vector<double> rowBreakpoints; // ascending row breakpoints
+	vector<double> columnBreakpoints; // ascending column breakpoints
+	vector<double> data; // row major, rows * max(columns, 1)
+
+};
+
+/* All tables of a missile model. Built once and shared read only between missiles. */
+struct lookUpTables
+{
+
+	lookUpTable table[NUMBER_OF_TABLES];
+
+	const lookUpTable &operator[](tableId id) const { return table[id]; }
+
+};
+
+/* Lower cell index of the last look up. Searching starts here on the next call. */
+struct tableBracket
+{
+
+	int row    = 0;
+	int column = 0;
+
+};
+
+// Returns the identifier of a table name, or NUMBER_OF_TABLES if the name is unknown.
+tableId tableIdFromName(const string &name);
+
+// Flattens tables in the nested [row][column] layout produced by formatTables.
+// A two dimensional table holds column breakpoints in row zero and row breakpoints in column zero.
+// A one dimensional table holds breakpoints in column zero and data in column one.
+lookUpTables buildLookUpTables(const vector<vector<vector<double>>> &tables, const map<string, int> &tableNameIndexPairs);
+
+// Central difference along the columns of a two dimensional table, (f(c + h) - f(c - h)) / 2h,
+// with the column input held inside [columnMin, columnMax]. Tabulated on every column where the
+// difference changes slope, so a look up of the result equals the difference of two look ups.
+lookUpTable columnSlopeTable(const lookUpTable &table, double halfWidth, double columnMin, double columnMax);
+
+// A two dimensional table at a fixed column input, as a one dimensional table of the rows.
+lookUpTable columnSlice(const lookUpTable &table, double columnInput);
+
+// Linear interpolation, constant beyond the ends.
+double lookUp(const lookUpTable &table, double rowInput, tableBracket &bracket);
+
+// Bilinear interpolation, constant beyond the borders.
+double lookUp(const lookUpTable &table, double rowInput, double columnInput, tableBracket &bracket);
+
+#endif
@@ -1,3 +1,6 @@
+// Standard.
+#include <random>
+
 // Utility.
 #include "util.h"
 
@@ -5,14 +8,188 @@
 #include "missileModel.h"
 #include "secondOrderActuator.h"
 #include "ATM1976.h"
+#include "sweep.h"
 
 // Namespace.
 using namespace std;
 auto wallClockStart = chrono::high_resolution_clock::now();
 
-int main()
+// Sweep mode. Flies every case of a case file on a pool of threads with one set of tables.
+// Usage: missileModel sweep [caseFile] [threads]
+int sweep(int argc, char *argv[])
+{
+
+	string caseFile = "CPP_6DOF_SRAAM_V2/input/sweep.txt";
+	int threads = thread::hardware_concurrency();
+	if (argc > 2)
+	{
+		caseFile = argv[2];
+	}
+	if (argc > 3)
+	{
+		threads = stoi(argv[3]);
+	}
+
+	// Format data tables. Only happens once for the whole sweep.
+	Missile prototype;
+	formatTables(prototype, "CPP_6DOF_SRAAM_V2/input/tables.txt");
+
+	vector<sweepCase> cases = readSweepCases(caseFile);
+	cout << "\nSWEEP " << cases.size() << " CASES ON " << threads << " THREADS" << endl;
+	vector<sweepResult> results = runSweep(prototype, cases, threads, 400.0);
+	writeSweepResults(results, "CPP_6DOF_SRAAM_V2/output/sweepResults.txt");
+
+	// Console report and terminate.
+	auto wallClockEnd = chrono::high_resolution_clock::now();
+	auto simRealRunTime = chrono::duration_cast<chrono::milliseconds>(wallClockEnd - wallClockStart);
+	cout << "\nSIMULATION RUN TIME :" << simRealRunTime.count() << " MILLISECONDS" << endl;
+	cout << "\n";
+	return 0;
+
+}
+
+// Fan out mode. Flies the input.txt missile to the snapshot time, then flies many continuations
+// of the snapshot, each with a dispersed waypoint. A snapshot file can stand in for the time.
+// Usage: missileModel fanout [runs] [threads] [snapshotTime|snapshotFile] [waypointSigma]
+int fanOutStudy(int argc, char *argv[])
+{
+
+	int runs = 100;
+	int threads = thread::hardware_concurrency();
+	string snapshotSource = to_string(ROCKET_BURN_OUT_TIME);
+	double waypointSigma = 25.0; // Meters.
+	if (argc > 2)
+	{
+		runs = stoi(argv[2]);
+	}
+	if (argc > 3)
+	{
+		threads = stoi(argv[3]);
+	}
+	if (argc > 4)
+	{
+		snapshotSource = argv[4];
+	}
+	if (argc > 5)
+	{
+		waypointSigma = stod(argv[5]);
+	}
+
+	Missile prototype;
+	formatTables(prototype, "CPP_6DOF_SRAAM_V2/input/tables.txt");
+
+	// Snapshot, read or flown to.
+	missileSnapshot snapshot;
+	char *end;
+	double snapshotTime = strtod(snapshotSource.c_str(), &end);
+	if (*end != '\0')
+	{
+		snapshot = readSnapshot(snapshotSource);
+	}
+	else
+	{
+		vector<sweepCase> launch = readSweepCases("CPP_6DOF_SRAAM_V2/input/input.txt");
+		Missile missile = prepareCase(prototype, launch[0]);
+		while (missile.lethality == FLYING and missile.tof < snapshotTime)
+		{
+			sixDofStep(missile, 400.0);
+		}
+		snapshot = takeSnapshot(missile);
+		writeSnapshot(snapshot, "CPP_6DOF_SRAAM_V2/output/snapshot.bin");
+	}
+
+	// Waypoint dispersion, repeatable per run.
+	auto disperse = [waypointSigma](Missile &missile, int run)
+	{
+		mt19937 generator(run);
+		normal_distribution<double> noise(0.0, waypointSigma);
+		for (int c = 0; c < 3; c++)
+		{
+			missile.waypoint[c] += noise(generator);
+		}
+	};
+
+	cout << "\nFAN OUT " << runs << " RUNS FROM " << snapshot.tof << " SECONDS ON " << threads << " THREADS" << endl;
+	vector<sweepResult> results = fanOut(prototype, snapshot, runs, disperse, threads, 400.0);
+	writeSweepResults(results, "CPP_6DOF_SRAAM_V2/output/fanOutResults.txt");
+
+	// Console report and terminate.
+	auto wallClockEnd = chrono::high_resolution_clock::now();
+	auto simRealRunTime = chrono::duration_cast<chrono::milliseconds>(wallClockEnd - wallClockStart);
+	cout << "\nSIMULATION RUN TIME :" << simRealRunTime.count() << " MILLISECONDS" << endl;
+	cout << "\n";
+	return 0;
+
+}
+
+// Hybrid mode. Flies the input.txt missile as a 3DOF until the hand off trigger, then as a 6DOF.
+// Usage: missileModel hybrid [TIME_TO_GO|RANGE|SEEKER_LOCK] [threshold]
+int hybrid(int argc, char *argv[])
+{
+
+	handOffSettings handOff;
+	handOff.trigger = TIME_TO_GO_HAND_OFF;
+	handOff.threshold = 3.0; // Seconds.
+	if (argc > 2)
+	{
+		string trigger = argv[2];
+		if (trigger == "TIME_TO_GO")
+		{
+			handOff.trigger = TIME_TO_GO_HAND_OFF;
+		}
+		else if (trigger == "RANGE")
+		{
+			handOff.trigger = RANGE_HAND_OFF;
+			handOff.threshold = 3000.0; // Meters.
+		}
+		else if (trigger == "SEEKER_LOCK")
+		{
+			handOff.trigger = SEEKER_LOCK_HAND_OFF;
+			handOff.threshold = 3000.0; // Meters.
+		}
+		else
+		{
+			cout << "Unknown hand off trigger " << trigger << endl;
+			exit(1);
+		}
+	}
+	if (argc > 3)
+	{
+		handOff.threshold = stod(argv[3]);
+	}
+
+	Missile prototype;
+	formatTables(prototype, "CPP_6DOF_SRAAM_V2/input/tables.txt");
+
+	vector<sweepCase> launch = readSweepCases("CPP_6DOF_SRAAM_V2/input/input.txt");
+	Missile missile = prepareCase(prototype, launch[0]);
+	hybridFly(missile, launch[0].ID, launch[0].logData, true, 400.0, handOff, launch[0].log);
+
+	// Console report and terminate.
+	auto wallClockEnd = chrono::high_resolution_clock::now();
+	auto simRealRunTime = chrono::duration_cast<chrono::milliseconds>(wallClockEnd - wallClockStart);
+	cout << "\nSIMULATION RUN TIME :" << simRealRunTime.count() << " MILLISECONDS" << endl;
+	cout << "\n";
+	return 0;
+
+}
+
+int main(int argc, char *argv[])
 {
 
+	if (argc > 1 and string(argv[1]) == "sweep")
+	{
+		return sweep(argc, argv);
+	}
+	if (argc > 1 and string(argv[1]) == "fanout")
+	{
+		return fanOutStudy(argc, argv);
+	}
+	if (argc > 1 and string(argv[1]) == "hybrid")
+	{
+		return hybrid(argc, argv);
+	}
+
 	// Instantiate inputs.
 	int    ballistic;
 	int    INTEGRATION_METHOD;
@@ -52,6 +229,10 @@ int main()
 	>> ConsoleReport
 	>> ID;
 
+	// Optional log format, decimation and fields.
+	logSettings log;
+	readLogSettings(InputFile, log);
+
 	// Instantiate missile.
 	Missile missile;
 
@@ -75,12 +256,12 @@ int main()
 	seekerOn(missile);
 
 	// Set lethality to flying. Missile will not fly unless.
-	missile.lethality = "FLYING";
+	missile.lethality = FLYING;
 	missile.isLaunched = true;
 
 	// six dof missile flight.
 	Missile missile1 = clone(missile);
-	sixDofFly(missile1, ID, LogData, ConsoleReport, 400.0);
+	sixDofFly(missile1, ID, LogData, ConsoleReport, 400.0, log);
 
 	// // three dof missile flight.
 	// Missile missile2 = clone(missile);
@@ -17,6 +17,7 @@
 // Missile model.
 #include "missileModel.h"
 #include "secondOrderActuator.h"
+#include "dormandPrince.h"
 #include "ATM1976.h"
 
 // Namespace.
@@ -74,6 +75,10 @@ void formatTables (Missile &missile, string dataFile)
 	int tableNoTrack = 0;
 	// ROW NUMBER
 	int rowNoTrack = 0;
+	// NESTED TABLES AS PARSED
+	vector<vector<vector<double>>> tables;
+	// TABLE NAME INDEX PAIRS
+	map<string, int> tableNameIndexPairs;
 	// VECTOR TO STORE TABLE DIMENSIONS
 	vector<vector<int>> dimensions;
 	// LOOP
@@ -162,7 +167,7 @@ void formatTables (Missile &missile, string dataFile)
 						if (dataPointDouble == 90)
 						{
 							// PLACE IT AT THE FAR RIGHT CORNER
-							missile.tables[tableNoTrack - 1][0].back() = dataPointDouble;
+							tables[tableNoTrack - 1][0].back() = dataPointDouble;
 						}
 						// IF THIS THE FIRST LOOP, THIS IS THE COLUMN IN THE DATA SET THAT DISPLAYS THE "ROWS" VALUES
 						else if (columnCount == 1)
@@ -171,20 +176,20 @@ void formatTables (Missile &missile, string dataFile)
 							if (dimensions[tableNoTrack -1][1] != 2)
 							{
 								// PLACE DATA POINT IN ITS PLACE
-								missile.tables[tableNoTrack - 1][rowNoTrack][0] = dataPointDouble;
+								tables[tableNoTrack - 1][rowNoTrack][0] = dataPointDouble;
 							}
 							// FOR ONE DIMENSIONAL TABLE
 							else
 							{
 								// PLACE DATA POINT IN ITS PLACE
-								missile.tables[tableNoTrack - 1][rowNoTrack - 1][0] = dataPointDouble;
+								tables[tableNoTrack - 1][rowNoTrack - 1][0] = dataPointDouble;
 							}
 						}
 						// IF THIS THE SECOND LOOP, THIS IS THE COLUMN IN THE DATA SET THAT DISPLAYS THE "COLUMNS" VALUES, ONLY FOR TWO DIMENSIONAL TABLES
 						else if (columnCount == 2 and dimensions[tableNoTrack -1][1] != 2)
 						{
 							// PLACE DATA POINT IN ITS PLACE
-							missile.tables[tableNoTrack - 1][0][rowNoTrack] = dataPointDouble;
+							tables[tableNoTrack - 1][0][rowNoTrack] = dataPointDouble;
 						}
 						// ELSE FOR ACTUAL DATA POINTS
 						else
@@ -193,13 +198,13 @@ void formatTables (Missile &missile, string dataFile)
 							if (dimensions[tableNoTrack -1][1] != 2)
 							{
 								// PLACE DATA POINT IN ITS PLACE
-								missile.tables[tableNoTrack - 1][rowNoTrack][columnCount - 2] = dataPointDouble;
+								tables[tableNoTrack - 1][rowNoTrack][columnCount - 2] = dataPointDouble;
 							}
 							// FOR ONE DIMENSIONAL TABLES
 							else
 							{
 								// PLACE DATA POINT IN ITS PLACE
-								missile.tables[tableNoTrack - 1][rowNoTrack - 1][columnCount - 1] = dataPointDouble;
+								tables[tableNoTrack - 1][rowNoTrack - 1][columnCount - 1] = dataPointDouble;
 							}
 						}
 					}
@@ -220,15 +225,32 @@ void formatTables (Missile &missile, string dataFile)
 			// TOP LEFT CORNER OF TABLE UNUSED
 			newTable[0][0] = 0.0;
 			// STORE NEW TABLE IN VECTOR
-			missile.tables.push_back(newTable);
+			tables.push_back(newTable);
 		}
 		// STORE NAME OF TABLE
 		else if (flag == 3)
 		{
 			// MAP TABLE NAME INDEX PAIR
-			missile.tableNameIndexPairs.emplace(name, tableNoTrack - 1);
+			tableNameIndexPairs.emplace(name, tableNoTrack - 1);
 		}
 	}
+	// FLATTEN TABLES FOR LOOK UPS
+	lookUpTables flat = buildLookUpTables(tables, tableNameIndexPairs);
+	for (int i = 0; i < CN0_SLOPE_TABLE; i++)
+	{
+		if (flat.table[i].rows == 0)
+		{
+			cout << "Missing table " << i << " in " << dataFile << endl;
+			exit(1);
+		}
+	}
+	// DERIVE THE SLOPES AND THE LIMIT THE MODULES WOULD OTHERWISE LOOK UP ON EVERY STEP
+	flat.table[CN0_SLOPE_TABLE] = columnSlopeTable(flat[CN0_TABLE], 3.0, 0.0, ALPHA_PRIME_MAX - 3);
+	flat.table[CLM0_SLOPE_TABLE] = columnSlopeTable(flat[CLM0_TABLE], 3.0, 0.0, ALPHA_PRIME_MAX - 3);
+	flat.table[CN0_MAX_TABLE] = columnSlice(flat[CN0_TABLE], ALPHA_PRIME_MAX);
+	flat.table[CNP_MAX_TABLE] = columnSlice(flat[CNP_TABLE], ALPHA_PRIME_MAX);
+	flat.table[CYP_MAX_TABLE] = columnSlice(flat[CYP_TABLE], ALPHA_PRIME_MAX);
+	missile.tables = make_shared<const lookUpTables>(flat);
 }
 
 Missile clone(const Missile &missile)
@@ -236,14 +258,6 @@ Missile clone(const Missile &missile)
 
 	Missile ret;
 	ret = missile;
-	ret.actOne = nullptr;
-	ret.actTwo = nullptr;
-	ret.actThree = nullptr;
-	ret.actFour = nullptr;
-	ret.actOne = make_shared<secondOrderActuator>(*missile.actOne);
-	ret.actTwo = make_shared<secondOrderActuator>(*missile.actTwo);
-	ret.actThree = make_shared<secondOrderActuator>(*missile.actThree);
-	ret.actFour = make_shared<secondOrderActuator>(*missile.actFour);
 	return ret;
 
 }
@@ -273,7 +287,7 @@ void emplace(Missile &missile, double phiRads, double thetaRads, double psiRads,
 	magnitude(missile.enuVel, missile.spd);
 
 	// Set missile lethality.
-	missile.lethality = "LOITERING"; // STATUS
+	missile.lethality = LOITERING; // STATUS
 
 }
 
@@ -323,34 +337,34 @@ void seeker(Missile &missile)
 
 		// Yaw channel.
 		double wlr1d_new = missile.skrWlr2;
-		double wlr1_new = trapezoidIntegrate(wlr1d_new, missile.skrWlr1Dot, missile.skrWlr1, missile.timeStep);
+		double wlr1_new = trapezoidIntegrate(wlr1d_new, missile.skrWlr1Dot, missile.skrWlr1, missile.sampleTime);
 		missile.skrWlr1 = wlr1_new;
 		missile.skrWlr1Dot = wlr1d_new;
 		double wlr2d_new = gg * missile.skrPsiErr - 2 * SEEKER_KF_ZETA * SEEKER_KF_WN * missile.skrWlr1Dot - wsq * missile.skrWlr1;
-		double wlr2_new = trapezoidIntegrate(wlr2d_new, missile.skrWlr2Dot, missile.skrWlr2, missile.timeStep);
+		double wlr2_new = trapezoidIntegrate(wlr2d_new, missile.skrWlr2Dot, missile.skrWlr2, missile.sampleTime);
 		missile.skrWlr2 = wlr2_new;
 		missile.skrWlr2Dot = wlr2d_new;
 
 		// Yaw control.
 		double wlrd_new = missile.skrWlr1 - missile.rate[2];
-		double wlr_new = trapezoidIntegrate(wlrd_new, missile.skrWlrDot, missile.skrWlr, missile.timeStep);
+		double wlr_new = trapezoidIntegrate(wlrd_new, missile.skrWlrDot, missile.skrWlr, missile.sampleTime);
 		missile.skrWlr = wlr_new;
 		missile.skrWlrDot = wlrd_new;
 		missile.skrPsi = missile.skrWlr;
 
 		// Pitch channel.
 		double wlq1d_new = missile.skrWlq2;
-		double wlq1_new = trapezoidIntegrate(wlq1d_new, missile.skrWlq1Dot, missile.skrWlq1, missile.timeStep);
+		double wlq1_new = trapezoidIntegrate(wlq1d_new, missile.skrWlq1Dot, missile.skrWlq1, missile.sampleTime);
 		missile.skrWlq1 = wlq1_new;
 		missile.skrWlq1Dot = wlq1d_new;
 		double wlq2d_new = gg * missile.skrThtErr - 2 * SEEKER_KF_ZETA * SEEKER_KF_WN * missile.skrWlq1Dot - wsq * missile.skrWlq1;
-		double wlq2_new = trapezoidIntegrate(wlq2d_new, missile.skrWlq2Dot, missile.skrWlq2, missile.timeStep);
+		double wlq2_new = trapezoidIntegrate(wlq2d_new, missile.skrWlq2Dot, missile.skrWlq2, missile.sampleTime);
 		missile.skrWlq2 = wlq2_new;
 		missile.skrWlq2Dot = wlq2d_new;
 
 		// Pitch control.
 		double wlqd_new = missile.skrWlq1 - missile.rate[1];
-		double wlq_new = trapezoidIntegrate(wlqd_new, missile.skrWlqDot, missile.skrWlq, missile.timeStep);
+		double wlq_new = trapezoidIntegrate(wlqd_new, missile.skrWlqDot, missile.skrWlq, missile.sampleTime);
 		missile.skrWlq = wlq_new;
 		missile.skrWlqDot = wlqd_new;
 		missile.skrTht = missile.skrWlq;
@@ -475,72 +489,82 @@ void guidance(Missile &missile)
 
 }
 
+// Rate errors the roll, pitch and yaw loops close on. Radians per second.
+static void autopilotRateErrors(const Missile &missile, double &rollPropErr, double &pitchPropErr, double &yawPropErr)
+{
+
+	// Roll.
+	double rollAngleGain = 1.0;
+	double phiAngleError = ROLL_ANGLE_COMMAND - missile.enuAttitude[0]; // Radians.
+	double rollRateCommand = rollAngleGain * phiAngleError; // Radians per second.
+	double signOfRollRateCommand = signum(rollRateCommand); // Non dimensional.
+	if (abs(rollRateCommand) > rollAngleGain) // Limit rate command.
+	{
+		rollRateCommand = rollAngleGain * signOfRollRateCommand;
+	}
+	rollPropErr = rollRateCommand - missile.rate[0];
+
+	// Pitch.
+	double pitchRateCommandLimit = 20;
+	double guidancePitchRateCommand = -missile.normComm * 6 / missile.spd;
+	double signOfPitchRateCommand = signum(guidancePitchRateCommand);
+	if (abs(guidancePitchRateCommand) > pitchRateCommandLimit)
+	{
+		guidancePitchRateCommand = signOfPitchRateCommand * pitchRateCommandLimit;
+	}
+	pitchPropErr = (guidancePitchRateCommand + (missile.grav / missile.spd)) + missile.rate[1];
+
+	// Yaw.
+	double yawRateCommandLimit = 20;
+	double guidanceYawRateCommand = -missile.sideComm * 6 / missile.spd;
+	double signOfYawRateCommand = signum(guidanceYawRateCommand);
+	if (abs(guidanceYawRateCommand) > yawRateCommandLimit)
+	{
+		guidanceYawRateCommand = signOfYawRateCommand * yawRateCommandLimit;
+	}
+	yawPropErr = guidanceYawRateCommand + missile.rate[2];
+
+}
+
 void control(Missile &missile)
 {
 
 	if (!missile.isBallistic)
 	{
 
+		missile.lastRollPropErr = missile.rollPropErr;
+		missile.lastPitchPropErr = missile.pitchPropErr;
+		missile.lastYawPropErr = missile.yawPropErr;
+		autopilotRateErrors(missile, missile.rollPropErr, missile.pitchPropErr, missile.yawPropErr);
+
 		// Roll autopilot.
-		double rollAngleGain = 1.0;
 		double rollRateProportionalGain = 0.011;
 		double rollRateDerivativeGain = 0.000034125;
-		double phiAngleError = ROLL_ANGLE_COMMAND - missile.enuAttitude[0]; // Radians.
-		double rollRateCommand = rollAngleGain * phiAngleError; // Radians per second.
-		double signOfRollRateCommand = signum(rollRateCommand); // Non dimensional.
-		if (abs(rollRateCommand) > rollAngleGain) // Limit rate command.
-		{
-			rollRateCommand = rollAngleGain * signOfRollRateCommand;
-		}
-		missile.lastRollPropErr = missile.rollPropErr;
-		missile.rollPropErr = rollRateCommand - missile.rate[0]; // Radians per second.
-		double derivativeRollRateError = (missile.rollPropErr - missile.lastRollPropErr) / missile.timeStep;
+		double derivativeRollRateError = (missile.rollPropErr - missile.lastRollPropErr) / missile.sampleTime;
 		
 		missile.rollFinComm =
 		rollRateProportionalGain * missile.rollPropErr +
 		rollRateDerivativeGain * derivativeRollRateError; // Radians.
 
 		// Pitch autopilot.
-		double pitchRateCommandLimit = 20;
-		double pitchRateProportionalGain = 0.08;
 		double pitchRateDerivativeGain = 0.000375;
-		double pitchRateIntegralGain = 0.0018;
-		double guidancePitchRateCommand = -missile.normComm * 6 / missile.spd;
-		double signOfPitchRateCommand = signum(guidancePitchRateCommand);
-		if (abs(guidancePitchRateCommand) > pitchRateCommandLimit)
-		{
-			guidancePitchRateCommand = signOfPitchRateCommand * pitchRateCommandLimit;
-		}
-		missile.lastPitchPropErr = missile.pitchPropErr;
-		missile.pitchPropErr = (guidancePitchRateCommand + (missile.grav / missile.spd)) + missile.rate[1];
-		double derivativePitchRateError = (missile.pitchPropErr - missile.lastPitchPropErr) / missile.timeStep;
-		missile.pitchIntErr += (missile.pitchPropErr * missile.timeStep);
+		double derivativePitchRateError = (missile.pitchPropErr - missile.lastPitchPropErr) / missile.sampleTime;
+		missile.pitchIntErr += (missile.pitchPropErr * missile.sampleTime);
 
 		missile.pitchFinComm = 
-		pitchRateProportionalGain * missile.pitchPropErr +
+		PITCH_RATE_PROPORTIONAL_GAIN * missile.pitchPropErr +
 		pitchRateDerivativeGain * derivativePitchRateError +
-		pitchRateIntegralGain * missile.pitchIntErr;
+		PITCH_RATE_INTEGRAL_GAIN * missile.pitchIntErr;
 
 		// Yaw autopilot.
-		double yawRateCommandLimit = 20;
-		double yawRateProportionalGain = 0.11;
 		double yawRateDerivativeGain = 0.000375;
-		double yawRateIntegralGain = 0.0018;
-		double guidanceYawRateCommand = -missile.sideComm * 6 / missile.spd;
-		double signOfYawRateCommand = signum(guidanceYawRateCommand);
-		if (abs(guidanceYawRateCommand) > yawRateCommandLimit)
-		{
-			guidanceYawRateCommand = signOfYawRateCommand * yawRateCommandLimit;
-		}
-		missile.lastYawPropErr = missile.yawPropErr;
-		missile.yawPropErr = guidanceYawRateCommand + missile.rate[2];
-		double derivativeYawRateError = (missile.yawPropErr - missile.lastYawPropErr) / missile.timeStep;
-		missile.yawIntErr += (missile.yawPropErr * missile.timeStep);
+		double derivativeYawRateError = (missile.yawPropErr - missile.lastYawPropErr) / missile.sampleTime;
+		missile.yawIntErr += (missile.yawPropErr * missile.sampleTime);
 
 		missile.yawFinComm =
-		yawRateProportionalGain * missile.yawPropErr +
+		YAW_RATE_PROPORTIONAL_GAIN * missile.yawPropErr +
 		yawRateDerivativeGain * derivativeYawRateError +
-		yawRateIntegralGain * missile.yawIntErr;
+		YAW_RATE_INTEGRAL_GAIN * missile.yawIntErr;
 
 	}
 	else
@@ -566,10 +590,10 @@ void actuators(Missile &missile)
 		double DEL3C = missile.rollFinComm + missile.pitchFinComm - missile.yawFinComm;
 		double DEL4C = missile.rollFinComm + missile.pitchFinComm + missile.yawFinComm;
 
-		missile.finOneDefl = missile.actOne->update(DEL1C * radToDeg, missile.timeStep);
-		missile.finTwoDefl = missile.actTwo->update(DEL2C * radToDeg, missile.timeStep);
-		missile.finThreeDefl = missile.actThree->update(DEL3C * radToDeg, missile.timeStep);
-		missile.finFourDefl = missile.actFour->update(DEL4C * radToDeg, missile.timeStep);
+		missile.finOneDefl = missile.actOne.update(DEL1C * radToDeg, missile.sampleTime);
+		missile.finTwoDefl = missile.actTwo.update(DEL2C * radToDeg, missile.sampleTime);
+		missile.finThreeDefl = missile.actThree.update(DEL3C * radToDeg, missile.sampleTime);
+		missile.finFourDefl = missile.actFour.update(DEL4C * radToDeg, missile.sampleTime);
 
 		// Attitude fin deflections.
 		missile.rollFinDefl = ((-missile.finOneDefl - missile.finTwoDefl + missile.finThreeDefl + missile.finFourDefl) / 4) * degToRad;
@@ -618,91 +642,66 @@ void aerodynamicAnglesAndConversions(Missile &missile)
 void tableLookUps(Missile &missile)
 {
 
-	int index;
 
-	index = missile.tableNameIndexPairs["CA0"];
-	missile.CA0 = linearInterpolationWithBoundedEnds(missile.tables[index], missile.mach);
+	missile.CA0 = lookUp((*missile.tables)[CA0_TABLE], missile.mach, missile.tableBrackets[CA0_TABLE]);
 
-	index = missile.tableNameIndexPairs["CAA"];
-	missile.CAA = linearInterpolationWithBoundedEnds(missile.tables[index], missile.mach);
+	missile.CAA = lookUp((*missile.tables)[CAA_TABLE], missile.mach, missile.tableBrackets[CAA_TABLE]);
 
-	index = missile.tableNameIndexPairs["CAD"];
-	missile.CAD = linearInterpolationWithBoundedEnds(missile.tables[index], missile.mach);
+	missile.CAD = lookUp((*missile.tables)[CAD_TABLE], missile.mach, missile.tableBrackets[CAD_TABLE]);
 
-	index = missile.tableNameIndexPairs["CAOFF"];
 	if (missile.tof <= ROCKET_BURN_OUT_TIME)
 	{
 		missile.CA_POWER_CORRECTION = 0.0;
 	}
 	else
 	{
-		missile.CA_POWER_CORRECTION = linearInterpolationWithBoundedEnds(missile.tables[index], missile.mach);
+		missile.CA_POWER_CORRECTION = lookUp((*missile.tables)[CAOFF_TABLE], missile.mach, missile.tableBrackets[CAOFF_TABLE]);
 	}
 
-	index = missile.tableNameIndexPairs["CYP"];
-	missile.CYP = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, missile.alphaPrimeDegrees);
+	missile.CYP = lookUp((*missile.tables)[CYP_TABLE], missile.mach, missile.alphaPrimeDegrees, missile.tableBrackets[CYP_TABLE]);
 
-	index = missile.tableNameIndexPairs["CYDR"];
-	missile.CYDR = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, missile.alphaPrimeDegrees);
+	missile.CYDR = lookUp((*missile.tables)[CYDR_TABLE], missile.mach, missile.alphaPrimeDegrees, missile.tableBrackets[CYDR_TABLE]);
 
-	index = missile.tableNameIndexPairs["CN0"];
-	missile.CN0 = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, missile.alphaPrimeDegrees);
+	missile.CN0 = lookUp((*missile.tables)[CN0_TABLE], missile.mach, missile.alphaPrimeDegrees, missile.tableBrackets[CN0_TABLE]);
 
-	index = missile.tableNameIndexPairs["CNP"];
-	missile.CNP = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, missile.alphaPrimeDegrees);
+	missile.CNP = lookUp((*missile.tables)[CNP_TABLE], missile.mach, missile.alphaPrimeDegrees, missile.tableBrackets[CNP_TABLE]);
 
-	index = missile.tableNameIndexPairs["CNDQ"];
-	missile.CNDQ = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, missile.alphaPrimeDegrees);
+	missile.CNDQ = lookUp((*missile.tables)[CNDQ_TABLE], missile.mach, missile.alphaPrimeDegrees, missile.tableBrackets[CNDQ_TABLE]);
 
-	index = missile.tableNameIndexPairs["CLLAP"];
-	missile.CLLAP = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, missile.alphaPrimeDegrees);
+	missile.CLLAP = lookUp((*missile.tables)[CLLAP_TABLE], missile.mach, missile.alphaPrimeDegrees, missile.tableBrackets[CLLAP_TABLE]);
 
-	index = missile.tableNameIndexPairs["CLLP"];
-	missile.CLLP = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, missile.alphaPrimeDegrees);
+	missile.CLLP = lookUp((*missile.tables)[CLLP_TABLE], missile.mach, missile.alphaPrimeDegrees, missile.tableBrackets[CLLP_TABLE]);
 
-	index = missile.tableNameIndexPairs["CLLDP"];
-	missile.CLLDP = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, missile.alphaPrimeDegrees);
+	missile.CLLDP = lookUp((*missile.tables)[CLLDP_TABLE], missile.mach, missile.alphaPrimeDegrees, missile.tableBrackets[CLLDP_TABLE]);
 
-	index = missile.tableNameIndexPairs["CLM0"];
-	missile.CLM0 = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, missile.alphaPrimeDegrees);
+	missile.CLM0 = lookUp((*missile.tables)[CLM0_TABLE], missile.mach, missile.alphaPrimeDegrees, missile.tableBrackets[CLM0_TABLE]);
 
-	index = missile.tableNameIndexPairs["CLMP"];
-	missile.CLMP = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, missile.alphaPrimeDegrees);
+	missile.CLMP = lookUp((*missile.tables)[CLMP_TABLE], missile.mach, missile.alphaPrimeDegrees, missile.tableBrackets[CLMP_TABLE]);
 
-	index = missile.tableNameIndexPairs["CLMQ"];
-	missile.CLMQ = linearInterpolationWithBoundedEnds(missile.tables[index], missile.mach);
+	missile.CLMQ = lookUp((*missile.tables)[CLMQ_TABLE], missile.mach, missile.tableBrackets[CLMQ_TABLE]);
 
-	index = missile.tableNameIndexPairs["CLMDQ"];
-	missile.CLMDQ = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, missile.alphaPrimeDegrees);
+	missile.CLMDQ = lookUp((*missile.tables)[CLMDQ_TABLE], missile.mach, missile.alphaPrimeDegrees, missile.tableBrackets[CLMDQ_TABLE]);
 
-	index = missile.tableNameIndexPairs["CLNP"];
-	missile.CLNP = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, missile.alphaPrimeDegrees);
+	missile.CLNP = lookUp((*missile.tables)[CLNP_TABLE], missile.mach, missile.alphaPrimeDegrees, missile.tableBrackets[CLNP_TABLE]);
 
-	index = missile.tableNameIndexPairs["MASS"];
-	missile.mass = linearInterpolationWithBoundedEnds(missile.tables[index], missile.tof);
+	missile.mass = lookUp((*missile.tables)[MASS_TABLE], missile.tof, missile.tableBrackets[MASS_TABLE]);
 
-	index = missile.tableNameIndexPairs["THRUST"];
-	missile.unadjustedThrust = linearInterpolationWithBoundedEnds(missile.tables[index], missile.tof);
+	missile.unadjustedThrust = lookUp((*missile.tables)[THRUST_TABLE], missile.tof, missile.tableBrackets[THRUST_TABLE]);
 
-	index = missile.tableNameIndexPairs["TMOI"];
-	missile.transverseMomentOfInertia = linearInterpolationWithBoundedEnds(missile.tables[index], missile.tof);
+	missile.transverseMomentOfInertia = lookUp((*missile.tables)[TMOI_TABLE], missile.tof, missile.tableBrackets[TMOI_TABLE]);
 
-	index = missile.tableNameIndexPairs["AMOI"];
-	missile.axialMomentOfInertia = linearInterpolationWithBoundedEnds(missile.tables[index], missile.tof);
+	missile.axialMomentOfInertia = lookUp((*missile.tables)[AMOI_TABLE], missile.tof, missile.tableBrackets[AMOI_TABLE]);
 
-	index = missile.tableNameIndexPairs["CG"];
-	missile.centerOfGravityFromNose = linearInterpolationWithBoundedEnds(missile.tables[index], missile.tof);
+	missile.centerOfGravityFromNose = lookUp((*missile.tables)[CG_TABLE], missile.tof, missile.tableBrackets[CG_TABLE]);
 
 }
 
 void accelerationLimit(Missile &missile)
 {
 
-	int index;
 
 	double currentAccelerationEstimate = missile.CN0 * missile.q * REFERENCE_AREA / missile.mass;
-	index = missile.tableNameIndexPairs["CN0"];
-	double CN0MAX = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, ALPHA_PRIME_MAX);
+	double CN0MAX = lookUp((*missile.tables)[CN0_MAX_TABLE], missile.mach, missile.tableBrackets[CN0_MAX_TABLE]);
 	double maximumAccelerationEstimate = CN0MAX * missile.q * REFERENCE_AREA / missile.mass;
 	double availableAccelerationEstimate = maximumAccelerationEstimate - currentAccelerationEstimate;
 
@@ -766,28 +765,13 @@ void aerodynamics(Missile &missile)
 void aerodynamicDerivatives(Missile &missile)
 {
 
-	int index;
 
-	double alphaPrimeDegLookUp;
-	if (missile.alphaPrimeDegrees > (ALPHA_PRIME_MAX - 3))
-	{
-		alphaPrimeDegLookUp = ALPHA_PRIME_MAX - 3;
-	}
-	else
-	{
-		alphaPrimeDegLookUp = missile.alphaPrimeDegrees;
-	}
-	double alphaPrimeDegMinusThree = alphaPrimeDegLookUp - 3;
-	double alphaPrimeDegPlusThree = alphaPrimeDegLookUp + 3;
-	index = missile.tableNameIndexPairs["CN0"];
-	double CN0MIN = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, alphaPrimeDegMinusThree);
-	double CN0MAX = biLinearInterpolationWithBoundedBorders(missile.tables[index],missile.mach, alphaPrimeDegPlusThree);
-	index = missile.tableNameIndexPairs["CLM0"];
-	double CLM0MIN = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, alphaPrimeDegMinusThree);
-	double CLM0MAX = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, alphaPrimeDegPlusThree);
-
-	missile.CNA = ((CN0MAX - CN0MIN) / (alphaPrimeDegPlusThree - alphaPrimeDegMinusThree)) * radToDeg;
-	missile.CMA = ((CLM0MAX - CLM0MIN) / (alphaPrimeDegPlusThree - alphaPrimeDegMinusThree) - (missile.CNA / radToDeg) * (LAUNCH_CENTER_OF_GRAVITY_FROM_NOSE - missile.centerOfGravityFromNose) / REFERENCE_DIAMETER) * radToDeg;
+	// Slopes over alpha prime plus and minus three degrees, held above ALPHA_PRIME_MAX - 3. Tabulated by formatTables.
+	double CN0SLOPE = lookUp((*missile.tables)[CN0_SLOPE_TABLE], missile.mach, missile.alphaPrimeDegrees, missile.tableBrackets[CN0_SLOPE_TABLE]);
+	double CLM0SLOPE = lookUp((*missile.tables)[CLM0_SLOPE_TABLE], missile.mach, missile.alphaPrimeDegrees, missile.tableBrackets[CLM0_SLOPE_TABLE]);
+
+	missile.CNA = CN0SLOPE * radToDeg;
+	missile.CMA = (CLM0SLOPE - (missile.CNA / radToDeg) * (LAUNCH_CENTER_OF_GRAVITY_FROM_NOSE - missile.centerOfGravityFromNose) / REFERENCE_DIAMETER) * radToDeg;
 	missile.CND = missile.CNDQ * radToDeg;
 	missile.CMD = missile.CLMDQ * radToDeg;
 	missile.CMQ = missile.CLMQ * radToDeg;
@@ -1165,11 +1149,10 @@ void rk4IntegrateStates(Missile &missile)
 
 }
 
-void missileMotion(Missile &missile)
+// Forces, moments and state derivatives.
+void missileDerivatives(Missile &missile)
 {
 
-	/* Derivatives. */
-
 	// Forces.
 	double axialForce = missile.thrust - missile.CX * missile.q * REFERENCE_AREA + missile.fluGrav[0] * missile.mass;
 	double sideForce = missile.CY * missile.q * REFERENCE_AREA + missile.fluGrav[1] * missile.mass;
@@ -1198,6 +1181,29 @@ void missileMotion(Missile &missile)
 	missile.enuAttitudeDot[1] = missile.rate[1] * cos(missile.enuAttitude[0]) - missile.rate[2] * sin(missile.enuAttitude[0]);
 	missile.enuAttitudeDot[2] = (missile.rate[1] * sin(missile.enuAttitude[0]) + missile.rate[2] * cos(missile.enuAttitude[0])) / cos(missile.enuAttitude[1]);
 
+}
+
+// Local to body direction cosine matrix and body velocity from the integrated states.
+void missileOrientation(Missile &missile)
+{
+
+	eulerAnglesToLocalOrientation(
+		missile.enuAttitude[0],
+		-missile.enuAttitude[1],
+		missile.enuAttitude[2],
+		missile.enuToFlu
+	);
+
+	threeByThreeTimesThreeByOne(missile.enuToFlu, missile.enuVel, missile.fluVel);
+
+}
+
+void missileMotion(Missile &missile)
+{
+
+	/* Derivatives. */
+	missileDerivatives(missile);
+
 	// STATE.
 	if (missile.INTEGRATION_METHOD == 0)
 	{
@@ -1213,14 +1219,52 @@ void missileMotion(Missile &missile)
 	}
 
 	// Adjust local to body direction cosine matrix.
-	eulerAnglesToLocalOrientation(
-		missile.enuAttitude[0],
-		-missile.enuAttitude[1],
-		missile.enuAttitude[2],
-		missile.enuToFlu
-	);
+	missileOrientation(missile);
 
-	threeByThreeTimesThreeByOne(missile.enuToFlu, missile.enuVel, missile.fluVel);
+	if (missile.INTEGRATION_PASS == 0)
+	{
+		missile.integrationStep += 1;
+	}
+
+}
+
+// Flight software at 600 Hz, the rate the seeker filter and autopilot gains were tuned at.
+const scheduledModule MODULE_SCHEDULE[NUMBER_OF_MODULES] = {
+	{atmosphere, DERIVATIVE_MODULE, 0.0},
+	{seeker, SAMPLED_MODULE, 600.0},
+	{guidance, SAMPLED_MODULE, 600.0},
+	{control, SAMPLED_MODULE, 600.0},
+	{actuators, SAMPLED_MODULE, 600.0},
+	{aerodynamicAnglesAndConversions, DERIVATIVE_MODULE, 0.0},
+	{tableLookUps, DERIVATIVE_MODULE, 0.0},
+	{accelerationLimit, SAMPLED_MODULE, 600.0},
+	{propulsion, DERIVATIVE_MODULE, 0.0},
+	{aerodynamics, DERIVATIVE_MODULE, 0.0},
+	{aerodynamicDerivatives, SAMPLED_MODULE, 600.0},
+	{missileMotion, DERIVATIVE_MODULE, 0.0}
+};
+
+void runScheduledModule(Missile &missile, moduleId module)
+{
+
+	const scheduledModule &entry = MODULE_SCHEDULE[module];
+	if (entry.kind == SAMPLED_MODULE)
+	{
+
+		if (missile.INTEGRATION_PASS != 0)
+		{
+			return;
+		}
+
+		int frames = max(1, static_cast<int>(round(1.0 / (entry.rate * missile.timeStep))));
+		if (missile.integrationStep % frames != 0)
+		{
+			return;
+		}
+		missile.sampleTime = frames * missile.timeStep;
+
+	}
+	entry.run(missile);
 
 }
 
@@ -1234,23 +1278,23 @@ void performanceAndTerminationCheck(Missile &missile, double maxTime)
 
 		if (missile.enuPos[2] < 0)
 		{
-			missile.lethality = "GROUND_COLLISION";
+			missile.lethality = GROUND_COLLISION;
 		}
 		else if (missile.missDistance < 5.0)
 		{
-			missile.lethality = "SUCCESSFUL_INTERCEPT";
+			missile.lethality = SUCCESSFUL_INTERCEPT;
 		}
 		else if (missile.mslToWaypoint[0] < 0)
 		{
-			missile.lethality = "POINT_OF_CLOSEST_APPROACH_PASSED";
+			missile.lethality = POINT_OF_CLOSEST_APPROACH_PASSED;
 		}
 		else if (isnan(missile.enuPos[0]))
 		{
-			missile.lethality = "NOT_A_NUMBER";
+			missile.lethality = NOT_A_NUMBER;
 		}
 		else if (missile.tof > maxTime)
 		{
-			missile.lethality = "MAX_TIME_EXCEEDED";
+			missile.lethality = MAX_TIME_EXCEEDED;
 		}
 
 	}
@@ -1259,15 +1303,15 @@ void performanceAndTerminationCheck(Missile &missile, double maxTime)
 
 		if (missile.enuPos[2] < 0)
 		{
-			missile.lethality = "GROUND_COLLISION";
+			missile.lethality = GROUND_COLLISION;
 		}
 		else if (isnan(missile.enuPos[0]))
 		{
-			missile.lethality = "NOT_A_NUMBER";
+			missile.lethality = NOT_A_NUMBER;
 		}
 		else if (missile.tof > maxTime)
 		{
-			missile.lethality = "MAX_TIME_EXCEEDED";
+			missile.lethality = MAX_TIME_EXCEEDED;
 		}
 
 	}
@@ -1597,26 +1641,53 @@ void logData(Missile &missile, ofstream &logFile)
 	missile.CLD << " " <<
 	missile.staticMargin << " " <<
 	missile.missDistance << " " <<
-	missile.lethality << " " <<
+	LETHALITY_NAMES[missile.lethality] << " " <<
 	missile.isLaunched <<
 	"\n";
 
 }
 
-void sixDofFly(Missile &missile, string flyOutID, bool writeData, bool consoleReport, double flyForThisLong)
+void sixDofStep(Missile &missile, double maxTime)
+{
+
+	do
+	{
+
+		if (missile.INTEGRATION_METHOD == 3)
+		{
+			dormandPrinceStep(missile, maxTime);
+		}
+		else
+		{
+			for (int module = 0; module < NUMBER_OF_MODULES; module++)
+			{
+				runScheduledModule(missile, static_cast<moduleId>(module));
+			}
+
+			if (missile.INTEGRATION_PASS == 0)
+			{
+				performanceAndTerminationCheck(missile, maxTime);
+			}
+		}
+
+	}
+	while (missile.INTEGRATION_PASS != 0);
+
+}
+
+void sixDofFly(Missile &missile, string flyOutID, bool writeData, bool consoleReport, double flyForThisLong, const logSettings &settings)
 {
 
 	// For console report if requested.
 	double lastTime = missile.tof;
 
 	// For log file if requested.
-	ofstream logFile;
+	shared_ptr<trajectoryLogger> logger;
 
 	if (writeData)
 	{
 
-		logFile.open("CPP_6DOF_SRAAM_V2/output/" + flyOutID + "_6DOF.txt");
-		writeLogFileHeader(logFile);
+		logger = makeTrajectoryLogger(flyOutID, settings);
 
 	}
 
@@ -1628,54 +1699,42 @@ void sixDofFly(Missile &missile, string flyOutID, bool writeData, bool consoleRe
 
 	}
 
-	while (missile.lethality == "FLYING")
+	while (missile.lethality == FLYING)
 	{
 
-		atmosphere(missile);
-		seeker(missile);
-		guidance(missile);
-		control(missile);
-		actuators(missile);
-		aerodynamicAnglesAndConversions(missile);
-		tableLookUps(missile);
-		accelerationLimit(missile);
-		propulsion(missile);
-		aerodynamics(missile);
-		aerodynamicDerivatives(missile);
-		missileMotion(missile);
-
-		if (missile.INTEGRATION_PASS == 0)
+		sixDofStep(missile, flyForThisLong);
+
+		if (writeData)
 		{
-			performanceAndTerminationCheck(missile, flyForThisLong);
 
-			if (writeData)
-			{
+			logger->log(missile);
 
-				logData(missile, logFile);
+		}
+		
+		if (consoleReport)
+		{
 
+			// Adaptive steps rarely land on a whole second.
+			auto print_it = static_cast<int>(round(missile.tof * 10000.0)) % 10000;
+			if (missile.INTEGRATION_METHOD == 3)
+			{
+				print_it = (floor(missile.tof) > floor(lastTime)) ? 0 : 1;
 			}
-			
-			if (consoleReport)
+			if (print_it == 0)
 			{
-
-				auto print_it = static_cast<int>(round(missile.tof * 10000.0)) % 10000;
-				if (print_it == 0)
-				{
-					cout
-					<< setprecision(6)
-					<< missile.tof
-					<< " E "
-					<< missile.enuPos[0]
-					<< " N "
-					<< missile.enuPos[1]
-					<< " U "
-					<< missile.enuPos[2]
-					<< " MACH "
-					<< missile.mach
-					<< endl;
-					lastTime = missile.tof;
-				}
-
+				cout
+				<< setprecision(6)
+				<< missile.tof
+				<< " E "
+				<< missile.enuPos[0]
+				<< " N "
+				<< missile.enuPos[1]
+				<< " U "
+				<< missile.enuPos[2]
+				<< " MACH "
+				<< missile.mach
+				<< endl;
+				lastTime = missile.tof;
 			}
 
 		}
@@ -1688,14 +1747,27 @@ void sixDofFly(Missile &missile, string flyOutID, bool writeData, bool consoleRe
 		cout << "\n";
 		cout << "6DOF " + flyOutID + " REPORT" << endl;
 		cout << setprecision(2) << "FINAL POSITION AT " << missile.tof << " E " << missile.enuPos[0] << " N " << missile.enuPos[1] << " U " << missile.enuPos[2] << " MACH " << missile.mach << endl;
-		cout << setprecision(2) << "MISS DISTANCE " << missile.missDistance << " FORWARD, LEFT, UP, MISS DISTANCE " << missile.mslToWaypoint[0] << " " << missile.mslToWaypoint[1] << " " << missile.mslToWaypoint[2] << endl;
-		cout << "SIMULATION RESULT: " << missile.lethality << endl;
+		if (missile.INTEGRATION_METHOD == 3)
+		{
+			// The located miss distance is geometric, so report its components rather than the seeker's view.
+			double relPos[3] = {missile.enuPos[0] - missile.waypoint[0], missile.enuPos[1] - missile.waypoint[1], missile.enuPos[2] - missile.waypoint[2]};
+			cout << setprecision(2) << "MISS DISTANCE " << missile.missDistance << " E, N, U, MISS DISTANCE " << relPos[0] << " " << relPos[1] << " " << relPos[2] << endl;
+		}
+		else
+		{
+			cout << setprecision(2) << "MISS DISTANCE " << missile.missDistance << " FORWARD, LEFT, UP, MISS DISTANCE " << missile.mslToWaypoint[0] << " " << missile.mslToWaypoint[1] << " " << missile.mslToWaypoint[2] << endl;
+		}
+		cout << "SIMULATION RESULT: " << LETHALITY_NAMES[missile.lethality] << endl;
+		if (missile.INTEGRATION_METHOD == 3)
+		{
+			cout << "ACCEPTED STEPS " << missile.acceptedSteps << " REJECTED STEPS " << missile.rejectedSteps << endl;
+		}
 
 	}
 
 }
 
-void threeDofFly(Missile &missile, string flyOutID, bool writeData, bool consoleReport, double flyForThisLong)
+void threeDofFly(Missile &missile, string flyOutID, bool writeData, bool consoleReport, double flyForThisLong, const handOffSettings &handOff)
 {
 
 	const double TIME_STEP = 0.01; // Seconds.
@@ -1719,11 +1791,10 @@ void threeDofFly(Missile &missile, string flyOutID, bool writeData, bool console
 	
 	double lastTime = 0.0;
 
-	while (missile.lethality == "FLYING")
+	while (missile.lethality == FLYING and !handOffReached(missile, handOff))
 	{
 
 		// Common.
-		int index;
 		double TEMP;
 
 		// Time of flight.
@@ -1745,32 +1816,24 @@ void threeDofFly(Missile &missile, string flyOutID, bool writeData, bool console
 		aerodynamicAnglesAndConversions(missile);
 
 		// Lookups.
-		index = missile.tableNameIndexPairs["MASS"];
-		missile.mass = linearInterpolationWithBoundedEnds(missile.tables[index], missile.tof);
-		index = missile.tableNameIndexPairs["THRUST"];
-		missile.unadjustedThrust = linearInterpolationWithBoundedEnds(missile.tables[index], missile.tof);
-		index = missile.tableNameIndexPairs["CA0"];
-		missile.CA0 = linearInterpolationWithBoundedEnds(missile.tables[index], missile.mach);
-		index = missile.tableNameIndexPairs["CAA"];
-		missile.CAA = linearInterpolationWithBoundedEnds(missile.tables[index], missile.mach);
+		missile.mass = lookUp((*missile.tables)[MASS_TABLE], missile.tof, missile.tableBrackets[MASS_TABLE]);
+		missile.unadjustedThrust = lookUp((*missile.tables)[THRUST_TABLE], missile.tof, missile.tableBrackets[THRUST_TABLE]);
+		missile.CA0 = lookUp((*missile.tables)[CA0_TABLE], missile.mach, missile.tableBrackets[CA0_TABLE]);
+		missile.CAA = lookUp((*missile.tables)[CAA_TABLE], missile.mach, missile.tableBrackets[CAA_TABLE]);
 		if (missile.tof <= ROCKET_BURN_OUT_TIME)
 		{
 			missile.CA_POWER_CORRECTION = 0.0;
 		}
 		else
 		{
-			index = missile.tableNameIndexPairs["CAOFF"];
-			missile.CA_POWER_CORRECTION = linearInterpolationWithBoundedEnds(missile.tables[index], missile.mach);
+			missile.CA_POWER_CORRECTION = lookUp((*missile.tables)[CAOFF_TABLE], missile.mach, missile.tableBrackets[CAOFF_TABLE]);
 		}
-		index = missile.tableNameIndexPairs["CYP"];
-		missile.CYP = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, missile.alphaPrimeDegrees);
-		double CYP_Max = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, ALPHA_PRIME_MAX);
-		index = missile.tableNameIndexPairs["CN0"];
-		missile.CN0 = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, missile.alphaPrimeDegrees);
-		double CN0_Max = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, ALPHA_PRIME_MAX);
-		index = missile.tableNameIndexPairs["CNP"];
-		missile.CNP = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, missile.alphaPrimeDegrees);
-		double CNP_Max = biLinearInterpolationWithBoundedBorders(missile.tables[index], missile.mach, ALPHA_PRIME_MAX);
+		missile.CYP = lookUp((*missile.tables)[CYP_TABLE], missile.mach, missile.alphaPrimeDegrees, missile.tableBrackets[CYP_TABLE]);
+		double CYP_Max = lookUp((*missile.tables)[CYP_MAX_TABLE], missile.mach, missile.tableBrackets[CYP_MAX_TABLE]);
+		missile.CN0 = lookUp((*missile.tables)[CN0_TABLE], missile.mach, missile.alphaPrimeDegrees, missile.tableBrackets[CN0_TABLE]);
+		double CN0_Max = lookUp((*missile.tables)[CN0_MAX_TABLE], missile.mach, missile.tableBrackets[CN0_MAX_TABLE]);
+		missile.CNP = lookUp((*missile.tables)[CNP_TABLE], missile.mach, missile.alphaPrimeDegrees, missile.tableBrackets[CNP_TABLE]);
+		double CNP_Max = lookUp((*missile.tables)[CNP_MAX_TABLE], missile.mach, missile.tableBrackets[CNP_MAX_TABLE]);
 
 
 		// Propulsion.
@@ -1858,7 +1921,7 @@ void threeDofFly(Missile &missile, string flyOutID, bool writeData, bool console
 			missile.waypoint[2] << " " <<
 			missile.alphaRadians << " " <<
 			missile.betaRadians << " " <<
-			missile.lethality << endl;
+			LETHALITY_NAMES[missile.lethality] << endl;
 		}
 
 		if (consoleReport)
@@ -1879,10 +1942,178 @@ void threeDofFly(Missile &missile, string flyOutID, bool writeData, bool console
 		cout << "3DOF " + flyOutID + " REPORT" << endl;
 		cout << setprecision(6) << "FINAL POSITION AT " << missile.tof << " E " << missile.enuPos[0] << " N " << missile.enuPos[1] << " U " << missile.enuPos[2] << " MACH " << missile.mach << endl;
 		cout << setprecision(6) << "MISS DISTANCE " << missile.missDistance << " FORWARD, LEFT, UP, MISS DISTANCE " << missile.mslToWaypoint[0] << " " << missile.mslToWaypoint[1] << " " << missile.mslToWaypoint[2] << endl;
-		cout << "SIMULATION RESULT: " << missile.lethality << endl;
+		cout << "SIMULATION RESULT: " << LETHALITY_NAMES[missile.lethality] << endl;
 		cout << "\n";
 	}
 
 }
 
+// Hybrid flyout. The 3DOF flies the boost and midcourse, the 6DOF flies from the hand off on.
+void hybridFly(Missile &missile, string flyOutID, bool writeData, bool consoleReport, double flyForThisLong, const handOffSettings &handOff, const logSettings &settings)
+{
+
+	threeDofFly(missile, flyOutID, writeData, consoleReport, flyForThisLong, handOff);
+
+	if (missile.lethality == FLYING)
+	{
 
+		if (consoleReport)
+		{
+			cout << setprecision(6) << "HAND OFF TO 6DOF AT " << missile.tof << endl;
+		}
+		handOffToSixDof(missile);
+		sixDofFly(missile, flyOutID, writeData, consoleReport, flyForThisLong, settings);
+
+	}
+
+}
+
+bool handOffReached(Missile &missile, const handOffSettings &handOff)
+{
+
+	double relPos[3];
+	subtractTwoVectors(missile.enuPos, missile.waypoint, relPos);
+	double range;
+	magnitude(relPos, range);
+
+	if (handOff.trigger == TIME_TO_GO_HAND_OFF)
+	{
+		double closingSpeed;
+		dotProductTwoVectors(relPos, missile.enuVel, closingSpeed);
+		closingSpeed /= range;
+		return closingSpeed > 0.0 and range / closingSpeed < handOff.threshold;
+	}
+	else if (handOff.trigger == RANGE_HAND_OFF)
+	{
+		return range < handOff.threshold;
+	}
+	else if (handOff.trigger == SEEKER_LOCK_HAND_OFF)
+	{
+		double lookAngleCosine;
+		dotProductTwoVectors(relPos, missile.enuToFlu[0], lookAngleCosine);
+		lookAngleCosine /= range;
+		return range < handOff.threshold and lookAngleCosine > cos(SEEKER_FIELD_OF_REGARD * degToRad);
+	}
+	return false;
+
+}
+
+// Rebuilds the 6DOF states from a 3DOF flyout. The body is trimmed about the velocity
+// for the 3DOF acceleration, turns at the flight path rates, and the fins, actuators and
+// autopilot integrators hold the trim deflections.
+void handOffToSixDof(Missile &missile)
+{
+
+	// Flight path angles and rates.
+	double azimuth, elevation;
+	azAndElFromVector(azimuth, elevation, missile.enuVel);
+	magnitude(missile.enuVel, missile.spd);
+	double horizontalSpeedSquared = missile.enuVel[0] * missile.enuVel[0] + missile.enuVel[1] * missile.enuVel[1];
+	double horizontalSpeed = sqrt(horizontalSpeedSquared);
+	double azimuthDot = (missile.enuVel[0] * missile.enuAcc[1] - missile.enuVel[1] * missile.enuAcc[0]) / horizontalSpeedSquared;
+	double elevationDot =
+	(horizontalSpeedSquared * missile.enuAcc[2] - missile.enuVel[2] * (missile.enuVel[0] * missile.enuAcc[0] + missile.enuVel[1] * missile.enuAcc[1])) /
+	(missile.spd * missile.spd * horizontalSpeed);
+
+	// Trim angles for the 3DOF lateral acceleration. The normal force and the axial force,
+	// thrust included, tilted off the velocity. CN0 is not linear in alpha prime, so the
+	// trim iterates on its secant.
+	atmosphere(missile);
+	double axialForce = missile.thrust - missile.CX * missile.q * REFERENCE_AREA;
+	double normalTrimForce = missile.spcfForce[2] - missile.fluGrav[2]; // Meters per second^2.
+	double sideTrimForce = -1.0 * (missile.spcfForce[1] - missile.fluGrav[1]); // Meters per second^2.
+	double trimForce = sqrt(normalTrimForce * normalTrimForce + sideTrimForce * sideTrimForce);
+	double alphaTrimDegrees = 0.0;
+	double betaTrimDegrees = 0.0;
+	if (trimForce > 0.0)
+	{
+		double alphaPrimeTrimDegrees = 1.0;
+		for (int i = 0; i < 10; i++)
+		{
+			double CN0 = lookUp((*missile.tables)[CN0_TABLE], missile.mach, alphaPrimeTrimDegrees, missile.tableBrackets[CN0_TABLE]);
+			double forcePerDegree = (CN0 / alphaPrimeTrimDegrees * missile.q * REFERENCE_AREA + axialForce * degToRad) / missile.mass;
+			if (forcePerDegree <= 0.0)
+			{
+				break;
+			}
+			alphaPrimeTrimDegrees = min(trimForce / forcePerDegree, ALPHA_PRIME_MAX);
+		}
+		alphaTrimDegrees = alphaPrimeTrimDegrees * normalTrimForce / trimForce;
+		betaTrimDegrees = alphaPrimeTrimDegrees * sideTrimForce / trimForce;
+	}
+
+	// Attitude, wings level, and body rates that hold it on the flight path.
+	missile.enuAttitude[0] = 0.0;
+	missile.enuAttitude[1] = elevation + alphaTrimDegrees * degToRad;
+	missile.enuAttitude[2] = azimuth - betaTrimDegrees * degToRad;
+	missileOrientation(missile);
+	missile.rate[0] = -1.0 * azimuthDot * sin(missile.enuAttitude[1]);
+	missile.rate[1] = elevationDot;
+	missile.rate[2] = azimuthDot * cos(missile.enuAttitude[1]);
+	setArrayEquivalentToZero(missile.rateDot);
+	setArrayEquivalentToZero(missile.enuAttitudeDot);
+
+	// Trim fin deflections. Zero roll moment, and zero pitch and yaw moment in the aero ballistic frame.
+	missile.rollFinDefl = 0.0;
+	missile.pitchFinDefl = 0.0;
+	missile.yawFinDefl = 0.0;
+	aerodynamicAnglesAndConversions(missile);
+	tableLookUps(missile);
+	double arm = (LAUNCH_CENTER_OF_GRAVITY_FROM_NOSE - missile.centerOfGravityFromNose) / REFERENCE_DIAMETER;
+	double rateScale = REFERENCE_DIAMETER / (2 * missile.spd);
+	double rollFinDegrees = -1.0 *
+	(missile.CLLAP * missile.alphaPrimeDegrees * missile.alphaPrimeDegrees * missile.sinOfFourTimesPhiPrime + missile.CLLP * missile.rollRateDegrees * rateScale) /
+	missile.CLLDP;
+	double pitchAeroDeflDegrees = -1.0 *
+	(missile.CLM0 + missile.CLMP * missile.squaredSinOfTwoTimesPhiPrime + missile.CLMQ * missile.pitchAeroBallisticBodyRateDegrees * rateScale -
+	(missile.CN0 + missile.CNP * missile.squaredSinOfTwoTimesPhiPrime) * arm) /
+	(missile.CLMDQ - missile.CNDQ * arm);
+	double yawAeroDeflDegrees = -1.0 *
+	(missile.CLNP * missile.sinOfFourTimesPhiPrime + missile.CLMQ * missile.yawAeroBallisticBodyRateDegrees * rateScale -
+	missile.CYP * missile.sinOfFourTimesPhiPrime * arm) /
+	(missile.CLMDQ - missile.CYDR * arm);
+	double pitchFinDegrees = pitchAeroDeflDegrees * missile.cosPhiPrime + yawAeroDeflDegrees * missile.sinPhiPrime;
+	double yawFinDegrees = -1.0 * pitchAeroDeflDegrees * missile.sinPhiPrime + yawAeroDeflDegrees * missile.cosPhiPrime;
+
+	// Actuators at rest on the trim deflections.
+	secondOrderActuator *fins[4] = {&missile.actOne, &missile.actTwo, &missile.actThree, &missile.actFour};
+	double finDeflections[4] = {
+		-rollFinDegrees + pitchFinDegrees - yawFinDegrees,
+		-rollFinDegrees + pitchFinDegrees + yawFinDegrees,
+		rollFinDegrees + pitchFinDegrees - yawFinDegrees,
+		rollFinDegrees + pitchFinDegrees + yawFinDegrees
+	};
+	for (int i = 0; i < 4; i++)
+	{
+		*fins[i] = secondOrderActuator();
+		finDeflections[i] = max(-fins[i]->deflectionLimit, min(fins[i]->deflectionLimit, finDeflections[i]));
+		fins[i]->deflection = finDeflections[i];
+	}
+	missile.finOneDefl = finDeflections[0];
+	missile.finTwoDefl = finDeflections[1];
+	missile.finThreeDefl = finDeflections[2];
+	missile.finFourDefl = finDeflections[3];
+	missile.rollFinDefl = ((-finDeflections[0] - finDeflections[1] + finDeflections[2] + finDeflections[3]) / 4) * degToRad;
+	missile.pitchFinDefl = ((finDeflections[0] + finDeflections[1] + finDeflections[2] + finDeflections[3]) / 4) * degToRad;
+	missile.yawFinDefl = ((-finDeflections[0] + finDeflections[1] - finDeflections[2] + finDeflections[3]) / 4) * degToRad;
+	aerodynamicAnglesAndConversions(missile);
+
+	// Autopilot. The rate errors start where the loops see them, with no derivative kick,
+	// and the integrators hold whatever trim the proportional terms leave over.
+	autopilotRateErrors(missile, missile.rollPropErr, missile.pitchPropErr, missile.yawPropErr);
+	missile.lastRollPropErr = missile.rollPropErr;
+	missile.lastPitchPropErr = missile.pitchPropErr;
+	missile.lastYawPropErr = missile.yawPropErr;
+	missile.pitchIntErr = (missile.pitchFinDefl - PITCH_RATE_PROPORTIONAL_GAIN * missile.pitchPropErr) / PITCH_RATE_INTEGRAL_GAIN;
+	missile.yawIntErr = (missile.yawFinDefl - YAW_RATE_PROPORTIONAL_GAIN * missile.yawPropErr) / YAW_RATE_INTEGRAL_GAIN;
+
+	// Seeker from the new body axis.
+	seekerOn(missile);
+
+	// Integration starts from a fresh step.
+	missile.INTEGRATION_PASS = 0;
+	missile.integrationStep = 0;
+	missile.sampleTime = missile.timeStep;
+	missile.nextTimeStep = 0.0;
+
+}
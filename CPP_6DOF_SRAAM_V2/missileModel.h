@@ -15,6 +15,8 @@ using namespace std;
 
 // Components.
 #include "secondOrderActuator.h"
+#include "lookUpTables.h"
+#include "trajectoryLogger.h"
 
 #ifndef MISSILEMODEL_H
 #define MISSILEMODEL_H
@@ -37,6 +39,52 @@ const double ROLL_ANGLE_COMMAND                 = 0.0; // Radians.
 const double ALPHA_PRIME_MAX                    = 40.0; // Degrees.
 const double SEA_LEVEL_PRESSURE                 = 101325; // Pascals.
 const double LAUNCH_CENTER_OF_GRAVITY_FROM_NOSE = 1.5357; // Meters.
+const double PITCH_RATE_PROPORTIONAL_GAIN       = 0.08; // Pitch autopilot proportional gain. Seconds.
+const double PITCH_RATE_INTEGRAL_GAIN           = 0.0018; // Pitch autopilot integral gain. Per second.
+const double YAW_RATE_PROPORTIONAL_GAIN         = 0.11; // Yaw autopilot proportional gain. Seconds.
+const double YAW_RATE_INTEGRAL_GAIN             = 0.0018; // Yaw autopilot integral gain. Per second.
+const double SEEKER_FIELD_OF_REGARD             = 45.0; // Seeker look angle limit off the body axis. Degrees.
+
+/* Flight status. The text logs and reports print the names. */
+enum missileLethality
+{
+	FLYING,
+	LOITERING,
+	GROUND_COLLISION,
+	SUCCESSFUL_INTERCEPT,
+	POINT_OF_CLOSEST_APPROACH_PASSED,
+	NOT_A_NUMBER,
+	MAX_TIME_EXCEEDED,
+	NUMBER_OF_LETHALITIES
+};
+
+const char *const LETHALITY_NAMES[NUMBER_OF_LETHALITIES] =
+{
+	"FLYING",
+	"LOITERING",
+	"GROUND_COLLISION",
+	"SUCCESSFUL_INTERCEPT",
+	"POINT_OF_CLOSEST_APPROACH_PASSED",
+	"NOT_A_NUMBER",
+	"MAX_TIME_EXCEEDED"
+};
+
+/* When a hybrid flyout hands the 3DOF over to the 6DOF. */
+enum handOffTrigger
+{
+	NO_HAND_OFF, // The 3DOF flies to termination.
+	TIME_TO_GO_HAND_OFF, // Time to go below the threshold. Seconds.
+	RANGE_HAND_OFF, // Range to the waypoint below the threshold. Meters.
+	SEEKER_LOCK_HAND_OFF // Waypoint within the threshold and inside the seeker field of regard. Meters.
+};
+
+struct handOffSettings
+{
+
+	handOffTrigger trigger = NO_HAND_OFF;
+	double threshold = 0.0;
+
+};
 
 /* This struct fully represents a missile. */
 struct Missile
@@ -52,6 +100,8 @@ struct Missile
 	bool isLaunched     = false; // flag to indicate whether or not the missile is free to launch
 	double timeStep     = (1.0 / 600.0); // missile integration time step
 	double halfTimeStep = timeStep * 0.5; // missile half integration time step for runge kutta methods
+	double sampleTime   = timeStep; // period of the sampled module being run
+	int integrationStep = 0; // completed integration steps
 
 	// Body.
 	double fluVel[3];    // missile velocity in the body frame in m/s (INIT)
@@ -122,14 +172,10 @@ struct Missile
 	double rollFinComm      = 0.0; // Radians.
 
 	// Actuators.
-	shared_ptr<secondOrderActuator> actOne   =
-		make_shared<secondOrderActuator>(); // pointer to actuator one
-	shared_ptr<secondOrderActuator> actTwo   =
-		make_shared<secondOrderActuator>(); // pointer to actuator two
-	shared_ptr<secondOrderActuator> actThree =
-		make_shared<secondOrderActuator>(); // pointer to actuator three
-	shared_ptr<secondOrderActuator> actFour  =
-		make_shared<secondOrderActuator>(); // pointer to actuator four
+	secondOrderActuator actOne; // Actuator one.
+	secondOrderActuator actTwo; // Actuator two.
+	secondOrderActuator actThree; // Actuator three.
+	secondOrderActuator actFour; // Actuator four.
 	double finOneDefl                        = 0.0; // Fin deflection. Radians.
 	double finTwoDefl                        = 0.0; // Fin deflection. Radians.
 	double finThreeDefl                      = 0.0; // Fin deflection. Radians.
@@ -154,8 +200,8 @@ struct Missile
 	double squaredSinOfTwoTimesPhiPrime = 0.0; // Non dimensional.
 
 	// Table look ups.
-	map<string, int> tableNameIndexPairs;
-	vector<vector<vector<double>>> tables;
+	shared_ptr<const lookUpTables> tables; // Shared read only between clones.
+	tableBracket tableBrackets[NUMBER_OF_TABLES]; // Cell of the last look up in each table.
 
 	// Aerodynamics.
 	double CA0 = 0.0; // Axial force coefficient. Non dimensional.
@@ -206,7 +252,7 @@ struct Missile
 
 	// Performance and termination check.
 	double missDistance = 0.0; // Meters.
-	string lethality;
+	missileLethality lethality = LOITERING;
 
 	// Integration states.
 	// P  = ENUPosition
@@ -216,9 +262,18 @@ struct Missile
 	// ED = ENUEulerDot
 	// W  = BodyRate
 	// WD = BodyRateDot.
-	int INTEGRATION_METHOD = 2;
+	int INTEGRATION_METHOD = 2; // 0 = Euler, 1 = RK2, 2 = RK4, 3 = Dormand Prince 5(4), adaptive.
 	int INTEGRATION_PASS = 0;
 
+	// Dormand Prince step control.
+	double relativeTolerance = 1e-6; // Non dimensional.
+	double absoluteTolerance = 1e-6; // State units.
+	double minimumTimeStep   = 1e-5; // Seconds.
+	double maximumTimeStep   = (1.0 / 100.0); // Seconds. Fins are held across a step.
+	double nextTimeStep      = 0.0; // Proposed by the error control. Zero starts from timeStep. Seconds.
+	int acceptedSteps        = 0;
+	int rejectedSteps        = 0;
+
 	double P0[3] = {0.0, 0.0, 0.0};
 	double V0[3] = {0.0, 0.0, 0.0};
 	double E0[3] = {0.0, 0.0, 0.0};
@@ -263,7 +318,73 @@ void formatTables (Missile &missile, string dataFile);
 Missile clone(const Missile &missile);
 void emplace(Missile &missile, double phi, double theta, double psi, double ENUPosition[3]);
 void seekerOn(Missile &missile);
-void sixDofFly(Missile &missile, string flyOutID, bool writeData, bool consoleReport, double maxTime);
-void threeDofFly(Missile &missile, string flyOutID, bool writeData, bool consoleReport, double maxTime);
+void sixDofStep(Missile &missile, double maxTime); // One full integration step, then the termination check.
+void sixDofFly(Missile &missile, string flyOutID, bool writeData, bool consoleReport, double maxTime, const logSettings &settings = logSettings());
+void threeDofFly(Missile &missile, string flyOutID, bool writeData, bool consoleReport, double maxTime, const handOffSettings &handOff = handOffSettings());
+void hybridFly(Missile &missile, string flyOutID, bool writeData, bool consoleReport, double maxTime, const handOffSettings &handOff, const logSettings &settings = logSettings());
+bool handOffReached(Missile &missile, const handOffSettings &handOff);
+void handOffToSixDof(Missile &missile);
+
+// Modules. Scheduled in this order, see MODULE_SCHEDULE.
+void atmosphere(Missile &missile);
+void seeker(Missile &missile);
+void guidance(Missile &missile);
+void control(Missile &missile);
+void actuators(Missile &missile);
+void aerodynamicAnglesAndConversions(Missile &missile);
+void tableLookUps(Missile &missile);
+void accelerationLimit(Missile &missile);
+void propulsion(Missile &missile);
+void aerodynamics(Missile &missile);
+void aerodynamicDerivatives(Missile &missile);
+void missileDerivatives(Missile &missile);
+void missileOrientation(Missile &missile);
+void missileMotion(Missile &missile);
+void performanceAndTerminationCheck(Missile &missile, double maxTime);
+
+/* Module schedule.
+Derivative modules run on every integration pass, so each runge kutta stage sees them.
+Sampled modules run at the start of a step at their own rate and hold their outputs in
+between. A sampled module reads its period from sampleTime. */
+enum moduleId
+{
+	ATMOSPHERE_MODULE,
+	SEEKER_MODULE,
+	GUIDANCE_MODULE,
+	CONTROL_MODULE,
+	ACTUATORS_MODULE,
+	AERODYNAMIC_ANGLES_MODULE,
+	TABLE_LOOK_UPS_MODULE,
+	ACCELERATION_LIMIT_MODULE,
+	PROPULSION_MODULE,
+	AERODYNAMICS_MODULE,
+	AERODYNAMIC_DERIVATIVES_MODULE,
+	MISSILE_MOTION_MODULE,
+	NUMBER_OF_MODULES
+};
+
+enum moduleKind
+{
+	DERIVATIVE_MODULE,
+	SAMPLED_MODULE
+};
+
+struct scheduledModule
+{
+
+	void (*run)(Missile &missile);
+	moduleKind kind;
+	double rate; // Sampled modules only. Rounded to a whole number of integration steps. Hertz.
+
+};
+
+extern const scheduledModule MODULE_SCHEDULE[NUMBER_OF_MODULES];
+
+// Runs a module if it is due on the current integration pass.
+void runScheduledModule(Missile &missile, moduleId module);
+
+// Log file.
+void writeLogFileHeader(ofstream &logFile);
+void logData(Missile &missile, ofstream &logFile);
 
 #endif
\ No newline at end of file
@@ -22,6 +22,7 @@ secondOrderActuator::secondOrderActuator()
 {
 
 	time = 0.0;
+	timeStep = 0.0;
 
 	deflectionLimit = 28.0;
 	deflectionRateLimit = 250;
@@ -0,0 +1,235 @@
+// Standard.
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstring>
+#include <type_traits>
+
+// Namespace.
+using namespace std;
+
+// Header.
+#include "snapshot.h"
+
+static_assert(is_trivially_copyable<missileSnapshot>::value, "missileSnapshot must stay plain data");
+
+/* Snapshot file format. */
+static const char SNAPSHOT_MAGIC[8] = {'S', 'R', 'A', 'A', 'M', 'S', 'N', 'P'};
+static const int SNAPSHOT_VERSION = 3;
+
+// Copies one field from the missile into the snapshot.
+struct captureField
+{
+
+	template <typename T>
+	void operator()(const T &missileField, T &snapshotField) const
+	{
+		snapshotField = missileField;
+	}
+
+	template <typename T, size_t N>
+	void operator()(const T (&missileField)[N], T (&snapshotField)[N]) const
+	{
+		for (size_t i = 0; i < N; i++)
+		{
+			(*this)(missileField[i], snapshotField[i]);
+		}
+	}
+
+};
+
+// Copies one field from the snapshot back into the missile.
+struct restoreField
+{
+
+	template <typename T>
+	void operator()(T &missileField, const T &snapshotField) const
+	{
+		missileField = snapshotField;
+	}
+
+	template <typename T, size_t N>
+	void operator()(T (&missileField)[N], const T (&snapshotField)[N]) const
+	{
+		for (size_t i = 0; i < N; i++)
+		{
+			(*this)(missileField[i], snapshotField[i]);
+		}
+	}
+
+};
+
+template <typename Actuator, typename Snapshot, typename Transfer>
+static void exchangeActuator(Actuator &actuator, Snapshot &snapshot, Transfer transfer)
+{
+
+	transfer(actuator.time, snapshot.time);
+	transfer(actuator.timeStep, snapshot.timeStep);
+	transfer(actuator.deflectionLimit, snapshot.deflectionLimit);
+	transfer(actuator.deflectionRateLimit, snapshot.deflectionRateLimit);
+	transfer(actuator.wn, snapshot.wn);
+	transfer(actuator.zeta, snapshot.zeta);
+	transfer(actuator.deflection, snapshot.deflection);
+	transfer(actuator.deflectionDerivative, snapshot.deflectionDerivative);
+	transfer(actuator.deflectionDot, snapshot.deflectionDot);
+	transfer(actuator.deflectionDotDerivative, snapshot.deflectionDotDerivative);
+
+}
+
+// One field list for both directions. Capturing reads a const missile, restoring a const snapshot.
+template <typename MissileType, typename SnapshotType, typename Transfer>
+static void exchangeMissile(MissileType &missile, SnapshotType &snapshot, Transfer transfer)
+{
+
+	// Status.
+	transfer(missile.lethality, snapshot.lethality);
+	transfer(missile.isBallistic, snapshot.isBallistic);
+	transfer(missile.isLaunched, snapshot.isLaunched);
+	transfer(missile.waypoint, snapshot.waypoint);
+	transfer(missile.tof, snapshot.tof);
+	transfer(missile.rng, snapshot.rng);
+	transfer(missile.missDistance, snapshot.missDistance);
+
+	// Airframe.
+	transfer(missile.enuPos, snapshot.enuPos);
+	transfer(missile.enuVel, snapshot.enuVel);
+	transfer(missile.enuAttitude, snapshot.enuAttitude);
+	transfer(missile.enuToFlu, snapshot.enuToFlu);
+	transfer(missile.fluVel, snapshot.fluVel);
+	transfer(missile.rate, snapshot.rate);
+
+	// Seeker.
+	transfer(missile.skrTht, snapshot.skrTht);
+	transfer(missile.skrPsi, snapshot.skrPsi);
+	transfer(missile.skrThtErr, snapshot.skrThtErr);
+	transfer(missile.skrPsiErr, snapshot.skrPsiErr);
+	transfer(missile.skrWlr, snapshot.skrWlr);
+	transfer(missile.skrWlrDot, snapshot.skrWlrDot);
+	transfer(missile.skrWlr1, snapshot.skrWlr1);
+	transfer(missile.skrWlr1Dot, snapshot.skrWlr1Dot);
+	transfer(missile.skrWlr2, snapshot.skrWlr2);
+	transfer(missile.skrWlr2Dot, snapshot.skrWlr2Dot);
+	transfer(missile.skrWlq, snapshot.skrWlq);
+	transfer(missile.skrWlqDot, snapshot.skrWlqDot);
+	transfer(missile.skrWlq1, snapshot.skrWlq1);
+	transfer(missile.skrWlq1Dot, snapshot.skrWlq1Dot);
+	transfer(missile.skrWlq2, snapshot.skrWlq2);
+	transfer(missile.skrWlq2Dot, snapshot.skrWlq2Dot);
+
+	// Guidance.
+	transfer(missile.isHoming, snapshot.isHoming);
+	transfer(missile.mslToWaypoint, snapshot.mslToWaypoint);
+	transfer(missile.commLimit, snapshot.commLimit);
+
+	// Control.
+	transfer(missile.yawIntErr, snapshot.yawIntErr);
+	transfer(missile.yawPropErr, snapshot.yawPropErr);
+	transfer(missile.pitchIntErr, snapshot.pitchIntErr);
+	transfer(missile.pitchPropErr, snapshot.pitchPropErr);
+	transfer(missile.rollPropErr, snapshot.rollPropErr);
+
+	// Actuators.
+	exchangeActuator(missile.actOne, snapshot.actuators[0], transfer);
+	exchangeActuator(missile.actTwo, snapshot.actuators[1], transfer);
+	exchangeActuator(missile.actThree, snapshot.actuators[2], transfer);
+	exchangeActuator(missile.actFour, snapshot.actuators[3], transfer);
+	transfer(missile.finOneDefl, snapshot.finDefl[0]);
+	transfer(missile.finTwoDefl, snapshot.finDefl[1]);
+	transfer(missile.finThreeDefl, snapshot.finDefl[2]);
+	transfer(missile.finFourDefl, snapshot.finDefl[3]);
+	transfer(missile.rollFinDefl, snapshot.rollFinDefl);
+	transfer(missile.pitchFinDefl, snapshot.pitchFinDefl);
+	transfer(missile.yawFinDefl, snapshot.yawFinDefl);
+
+	// Table look ups.
+	transfer(missile.tableBrackets, snapshot.tableBrackets);
+
+	// Integration.
+	transfer(missile.INTEGRATION_METHOD, snapshot.INTEGRATION_METHOD);
+	transfer(missile.INTEGRATION_PASS, snapshot.INTEGRATION_PASS);
+	transfer(missile.integrationStep, snapshot.integrationStep);
+	transfer(missile.timeStep, snapshot.timeStep);
+	transfer(missile.halfTimeStep, snapshot.halfTimeStep);
+	transfer(missile.sampleTime, snapshot.sampleTime);
+	transfer(missile.relativeTolerance, snapshot.relativeTolerance);
+	transfer(missile.absoluteTolerance, snapshot.absoluteTolerance);
+	transfer(missile.minimumTimeStep, snapshot.minimumTimeStep);
+	transfer(missile.maximumTimeStep, snapshot.maximumTimeStep);
+	transfer(missile.nextTimeStep, snapshot.nextTimeStep);
+	transfer(missile.acceptedSteps, snapshot.acceptedSteps);
+	transfer(missile.rejectedSteps, snapshot.rejectedSteps);
+
+	// Runge kutta stages, in declaration order.
+	decltype(&missile.P0) stages[32] = {
+		&missile.P0, &missile.V0, &missile.E0, &missile.W0,
+		&missile.P1, &missile.V1, &missile.A1, &missile.E1, &missile.ED1, &missile.W1, &missile.WD1,
+		&missile.P2, &missile.V2, &missile.A2, &missile.E2, &missile.ED2, &missile.W2, &missile.WD2,
+		&missile.P3, &missile.V3, &missile.A3, &missile.E3, &missile.ED3, &missile.W3, &missile.WD3,
+		&missile.P4, &missile.V4, &missile.A4, &missile.E4, &missile.ED4, &missile.W4, &missile.WD4
+	};
+	for (int i = 0; i < 32; i++)
+	{
+		transfer(*stages[i], snapshot.stages[i]);
+	}
+
+}
+
+missileSnapshot takeSnapshot(const Missile &missile)
+{
+
+	missileSnapshot snapshot{};
+	exchangeMissile(missile, snapshot, captureField());
+	return snapshot;
+
+}
+
+void restoreSnapshot(Missile &missile, const missileSnapshot &snapshot)
+{
+
+	exchangeMissile(missile, snapshot, restoreField());
+
+}
+
+void writeSnapshot(const missileSnapshot &snapshot, string fileName)
+{
+
+	ofstream outFile(fileName, ios::binary);
+	if (!outFile)
+	{
+		cout << "Unable to open snapshot file " << fileName << endl;
+		exit(1);
+	}
+	int size = sizeof(snapshot);
+	outFile.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+	outFile.write(reinterpret_cast<const char *>(&SNAPSHOT_VERSION), sizeof(SNAPSHOT_VERSION));
+	outFile.write(reinterpret_cast<const char *>(&size), sizeof(size));
+	outFile.write(reinterpret_cast<const char *>(&snapshot), sizeof(snapshot));
+
+}
+
+missileSnapshot readSnapshot(string fileName)
+{
+
+	ifstream inFile(fileName, ios::binary);
+	char magic[8];
+	int version = 0;
+	int size = 0;
+	inFile.read(magic, sizeof(magic));
+	inFile.read(reinterpret_cast<char *>(&version), sizeof(version));
+	inFile.read(reinterpret_cast<char *>(&size), sizeof(size));
+	if (!inFile or memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0 or version != SNAPSHOT_VERSION or size != sizeof(missileSnapshot))
+	{
+		cout << "Snapshot file " << fileName << " is missing or from another build" << endl;
+		exit(1);
+	}
+
+	missileSnapshot snapshot;
+	inFile.read(reinterpret_cast<char *>(&snapshot), sizeof(snapshot));
+	if (!inFile)
+	{
+		cout << "Snapshot file " << fileName << " is truncated" << endl;
+		exit(1);
+	}
+	return snapshot;
+
+}
@@ -0,0 +1,126 @@
+// Standard.
+#include <iostream>
+#include <fstream>
+#include <string>
+
+// Namespace.
+using namespace std;
+
+// Missile model.
+#include "missileModel.h"
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+/* Internal state of one fin actuator. */
+struct actuatorSnapshot
+{
+
+	double time;
+	double timeStep;
+	double deflectionLimit;
+	double deflectionRateLimit;
+	double wn;
+	double zeta;
+	double deflection;
+	double deflectionDerivative;
+	double deflectionDot;
+	double deflectionDotDerivative;
+
+};
+
+/* Everything a flyout carries from one integration step to the next, as plain data.
+Values every step recomputes before reading (atmosphere, aerodynamics, commands) and
+the tables are left out. Restore onto a clone of a missile built from the same tables.
+Written to file byte for byte, so the layout is the file format. */
+struct missileSnapshot
+{
+
+	// Status.
+	missileLethality lethality;
+	bool isBallistic;
+	bool isLaunched;
+	double waypoint[3];
+	double tof;
+	double rng;
+	double missDistance;
+
+	// Airframe.
+	double enuPos[3];
+	double enuVel[3];
+	double enuAttitude[3];
+	double enuToFlu[3][3];
+	double fluVel[3];
+	double rate[3];
+
+	// Seeker.
+	double skrTht;
+	double skrPsi;
+	double skrThtErr;
+	double skrPsiErr;
+	double skrWlr;
+	double skrWlrDot;
+	double skrWlr1;
+	double skrWlr1Dot;
+	double skrWlr2;
+	double skrWlr2Dot;
+	double skrWlq;
+	double skrWlqDot;
+	double skrWlq1;
+	double skrWlq1Dot;
+	double skrWlq2;
+	double skrWlq2Dot;
+
+	// Guidance.
+	bool isHoming;
+	double mslToWaypoint[3];
+	double commLimit;
+
+	// Control.
+	double yawIntErr;
+	double yawPropErr;
+	double pitchIntErr;
+	double pitchPropErr;
+	double rollPropErr;
+
+	// Actuators. Fin deflections are held between flight software samples.
+	actuatorSnapshot actuators[4];
+	double finDefl[4];
+	double rollFinDefl;
+	double pitchFinDefl;
+	double yawFinDefl;
+
+	// Table look ups.
+	tableBracket tableBrackets[NUMBER_OF_TABLES];
+
+	// Integration.
+	int INTEGRATION_METHOD;
+	int INTEGRATION_PASS;
+	int integrationStep;
+	double timeStep;
+	double halfTimeStep;
+	double sampleTime;
+	double relativeTolerance;
+	double absoluteTolerance;
+	double minimumTimeStep;
+	double maximumTimeStep;
+	double nextTimeStep;
+	int acceptedSteps;
+	int rejectedSteps;
+
+	// Runge kutta stages. Zero between steps.
+	double stages[32][3];
+
+};
+
+// Captures the flyout state. Take it between integration steps.
+missileSnapshot takeSnapshot(const Missile &missile);
+
+// Overwrites the flyout state of the missile with the snapshot.
+void restoreSnapshot(Missile &missile, const missileSnapshot &snapshot);
+
+// Snapshot files. A short header guards against reading another build's layout.
+void writeSnapshot(const missileSnapshot &snapshot, string fileName);
+missileSnapshot readSnapshot(string fileName);
+
+#endif
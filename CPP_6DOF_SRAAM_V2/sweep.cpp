@@ -0,0 +1,206 @@
+// Standard.
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+
+// Namespace.
+using namespace std;
+
+// Utility.
+#include "util.h"
+
+// Header.
+#include "sweep.h"
+
+vector<sweepCase> readSweepCases(string caseFile)
+{
+
+	vector<sweepCase> cases;
+	ifstream inFile(caseFile);
+	if (!inFile)
+	{
+		cout << "Unable to open sweep case file " << caseFile << endl;
+		exit(1);
+	}
+
+	string line;
+	while (getline(inFile, line))
+	{
+
+		if (line.find_first_not_of(" \t\r") == string::npos or line[0] == '#')
+		{
+			continue;
+		}
+
+		sweepCase newCase;
+		int consoleReport;
+		istringstream parseLine(line);
+		parseLine
+		>> newCase.ballistic
+		>> newCase.INTEGRATION_METHOD
+		>> newCase.phi
+		>> newCase.theta
+		>> newCase.psi
+		>> newCase.launchPosition[0]
+		>> newCase.launchPosition[1]
+		>> newCase.launchPosition[2]
+		>> newCase.waypoint[0]
+		>> newCase.waypoint[1]
+		>> newCase.waypoint[2]
+		>> newCase.logData
+		>> consoleReport
+		>> newCase.ID;
+
+		if (parseLine.fail())
+		{
+			cout << "Bad sweep case in " << caseFile << ": " << line << endl;
+			exit(1);
+		}
+		readLogSettings(parseLine, newCase.log);
+		cases.push_back(newCase);
+
+	}
+
+	return cases;
+
+}
+
+Missile prepareCase(const Missile &prototype, const sweepCase &flyOut)
+{
+
+	Missile missile = clone(prototype);
+	missile.isBallistic = flyOut.ballistic;
+	missile.INTEGRATION_METHOD = flyOut.INTEGRATION_METHOD;
+
+	double launchPosition[3] = {flyOut.launchPosition[0], flyOut.launchPosition[1], flyOut.launchPosition[2]};
+	emplace(missile, flyOut.phi * degToRad, flyOut.theta * degToRad, flyOut.psi * degToRad, launchPosition);
+	double pip[3] = {flyOut.waypoint[0], flyOut.waypoint[1], flyOut.waypoint[2]};
+	setArrayEquivalentToReference(missile.waypoint, pip);
+	seekerOn(missile);
+	missile.lethality = FLYING;
+	missile.isLaunched = true;
+	return missile;
+
+}
+
+static sweepResult resultOf(Missile &missile, string ID)
+{
+
+	sweepResult result;
+	result.ID = ID;
+	result.lethality = LETHALITY_NAMES[missile.lethality];
+	result.tof = missile.tof;
+	result.missDistance = missile.missDistance;
+	setArrayEquivalentToReference(result.enuPos, missile.enuPos);
+	result.mach = missile.mach;
+	return result;
+
+}
+
+vector<sweepResult> runSweep(const Missile &prototype, const vector<sweepCase> &cases, int threads, double maxTime)
+{
+
+	vector<sweepResult> results(cases.size());
+	if (threads < 1)
+	{
+		threads = 1;
+	}
+	if (threads > static_cast<int>(cases.size()))
+	{
+		threads = cases.size();
+	}
+
+	// Each worker takes the next unflown case until none are left.
+	atomic<size_t> nextCase(0);
+	auto worker = [&]()
+	{
+		size_t index;
+		while ((index = nextCase.fetch_add(1)) < cases.size())
+		{
+			Missile missile = prepareCase(prototype, cases[index]);
+			sixDofFly(missile, cases[index].ID, cases[index].logData, false, maxTime, cases[index].log);
+			results[index] = resultOf(missile, cases[index].ID);
+		}
+	};
+
+	vector<thread> pool;
+	for (int i = 0; i < threads; i++)
+	{
+		pool.emplace_back(worker);
+	}
+	for (auto &t : pool)
+	{
+		t.join();
+	}
+
+	return results;
+
+}
+
+vector<sweepResult> fanOut(const Missile &prototype, const missileSnapshot &snapshot, int runs, const perturbation &perturb, int threads, double maxTime)
+{
+
+	vector<sweepResult> results(runs);
+	if (threads < 1)
+	{
+		threads = 1;
+	}
+	if (threads > runs)
+	{
+		threads = runs;
+	}
+
+	// Each worker takes the next unflown run until none are left.
+	atomic<int> nextRun(0);
+	auto worker = [&]()
+	{
+		int run;
+		while ((run = nextRun.fetch_add(1)) < runs)
+		{
+			Missile missile = clone(prototype);
+			restoreSnapshot(missile, snapshot);
+			perturb(missile, run);
+			sixDofFly(missile, "", false, false, maxTime);
+			results[run] = resultOf(missile, "run" + to_string(run));
+		}
+	};
+
+	vector<thread> pool;
+	for (int i = 0; i < threads; i++)
+	{
+		pool.emplace_back(worker);
+	}
+	for (auto &t : pool)
+	{
+		t.join();
+	}
+
+	return results;
+
+}
+
+void writeSweepResults(const vector<sweepResult> &results, string outputFile)
+{
+
+	ofstream outFile(outputFile);
+	outFile << "ID lethality tof missDistance posE posN posU mach\n";
+	outFile << fixed << setprecision(10);
+	for (auto const &result : results)
+	{
+		outFile
+		<< result.ID << " "
+		<< result.lethality << " "
+		<< result.tof << " "
+		<< result.missDistance << " "
+		<< result.enuPos[0] << " "
+		<< result.enuPos[1] << " "
+		<< result.enuPos[2] << " "
+		<< result.mach << "\n";
+	}
+
+}
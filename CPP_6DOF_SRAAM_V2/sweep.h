@@ -0,0 +1,72 @@
+// Standard.
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <functional>
+
+// Namespace.
+using namespace std;
+
+// Missile model.
+#include "missileModel.h"
+#include "snapshot.h"
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+/* One flyout of a sweep. Same fields as input/input.txt, angles in degrees. */
+struct sweepCase
+{
+
+	int ballistic = 0;
+	int INTEGRATION_METHOD = 2;
+	double phi = 0.0; // Degrees.
+	double theta = 0.0; // Degrees.
+	double psi = 0.0; // Degrees.
+	double launchPosition[3] = {0.0, 0.0, 0.0}; // East, north, up. Meters.
+	double waypoint[3] = {0.0, 0.0, 0.0}; // East, north, up. Meters.
+	int logData = 0; // Write the per case 6DOF log.
+	logSettings log;
+	string ID;
+
+};
+
+/* End state of one flyout. */
+struct sweepResult
+{
+
+	string ID;
+	string lethality;
+	double tof = 0.0; // Seconds.
+	double missDistance = 0.0; // Meters.
+	double enuPos[3] = {0.0, 0.0, 0.0}; // Meters.
+	double mach = 0.0; // Non dimensional.
+
+};
+
+// Reads one case per line in the input/input.txt layout, optional log settings included.
+// Blank lines and lines starting with '#' are skipped.
+vector<sweepCase> readSweepCases(string caseFile);
+
+// Clone of the prototype, emplaced and ready to fly.
+Missile prepareCase(const Missile &prototype, const sweepCase &flyOut);
+
+// Flies every case on a pool of threads. The prototype supplies the tables, which all cases share read only.
+// Results are returned in case order regardless of which thread flew them.
+vector<sweepResult> runSweep(const Missile &prototype, const vector<sweepCase> &cases, int threads, double maxTime);
+
+// Changes one continuation before it flies on. Called with the run number.
+typedef function<void(Missile &missile, int run)> perturbation;
+
+// Flies runs continuations of one snapshot on a pool of threads. Each restores the snapshot
+// onto a clone of the prototype, is perturbed, then flies to termination without a log.
+// Results are returned in run order, with IDs run0, run1, ...
+vector<sweepResult> fanOut(const Missile &prototype, const missileSnapshot &snapshot, int runs, const perturbation &perturb, int threads, double maxTime);
+
+// Writes one row per case.
+void writeSweepResults(const vector<sweepResult> &results, string outputFile);
+
+#endif
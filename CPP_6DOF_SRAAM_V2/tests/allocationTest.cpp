@@ -0,0 +1,89 @@
+// Standard.
+#include <iostream>
+#include <string>
+#include <vector>
+#include <new>
+#include <cstdlib>
+
+// Namespace.
+using namespace std;
+
+// Missile model.
+#include "missileModel.h"
+#include "sweep.h"
+
+// Flies the tests/launch.txt missile with every integration method and fails if the flyout
+// allocates once the missile is launched. Run from the repository root.
+// Usage: allocationTest [integrationMethod]
+
+static size_t allocations = 0;
+static bool counting = false;
+
+void *operator new(size_t size)
+{
+
+	if (counting)
+	{
+		allocations += 1;
+	}
+	void *memory = malloc(size == 0 ? 1 : size);
+	if (!memory)
+	{
+		throw bad_alloc();
+	}
+	return memory;
+
+}
+
+void operator delete(void *memory) noexcept
+{
+
+	free(memory);
+
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+
+	free(memory);
+
+}
+
+int main(int argc, char *argv[])
+{
+
+	vector<int> methods = {0, 1, 2, 3};
+	if (argc > 1)
+	{
+		methods = {stoi(argv[1])};
+	}
+
+	Missile prototype;
+	formatTables(prototype, "CPP_6DOF_SRAAM_V2/input/tables.txt");
+	vector<sweepCase> launch = readSweepCases("CPP_6DOF_SRAAM_V2/tests/launch.txt");
+
+	int failures = 0;
+	for (int method : methods)
+	{
+
+		sweepCase flyOut = launch[0];
+		flyOut.INTEGRATION_METHOD = method;
+		Missile missile = prepareCase(prototype, flyOut);
+		logSettings settings;
+
+		allocations = 0;
+		counting = true;
+		sixDofFly(missile, flyOut.ID, false, false, 400.0, settings);
+		counting = false;
+
+		cout << "INTEGRATION METHOD " << method << " " << LETHALITY_NAMES[missile.lethality] << " AT " << missile.tof << " ALLOCATIONS " << allocations << endl;
+		if (allocations != 0)
+		{
+			failures += 1;
+		}
+
+	}
+
+	return failures == 0 ? 0 : 1;
+
+}
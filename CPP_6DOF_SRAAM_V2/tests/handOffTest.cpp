@@ -0,0 +1,62 @@
+// Standard.
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+
+// Namespace.
+using namespace std;
+
+// Missile model.
+#include "missileModel.h"
+#include "sweep.h"
+
+// Hands the tests/launch.txt missile off to the 6DOF while it already flies as a 6DOF, then
+// checks the flight ends as it would have without the hand off. Run from the repository root.
+// Usage: handOffTest [handOffTime]
+
+const double MISS_DISTANCE_TOLERANCE = 1.0; // Meters.
+const double TIME_OF_FLIGHT_TOLERANCE = 0.05; // Seconds.
+
+int main(int argc, char *argv[])
+{
+
+	vector<double> handOffTimes = {3.0, 6.0, 9.0, 12.0}; // Seconds.
+	if (argc > 1)
+	{
+		handOffTimes = {stod(argv[1])};
+	}
+
+	Missile prototype;
+	formatTables(prototype, "CPP_6DOF_SRAAM_V2/input/tables.txt");
+	vector<sweepCase> launch = readSweepCases("CPP_6DOF_SRAAM_V2/tests/launch.txt");
+
+	Missile reference = prepareCase(prototype, launch[0]);
+	sixDofFly(reference, launch[0].ID, false, false, 400.0);
+	cout << "6DOF " << LETHALITY_NAMES[reference.lethality] << " AT " << reference.tof << " MISS DISTANCE " << reference.missDistance << endl;
+
+	int failures = 0;
+	for (double handOffTime : handOffTimes)
+	{
+
+		Missile missile = prepareCase(prototype, launch[0]);
+		while (missile.lethality == FLYING and missile.tof < handOffTime)
+		{
+			sixDofStep(missile, 400.0);
+		}
+		handOffToSixDof(missile);
+		sixDofFly(missile, launch[0].ID, false, false, 400.0);
+
+		cout << "HAND OFF AT " << handOffTime << " " << LETHALITY_NAMES[missile.lethality] << " AT " << missile.tof << " MISS DISTANCE " << missile.missDistance << endl;
+		if (missile.lethality != reference.lethality or
+			abs(missile.missDistance - reference.missDistance) > MISS_DISTANCE_TOLERANCE or
+			abs(missile.tof - reference.tof) > TIME_OF_FLIGHT_TOLERANCE)
+		{
+			failures += 1;
+		}
+
+	}
+
+	return failures == 0 ? 0 : 1;
+
+}
@@ -0,0 +1,98 @@
+// Standard.
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+
+// Namespace.
+using namespace std;
+
+// Missile model.
+#include "missileModel.h"
+#include "sweep.h"
+
+// Flies the tests/launch.txt missile as a 3DOF to a time to go hand off, then as a 6DOF, and
+// checks the hand off keeps the state, the 6DOF settles on the 3DOF trim without a kick, and
+// the flight ends as a pure 6DOF one does. Run from the repository root.
+// Usage: threeDofHandOffTest [timeToGo]
+
+const double MISS_DISTANCE_TOLERANCE = 1.0; // Meters.
+const double TIME_OF_FLIGHT_TOLERANCE = 0.3; // Seconds. The 3DOF flies a slightly different path to the hand off.
+const double TRANSIENT_WINDOW = 1.0; // Seconds.
+const double ALPHA_PRIME_OVERSHOOT = 1.0; // Degrees above the hand off trim.
+const double RATE_LIMIT = 0.5; // Radians per second.
+
+int main(int argc, char *argv[])
+{
+
+	vector<double> timesToGo = {6.0, 5.0, 4.0, 3.0, 2.0}; // Seconds.
+	if (argc > 1)
+	{
+		timesToGo = {stod(argv[1])};
+	}
+
+	Missile prototype;
+	formatTables(prototype, "CPP_6DOF_SRAAM_V2/input/tables.txt");
+	vector<sweepCase> launch = readSweepCases("CPP_6DOF_SRAAM_V2/tests/launch.txt");
+
+	Missile reference = prepareCase(prototype, launch[0]);
+	sixDofFly(reference, launch[0].ID, false, false, 400.0);
+	cout << "6DOF " << LETHALITY_NAMES[reference.lethality] << " AT " << reference.tof << " MISS DISTANCE " << reference.missDistance << endl;
+
+	int failures = 0;
+	for (double timeToGo : timesToGo)
+	{
+
+		handOffSettings handOff;
+		handOff.trigger = TIME_TO_GO_HAND_OFF;
+		handOff.threshold = timeToGo;
+		Missile missile = prepareCase(prototype, launch[0]);
+		threeDofFly(missile, launch[0].ID, false, false, 400.0, handOff);
+		if (missile.lethality != FLYING)
+		{
+			cout << "TIME TO GO " << timeToGo << " NOT REACHED, " << LETHALITY_NAMES[missile.lethality] << " AT " << missile.tof << endl;
+			failures += 1;
+			continue;
+		}
+
+		double handOffTime = missile.tof;
+		double position[3], velocity[3];
+		setArrayEquivalentToReference(position, missile.enuPos);
+		setArrayEquivalentToReference(velocity, missile.enuVel);
+		handOffToSixDof(missile);
+		bool continuous = missile.tof == handOffTime;
+		for (int i = 0; i < 3; i++)
+		{
+			continuous = continuous and missile.enuPos[i] == position[i] and missile.enuVel[i] == velocity[i];
+		}
+
+		double trimAlphaPrime = missile.alphaPrimeDegrees;
+		double peakAlphaPrime = trimAlphaPrime;
+		double peakRate = 0.0;
+		while (missile.lethality == FLYING and missile.tof < handOffTime + TRANSIENT_WINDOW)
+		{
+			sixDofStep(missile, 400.0);
+			double rate;
+			magnitude(missile.rate, rate);
+			peakAlphaPrime = max(peakAlphaPrime, missile.alphaPrimeDegrees);
+			peakRate = max(peakRate, rate);
+		}
+		sixDofFly(missile, launch[0].ID, false, false, 400.0);
+
+		cout << "HAND OFF AT " << handOffTime << " TRIM ALPHA PRIME " << trimAlphaPrime << " PEAK " << peakAlphaPrime << " PEAK RATE " << peakRate <<
+		" " << LETHALITY_NAMES[missile.lethality] << " AT " << missile.tof << " MISS DISTANCE " << missile.missDistance << endl;
+		if (!continuous or
+			peakAlphaPrime > trimAlphaPrime + ALPHA_PRIME_OVERSHOOT or
+			peakRate > RATE_LIMIT or
+			missile.lethality != reference.lethality or
+			abs(missile.missDistance - reference.missDistance) > MISS_DISTANCE_TOLERANCE or
+			abs(missile.tof - reference.tof) > TIME_OF_FLIGHT_TOLERANCE)
+		{
+			failures += 1;
+		}
+
+	}
+
+	return failures == 0 ? 0 : 1;
+
+}
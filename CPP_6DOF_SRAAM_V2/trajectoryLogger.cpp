@@ -0,0 +1,448 @@
+// Standard.
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+// Namespace.
+using namespace std;
+
+// Missile model.
+#include "missileModel.h"
+
+// Header.
+#include "trajectoryLogger.h"
+
+/* Binary log format. */
+static const char BINARY_LOG_MAGIC[8] = {'S', 'R', 'A', 'A', 'M', 'L', 'O', 'G'};
+static const int BINARY_LOG_VERSION = 1;
+static const int BINARY_LOG_RING_RECORDS = 4096;
+static const int BINARY_LOG_CHUNK_ROWS = 1024;
+
+/* Loggable fields. Names and order match the text log. */
+struct logField
+{
+
+	const char *name;
+	double (*get)(const Missile &m);
+
+};
+
+static const logField LOG_FIELDS[] =
+{
+	{"tgtE", [](const Missile &m) -> double { return m.waypoint[0]; }},
+	{"tgtN", [](const Missile &m) -> double { return m.waypoint[1]; }},
+	{"tgtU", [](const Missile &m) -> double { return m.waypoint[2]; }},
+	{"tof", [](const Missile &m) -> double { return m.tof; }},
+	{"posE", [](const Missile &m) -> double { return m.enuPos[0]; }},
+	{"posN", [](const Missile &m) -> double { return m.enuPos[1]; }},
+	{"posU", [](const Missile &m) -> double { return m.enuPos[2]; }},
+	{"range", [](const Missile &m) -> double { return m.rng; }},
+	{"velE", [](const Missile &m) -> double { return m.enuVel[0]; }},
+	{"velN", [](const Missile &m) -> double { return m.enuVel[1]; }},
+	{"velU", [](const Missile &m) -> double { return m.enuVel[2]; }},
+	{"u", [](const Missile &m) -> double { return m.fluVel[0]; }},
+	{"v", [](const Missile &m) -> double { return m.fluVel[1]; }},
+	{"w", [](const Missile &m) -> double { return m.fluVel[2]; }},
+	{"speed", [](const Missile &m) -> double { return m.spd; }},
+	{"mach", [](const Missile &m) -> double { return m.mach; }},
+	{"accE", [](const Missile &m) -> double { return m.enuAcc[0]; }},
+	{"accN", [](const Missile &m) -> double { return m.enuAcc[1]; }},
+	{"accU", [](const Missile &m) -> double { return m.enuAcc[2]; }},
+	{"udot", [](const Missile &m) -> double { return m.spcfForce[0]; }},
+	{"vdot", [](const Missile &m) -> double { return m.spcfForce[1]; }},
+	{"wdot", [](const Missile &m) -> double { return m.spcfForce[2]; }},
+	{"ENUToFLU_0_0", [](const Missile &m) -> double { return m.enuToFlu[0][0]; }},
+	{"ENUToFLU_0_1", [](const Missile &m) -> double { return m.enuToFlu[0][1]; }},
+	{"ENUToFLU_0_2", [](const Missile &m) -> double { return m.enuToFlu[0][2]; }},
+	{"ENUToFLU_1_0", [](const Missile &m) -> double { return m.enuToFlu[1][0]; }},
+	{"ENUToFLU_1_1", [](const Missile &m) -> double { return m.enuToFlu[1][1]; }},
+	{"ENUToFLU_1_2", [](const Missile &m) -> double { return m.enuToFlu[1][2]; }},
+	{"ENUToFLU_2_0", [](const Missile &m) -> double { return m.enuToFlu[2][0]; }},
+	{"ENUToFLU_2_1", [](const Missile &m) -> double { return m.enuToFlu[2][1]; }},
+	{"ENUToFLU_2_2", [](const Missile &m) -> double { return m.enuToFlu[2][2]; }},
+	{"alphaRadians", [](const Missile &m) -> double { return m.alphaRadians; }},
+	{"betaRadians", [](const Missile &m) -> double { return m.betaRadians; }},
+	{"alphaDegrees", [](const Missile &m) -> double { return m.alphaDegrees; }},
+	{"betaDegrees", [](const Missile &m) -> double { return m.betaDegrees; }},
+	{"phi", [](const Missile &m) -> double { return m.enuAttitude[0]; }},
+	{"theta", [](const Missile &m) -> double { return m.enuAttitude[1]; }},
+	{"psi", [](const Missile &m) -> double { return m.enuAttitude[2]; }},
+	{"phiDot", [](const Missile &m) -> double { return m.enuAttitudeDot[0]; }},
+	{"thetaDot", [](const Missile &m) -> double { return m.enuAttitudeDot[1]; }},
+	{"psiDot", [](const Missile &m) -> double { return m.enuAttitudeDot[2]; }},
+	{"p", [](const Missile &m) -> double { return m.rate[0]; }},
+	{"q", [](const Missile &m) -> double { return m.rate[1]; }},
+	{"r", [](const Missile &m) -> double { return m.rate[2]; }},
+	{"pdot", [](const Missile &m) -> double { return m.rateDot[0]; }},
+	{"qdot", [](const Missile &m) -> double { return m.rateDot[1]; }},
+	{"rdot", [](const Missile &m) -> double { return m.rateDot[2]; }},
+	{"gravity", [](const Missile &m) -> double { return m.grav; }},
+	{"axialGravity", [](const Missile &m) -> double { return m.fluGrav[0]; }},
+	{"sideGravity", [](const Missile &m) -> double { return m.fluGrav[1]; }},
+	{"normalGravity", [](const Missile &m) -> double { return m.fluGrav[2]; }},
+	{"pressure", [](const Missile &m) -> double { return m.p; }},
+	{"dynamicPressure", [](const Missile &m) -> double { return m.q; }},
+	{"seekerPitch", [](const Missile &m) -> double { return m.skrTht; }},
+	{"seekerYaw", [](const Missile &m) -> double { return m.skrPsi; }},
+	{"seekerENUToFLU_0_0", [](const Missile &m) -> double { return m.skrEnuToFlu[0][0]; }},
+	{"seekerENUToFLU_0_1", [](const Missile &m) -> double { return m.skrEnuToFlu[0][1]; }},
+	{"seekerENUToFLU_0_2", [](const Missile &m) -> double { return m.skrEnuToFlu[0][2]; }},
+	{"seekerENUToFLU_1_0", [](const Missile &m) -> double { return m.skrEnuToFlu[1][0]; }},
+	{"seekerENUToFLU_1_1", [](const Missile &m) -> double { return m.skrEnuToFlu[1][1]; }},
+	{"seekerENUToFLU_1_2", [](const Missile &m) -> double { return m.skrEnuToFlu[1][2]; }},
+	{"seekerENUToFLU_2_0", [](const Missile &m) -> double { return m.skrEnuToFlu[2][0]; }},
+	{"seekerENUToFLU_2_1", [](const Missile &m) -> double { return m.skrEnuToFlu[2][1]; }},
+	{"seekerENUToFLU_2_2", [](const Missile &m) -> double { return m.skrEnuToFlu[2][2]; }},
+	{"seekerPitchError", [](const Missile &m) -> double { return m.skrThtErr; }},
+	{"seekerYawError", [](const Missile &m) -> double { return m.skrPsiErr; }},
+	{"seekerWLR", [](const Missile &m) -> double { return m.skrWlr; }},
+	{"seekerWLRD", [](const Missile &m) -> double { return m.skrWlrDot; }},
+	{"seekerWLR1", [](const Missile &m) -> double { return m.skrWlr1; }},
+	{"seekerWLR1D", [](const Missile &m) -> double { return m.skrWlr1Dot; }},
+	{"seekerWLR2", [](const Missile &m) -> double { return m.skrWlr2; }},
+	{"seekerWLR2D", [](const Missile &m) -> double { return m.skrWlr2Dot; }},
+	{"seekerWLQ", [](const Missile &m) -> double { return m.skrWlq; }},
+	{"seekerWLQD", [](const Missile &m) -> double { return m.skrWlqDot; }},
+	{"seekerWLQ1", [](const Missile &m) -> double { return m.skrWlq1; }},
+	{"seekerWLQ1D", [](const Missile &m) -> double { return m.skrWlq1Dot; }},
+	{"seekerWLQ2", [](const Missile &m) -> double { return m.skrWlq2; }},
+	{"seekerWLQ2D", [](const Missile &m) -> double { return m.skrWlq2Dot; }},
+	{"homing", [](const Missile &m) -> double { return m.isHoming; }},
+	{"timeToGo", [](const Missile &m) -> double { return m.timeToGo; }},
+	{"missileToInterceptRelativePositionForward", [](const Missile &m) -> double { return m.mslToWaypoint[0]; }},
+	{"missileToInterceptRelativePositionLeft", [](const Missile &m) -> double { return m.mslToWaypoint[1]; }},
+	{"missileToInterceptRelativePositionUp", [](const Missile &m) -> double { return m.mslToWaypoint[2]; }},
+	{"guidanceNormalCommand", [](const Missile &m) -> double { return m.normComm; }},
+	{"guidanceSideCommand", [](const Missile &m) -> double { return m.sideComm; }},
+	{"accelerationLimit", [](const Missile &m) -> double { return m.commLimit; }},
+	{"lastRollRateError", [](const Missile &m) -> double { return m.lastRollPropErr; }},
+	{"rollRateError", [](const Missile &m) -> double { return m.rollPropErr; }},
+	{"rollFinCommand", [](const Missile &m) -> double { return m.rollFinComm; }},
+	{"lastPitchRateError", [](const Missile &m) -> double { return m.lastPitchPropErr; }},
+	{"pitchRateError", [](const Missile &m) -> double { return m.pitchPropErr; }},
+	{"pitchFinCommand", [](const Missile &m) -> double { return m.pitchFinComm; }},
+	{"lastYawRateError", [](const Missile &m) -> double { return m.lastYawPropErr; }},
+	{"yawRateError", [](const Missile &m) -> double { return m.yawPropErr; }},
+	{"yawFinCommand", [](const Missile &m) -> double { return m.yawFinComm; }},
+	{"rollFinDeflection", [](const Missile &m) -> double { return m.rollFinDefl; }},
+	{"pitchFinDeflection", [](const Missile &m) -> double { return m.pitchFinDefl; }},
+	{"yawFinDeflection", [](const Missile &m) -> double { return m.yawFinDefl; }},
+	{"finOneDeflection", [](const Missile &m) -> double { return m.finOneDefl; }},
+	{"finTwoDeflection", [](const Missile &m) -> double { return m.finTwoDefl; }},
+	{"finThreeDeflection", [](const Missile &m) -> double { return m.finThreeDefl; }},
+	{"finFourDeflection", [](const Missile &m) -> double { return m.finFourDefl; }},
+	{"alphaPrimeRadians", [](const Missile &m) -> double { return m.alphaPrimeRadians; }},
+	{"alphaPrimeDegrees", [](const Missile &m) -> double { return m.alphaPrimeDegrees; }},
+	{"sinPhiPrime", [](const Missile &m) -> double { return m.sinPhiPrime; }},
+	{"cosPhiPrime", [](const Missile &m) -> double { return m.cosPhiPrime; }},
+	{"rollFinDeflectionDegrees", [](const Missile &m) -> double { return m.rollFinDeflectionDegrees; }},
+	{"pitchFinDeflectionDegreesAeroBallisticFrame", [](const Missile &m) -> double { return m.pitchAeroBallisticFinDeflectionDegrees; }},
+	{"yawFinDeflectionDegreesAeroBallisticFrame", [](const Missile &m) -> double { return m.yawAeroBallisticFinDeflectionDegrees; }},
+	{"totalFinDeflectionDegrees", [](const Missile &m) -> double { return m.totalFinDeflectionDegrees; }},
+	{"pitchRateDegreesAeroBallisticFrame", [](const Missile &m) -> double { return m.pitchAeroBallisticBodyRateDegrees; }},
+	{"yawRateDegreesAeroBallisticFrame", [](const Missile &m) -> double { return m.yawAeroBallisticBodyRateDegrees; }},
+	{"rollRateDegrees", [](const Missile &m) -> double { return m.rollRateDegrees; }},
+	{"sinOfFourTimesPhiPrime", [](const Missile &m) -> double { return m.sinOfFourTimesPhiPrime; }},
+	{"squaredSinOfTwoTimesPhiPrime", [](const Missile &m) -> double { return m.squaredSinOfTwoTimesPhiPrime; }},
+	{"CA0", [](const Missile &m) -> double { return m.CA0; }},
+	{"CAA", [](const Missile &m) -> double { return m.CAA; }},
+	{"CAD", [](const Missile &m) -> double { return m.CAD; }},
+	{"CAOFF", [](const Missile &m) -> double { return m.CA_POWER_CORRECTION; }},
+	{"CYP", [](const Missile &m) -> double { return m.CYP; }},
+	{"CYDR", [](const Missile &m) -> double { return m.CYDR; }},
+	{"CN0", [](const Missile &m) -> double { return m.CN0; }},
+	{"CNP", [](const Missile &m) -> double { return m.CNP; }},
+	{"CNDQ", [](const Missile &m) -> double { return m.CNDQ; }},
+	{"CLLAP", [](const Missile &m) -> double { return m.CLLAP; }},
+	{"CLLP", [](const Missile &m) -> double { return m.CLLP; }},
+	{"CLLDP", [](const Missile &m) -> double { return m.CLLDP; }},
+	{"CLM0", [](const Missile &m) -> double { return m.CLM0; }},
+	{"CLMP", [](const Missile &m) -> double { return m.CLMP; }},
+	{"CLMQ", [](const Missile &m) -> double { return m.CLMQ; }},
+	{"CLMDQ", [](const Missile &m) -> double { return m.CLMDQ; }},
+	{"CLNP", [](const Missile &m) -> double { return m.CLNP; }},
+	{"mass", [](const Missile &m) -> double { return m.mass; }},
+	{"unadjustedThrust", [](const Missile &m) -> double { return m.unadjustedThrust; }},
+	{"transverseMomentOfInertia", [](const Missile &m) -> double { return m.transverseMomentOfInertia; }},
+	{"axialMomentOfInertia", [](const Missile &m) -> double { return m.axialMomentOfInertia; }},
+	{"centerOfGravityFromNose", [](const Missile &m) -> double { return m.centerOfGravityFromNose; }},
+	{"thrust", [](const Missile &m) -> double { return m.thrust; }},
+	{"CX", [](const Missile &m) -> double { return m.CX; }},
+	{"CY", [](const Missile &m) -> double { return m.CY; }},
+	{"CZ", [](const Missile &m) -> double { return m.CZ; }},
+	{"CL", [](const Missile &m) -> double { return m.CL; }},
+	{"CM", [](const Missile &m) -> double { return m.CM; }},
+	{"CN", [](const Missile &m) -> double { return m.CN; }},
+	{"CNA", [](const Missile &m) -> double { return m.CNA; }},
+	{"CMA", [](const Missile &m) -> double { return m.CMA; }},
+	{"CND", [](const Missile &m) -> double { return m.CND; }},
+	{"CMD", [](const Missile &m) -> double { return m.CMD; }},
+	{"CMQ", [](const Missile &m) -> double { return m.CMQ; }},
+	{"CLP", [](const Missile &m) -> double { return m.CLP; }},
+	{"CLD", [](const Missile &m) -> double { return m.CLD; }},
+	{"staticMargin", [](const Missile &m) -> double { return m.staticMargin; }},
+	{"missDistance", [](const Missile &m) -> double { return m.missDistance; }},
+	{"lethality", [](const Missile &m) -> double { return m.lethality; }},
+	{"launch", [](const Missile &m) -> double { return m.isLaunched; }},
+};
+static const int NUMBER_OF_LOG_FIELDS = sizeof(LOG_FIELDS) / sizeof(LOG_FIELDS[0]);
+
+static void writeInt(ofstream &file, int value)
+{
+
+	int32_t out = value;
+	file.write(reinterpret_cast<const char*>(&out), sizeof(out));
+
+}
+
+static void writeName(ofstream &file, const string &name)
+{
+
+	writeInt(file, name.size());
+	file.write(name.data(), name.size());
+
+}
+
+textLogger::textLogger(string fileName, int decimation)
+{
+
+	logFile.open(fileName);
+	writeLogFileHeader(logFile);
+	this->decimation = decimation;
+	calls = 0;
+
+}
+
+void textLogger::log(Missile &missile)
+{
+
+	// The terminal record is always logged.
+	if (calls % decimation == 0 or missile.lethality != FLYING)
+	{
+		logData(missile, logFile);
+	}
+	calls += 1;
+
+}
+
+binaryLogger::binaryLogger(string fileName, int decimation, const vector<string> &fields)
+{
+
+	this->decimation = decimation;
+	calls = 0;
+
+	// Field subset.
+	if (fields.empty())
+	{
+		for (int i = 0; i < NUMBER_OF_LOG_FIELDS; i++)
+		{
+			fieldIndices.push_back(i);
+		}
+	}
+	else
+	{
+		for (auto const &name : fields)
+		{
+			int index = -1;
+			for (int i = 0; i < NUMBER_OF_LOG_FIELDS; i++)
+			{
+				if (name == LOG_FIELDS[i].name)
+				{
+					index = i;
+					break;
+				}
+			}
+			if (index < 0)
+			{
+				cout << "Unknown log field " << name << endl;
+				exit(1);
+			}
+			fieldIndices.push_back(index);
+		}
+	}
+
+	// Header.
+	logFile.open(fileName, ios::binary);
+	logFile.write(BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC));
+	writeInt(logFile, BINARY_LOG_VERSION);
+	writeInt(logFile, fieldIndices.size());
+	for (int index : fieldIndices)
+	{
+		writeName(logFile, LOG_FIELDS[index].name);
+	}
+	writeInt(logFile, NUMBER_OF_LETHALITIES);
+	for (int i = 0; i < NUMBER_OF_LETHALITIES; i++)
+	{
+		writeName(logFile, LETHALITY_NAMES[i]);
+	}
+
+	capacity = BINARY_LOG_RING_RECORDS;
+	ring.resize(capacity * fieldIndices.size());
+	head = 0;
+	tail = 0;
+	closing = false;
+
+	chunkRows = BINARY_LOG_CHUNK_ROWS;
+	rowsInChunk = 0;
+	chunk.resize(chunkRows * fieldIndices.size());
+
+	writer = thread(&binaryLogger::write, this);
+
+}
+
+binaryLogger::~binaryLogger()
+{
+
+	closing = true;
+	writer.join();
+	logFile.close();
+
+}
+
+void binaryLogger::log(Missile &missile)
+{
+
+	// The terminal record is always logged.
+	if (calls % decimation == 0 or missile.lethality != FLYING)
+	{
+
+		// Wait for the writer if the ring is full. Records are never dropped.
+		size_t record = head.load(memory_order_relaxed);
+		while (record - tail.load(memory_order_acquire) >= static_cast<size_t>(capacity))
+		{
+			this_thread::yield();
+		}
+
+		double *slot = &ring[(record & (capacity - 1)) * fieldIndices.size()];
+		for (size_t j = 0; j < fieldIndices.size(); j++)
+		{
+			slot[j] = LOG_FIELDS[fieldIndices[j]].get(missile);
+		}
+		head.store(record + 1, memory_order_release);
+
+	}
+	calls += 1;
+
+}
+
+void binaryLogger::write()
+{
+
+	int fields = fieldIndices.size();
+	while (true)
+	{
+
+		// Read closing before head, so every record pushed before closing is seen.
+		bool done = closing.load(memory_order_acquire);
+		size_t record = tail.load(memory_order_relaxed);
+		size_t end = head.load(memory_order_acquire);
+
+		if (record == end)
+		{
+			if (done)
+			{
+				break;
+			}
+			this_thread::sleep_for(chrono::microseconds(200));
+			continue;
+		}
+
+		for (; record < end; record++)
+		{
+			const double *slot = &ring[(record & (capacity - 1)) * fields];
+			for (int j = 0; j < fields; j++)
+			{
+				chunk[j * chunkRows + rowsInChunk] = slot[j];
+			}
+			rowsInChunk += 1;
+			if (rowsInChunk == chunkRows)
+			{
+				writeChunk();
+			}
+			tail.store(record + 1, memory_order_release);
+		}
+
+	}
+
+	writeChunk();
+
+}
+
+void binaryLogger::writeChunk()
+{
+
+	if (rowsInChunk == 0)
+	{
+		return;
+	}
+
+	writeInt(logFile, rowsInChunk);
+	for (size_t j = 0; j < fieldIndices.size(); j++)
+	{
+		logFile.write(reinterpret_cast<const char*>(&chunk[j * chunkRows]), rowsInChunk * sizeof(double));
+	}
+	rowsInChunk = 0;
+
+}
+
+shared_ptr<trajectoryLogger> makeTrajectoryLogger(string flyOutID, const logSettings &settings)
+{
+
+	int decimation = (settings.decimation < 1) ? 1 : settings.decimation;
+	if (settings.format == BINARY_LOG)
+	{
+		return make_shared<binaryLogger>("CPP_6DOF_SRAAM_V2/output/" + flyOutID + "_6DOF.bin", decimation, settings.fields);
+	}
+	return make_shared<textLogger>("CPP_6DOF_SRAAM_V2/output/" + flyOutID + "_6DOF.txt", decimation);
+
+}
+
+void readLogSettings(istream &input, logSettings &settings)
+{
+
+	string format;
+	if (!(input >> format))
+	{
+		return;
+	}
+	if (format == "BINARY")
+	{
+		settings.format = BINARY_LOG;
+	}
+	else if (format == "TEXT")
+	{
+		settings.format = TEXT_LOG;
+	}
+	else
+	{
+		cout << "Unknown log format " << format << endl;
+		exit(1);
+	}
+
+	int decimation;
+	if (!(input >> decimation))
+	{
+		return;
+	}
+	settings.decimation = decimation;
+
+	string fields;
+	if (!(input >> fields) or fields == "ALL")
+	{
+		return;
+	}
+	settings.fields.clear();
+	istringstream parseFields(fields);
+	string field;
+	while (getline(parseFields, field, ','))
+	{
+		settings.fields.push_back(field);
+	}
+
+}
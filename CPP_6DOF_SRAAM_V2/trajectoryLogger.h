@@ -0,0 +1,115 @@
+// Standard.
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+
+// Namespace.
+using namespace std;
+
+#ifndef TRAJECTORYLOGGER_H
+#define TRAJECTORYLOGGER_H
+
+struct Missile;
+
+/* Log file formats. */
+enum logFormat
+{
+	TEXT_LOG, // Space separated text, every field. <ID>_6DOF.txt
+	BINARY_LOG // Binary columnar, selected fields. <ID>_6DOF.bin
+};
+
+/* How a flyout is logged. */
+struct logSettings
+{
+
+	logFormat format = TEXT_LOG;
+	int decimation = 1; // Log every nth integration step and the last.
+	vector<string> fields; // Binary log fields. Empty logs every field.
+
+};
+
+/* Writes one record per logged integration step. */
+class trajectoryLogger
+{
+
+	public:
+
+	virtual ~trajectoryLogger() {}
+	virtual void log(Missile &missile) = 0;
+
+};
+
+/* The original text log. */
+class textLogger : public trajectoryLogger
+{
+
+	public:
+
+	textLogger(string fileName, int decimation);
+	void log(Missile &missile);
+
+	ofstream logFile;
+	int decimation;
+	int calls;
+
+};
+
+/* Binary columnar log, written by a background thread.
+
+Layout, native byte order:
+	char[8]  "SRAAMLOG"
+	int32    version
+	int32    number of fields, then per field: int32 name length, name
+	int32    number of lethality names, then per name: int32 name length, name
+	chunks until the end of the file:
+		int32    number of rows
+		float64  one column per field, rows values each
+
+The lethality field holds an index into the lethality names.
+visuals/binaryLog.py reads this format. */
+class binaryLogger : public trajectoryLogger
+{
+
+	public:
+
+	binaryLogger(string fileName, int decimation, const vector<string> &fields);
+	~binaryLogger();
+	void log(Missile &missile);
+
+	// Writer thread.
+	void write();
+	void writeChunk();
+
+	ofstream logFile;
+	int decimation;
+	int calls;
+	vector<int> fieldIndices; // Into the field table.
+
+	// Single producer, single consumer ring of records. The simulation pushes, the writer pops.
+	int capacity; // Records. Power of two.
+	vector<double> ring; // capacity * fields.
+	atomic<size_t> head; // Next record to push. Written by the simulation only.
+	atomic<size_t> tail; // Next record to pop. Written by the writer only.
+	atomic<bool> closing;
+
+	// Writer side columns of the chunk being filled.
+	vector<double> chunk; // fields * chunkRows, column major.
+	int chunkRows;
+	int rowsInChunk;
+
+	thread writer;
+
+};
+
+// Opens the log of a flyout in the output directory.
+shared_ptr<trajectoryLogger> makeTrajectoryLogger(string flyOutID, const logSettings &settings);
+
+// Reads optional log settings from the rest of an input line: TEXT|BINARY [decimation] [field,field,...|ALL].
+// Leaves the settings untouched if nothing follows.
+void readLogSettings(istream &input, logSettings &settings);
+
+#endif
@@ -0,0 +1,50 @@
+import struct
+import numpy as np
+import pandas as pd
+
+# Reads a binary columnar log written by binaryLogger into a data frame
+# with the same column names as the text log.
+def readBinaryLog(path):
+	with open(path, "rb") as f:
+		data = f.read()
+
+	if data[:8] != b"SRAAMLOG":
+		raise ValueError(f"{path} is not a binary log")
+	offset = 8
+
+	def readInt():
+		nonlocal offset
+		value = struct.unpack_from("<i", data, offset)[0]
+		offset += 4
+		return value
+
+	def readName():
+		nonlocal offset
+		length = readInt()
+		name = data[offset:offset + length].decode()
+		offset += length
+		return name
+
+	version = readInt()
+	if version != 1:
+		raise ValueError(f"{path} has unknown version {version}")
+	fields = [readName() for _ in range(readInt())]
+	lethalityNames = [readName() for _ in range(readInt())]
+
+	columns = [[] for _ in fields]
+	while offset < len(data):
+		rows = readInt()
+		for column in columns:
+			column.append(np.frombuffer(data, dtype="<f8", count=rows, offset=offset))
+			offset += rows * 8
+
+	df = pd.DataFrame({
+		field: np.concatenate(column) if column else np.array([])
+		for field, column in zip(fields, columns)
+	})
+	if "lethality" in df:
+		df["lethality"] = [
+			lethalityNames[int(code)] if code >= 0 else "UNKNOWN"
+			for code in df["lethality"]
+		]
+	return df
@@ -3,6 +3,7 @@ import numpy as np
 import matplotlib.pyplot as plt
 import os
 from matPlotLibColors import matPlotLibColors
+from binaryLog import readBinaryLog
 import matplotlib
 matplotlib.use('WebAgg')
 
@@ -11,7 +12,12 @@ dfs = []
 
 for f in os.listdir(directory):
 	path = f"{directory}/{f}"
-	df = pd.read_csv(open(r"{}".format(path)), delimiter= " ")
+	if f.endswith(".bin"):
+		df = readBinaryLog(path)
+	elif "DOF" in f:
+		df = pd.read_csv(open(r"{}".format(path)), delimiter= " ")
+	else:
+		continue
 	df.name = f
 	dfs.append(df)
 